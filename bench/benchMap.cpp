@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Micro benchmarks of tvg::Map with std::unordered_map as a reference.
+ * The keys imitate the glyph cache of a CJK document: thousands of distinct codepoints.
+ *
+ * Usage: tvgBenchMap [number of keys] [rounds]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <unordered_map>
+#include "tvgMap.h"
+
+using Clock = std::chrono::steady_clock;
+
+static volatile uint64_t sink;   //keep the results alive
+
+struct Payload
+{
+    float advance;
+    uint32_t idx;
+    uint8_t pad[48];   //imitates a glyph path
+};
+
+static double _elapsed(Clock::time_point begin, uint32_t ops)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - begin).count() / ops;
+}
+
+static void _report(const char* name, double insert, double hit, double miss, double iterate)
+{
+    printf("%-20s insert %7.2f  find(hit) %7.2f  find(miss) %7.2f  iterate %7.2f  (ns/op)\n", name, insert, hit, miss, iterate);
+}
+
+static void _benchMap(const uint32_t* keys, uint32_t cnt, uint32_t rounds)
+{
+    double insert = 0.0, hit = 0.0, miss = 0.0, iterate = 0.0;
+
+    for (uint32_t r = 0; r < rounds; ++r) {
+        tvg::Map<uint32_t, Payload> map;
+
+        auto t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) map[keys[i]].idx = i;
+        insert += _elapsed(t, cnt);
+
+        uint64_t sum = 0;
+        t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) sum += map.find(keys[cnt - i - 1])->val.idx;
+        hit += _elapsed(t, cnt);
+
+        t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) sum += map.find(keys[i] + 1) ? 1 : 0;
+        miss += _elapsed(t, cnt);
+
+        t = Clock::now();
+        MAP_FOREACH(map, item) sum += item->val.idx;
+        iterate += _elapsed(t, cnt);
+
+        sink = sum;
+    }
+    _report("tvg::Map", insert / rounds, hit / rounds, miss / rounds, iterate / rounds);
+}
+
+static void _benchStd(const uint32_t* keys, uint32_t cnt, uint32_t rounds)
+{
+    double insert = 0.0, hit = 0.0, miss = 0.0, iterate = 0.0;
+
+    for (uint32_t r = 0; r < rounds; ++r) {
+        std::unordered_map<uint32_t, Payload> map;
+
+        auto t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) map[keys[i]].idx = i;
+        insert += _elapsed(t, cnt);
+
+        uint64_t sum = 0;
+        t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) sum += map.find(keys[cnt - i - 1])->second.idx;
+        hit += _elapsed(t, cnt);
+
+        t = Clock::now();
+        for (uint32_t i = 0; i < cnt; ++i) sum += (map.find(keys[i] + 1) != map.end()) ? 1 : 0;
+        miss += _elapsed(t, cnt);
+
+        t = Clock::now();
+        for (auto& item : map) sum += item.second.idx;
+        iterate += _elapsed(t, cnt);
+
+        sink = sum;
+    }
+    _report("std::unordered_map", insert / rounds, hit / rounds, miss / rounds, iterate / rounds);
+}
+
+int main(int argc, char **argv)
+{
+    auto cnt = (argc > 1) ? (uint32_t) atoi(argv[1]) : 5000;
+    auto rounds = (argc > 2) ? (uint32_t) atoi(argv[2]) : 100;
+    if (cnt == 0 || rounds == 0) return 1;
+
+    //distinct even codepoints from the CJK unified ideographs onward, so that the odd keys miss
+    auto keys = tvg::malloc<uint32_t>(sizeof(uint32_t) * cnt);
+    for (uint32_t i = 0; i < cnt; ++i) keys[i] = 0x4e00 + i * 2;
+
+    //shuffle the insertion order
+    uint32_t seed = 7;
+    for (uint32_t i = cnt - 1; i > 0; --i) {
+        seed = seed * 1103515245 + 12345;
+        std::swap(keys[i], keys[seed % (i + 1)]);
+    }
+
+    printf("keys: %u, rounds: %u\n", cnt, rounds);
+    _benchMap(keys, cnt, rounds);
+    _benchStd(keys, cnt, rounds);
+
+    tvg::free(keys);
+
+    return 0;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Micro benchmark of the built-in png decoder (inflate + unfiltering + color conversion).
+ * The checksum of the decoded pixels is printed to verify the decoder output stays the same.
+ *
+ * Usage: tvgBenchPng [rounds] [png path...]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include "tvgCommon.h"
+#include "tvgLodePng.h"
+
+using Clock = std::chrono::steady_clock;
+
+static unsigned char* _read(const char* path, size_t& size)
+{
+    auto f = fopen(path, "rb");
+    if (!f) return nullptr;
+    fseek(f, 0, SEEK_END);
+    size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    auto data = (unsigned char*)malloc(size);
+    size = fread(data, 1, size, f);
+    fclose(f);
+    return data;
+}
+
+
+static bool _bench(const char* path, int rounds)
+{
+    size_t size;
+    auto data = _read(path, size);
+    if (!data) {
+        printf("failed to read the file: %s\n", path);
+        return false;
+    }
+
+    unsigned w = 0, h = 0;
+    uint32_t checksum = 2166136261u;
+    double elapsed = 0;
+
+    for (auto i = 0; i < rounds; ++i) {
+        LodePNGState state;
+        lodepng_state_init(&state);
+        state.info_raw.colortype = LCT_RGBA;
+        unsigned char* out = nullptr;
+
+        auto begin = Clock::now();
+        auto error = lodepng_decode(&out, &w, &h, &state, data, size);
+        elapsed += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+        if (error) {
+            printf("failed to decode the file: %s (error %u)\n", path, error);
+            lodepng_state_cleanup(&state);
+            free(data);
+            return false;
+        }
+        if (i == 0) {
+            for (size_t j = 0; j < size_t(w) * h * 4; ++j) checksum = (checksum ^ out[j]) * 16777619u;
+        }
+        tvg::free(out);
+        lodepng_state_cleanup(&state);
+    }
+
+    printf("%s: %ux%u, decode: %.3f ms, checksum: %08x\n", path, w, h, elapsed / rounds, checksum);
+    free(data);
+    return true;
+}
+
+
+int main(int argc, char **argv)
+{
+    auto rounds = (argc > 1) ? atoi(argv[1]) : 50;
+    if (rounds <= 0) return 1;
+
+    if (argc <= 2) return _bench(TEST_DIR"/test.png", rounds) ? 0 : 1;
+
+    for (auto i = 2; i < argc; ++i) {
+        if (!_bench(argv[i], rounds)) return 1;
+    }
+    return 0;
+}
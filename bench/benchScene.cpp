@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Micro benchmark of the scene traversals with a large number of children.
+ * Each child is a tiny rect, so the cost is dominated by walking the scene rather than rasterizing.
+ *
+ * Usage: tvgBenchScene [number of shapes] [rounds]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thorvg.h>
+
+using namespace tvg;
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t WIDTH = 1024;
+static constexpr uint32_t HEIGHT = 1024;
+
+static double _elapsed(Clock::time_point begin, uint32_t rounds)
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - begin).count() / rounds;
+}
+
+int main(int argc, char **argv)
+{
+    auto cnt = (argc > 1) ? atoi(argv[1]) : 100000;
+    auto rounds = (argc > 2) ? atoi(argv[2]) : 20;
+    if (cnt <= 0 || rounds <= 0) return 1;
+
+    if (Initializer::init(0) != Result::Success) return 1;
+
+    auto buffer = (uint32_t*) malloc(sizeof(uint32_t) * WIDTH * HEIGHT);
+    auto canvas = SwCanvas::gen();
+    canvas->target(buffer, WIDTH, WIDTH, HEIGHT, ColorSpace::ARGB8888);
+
+    auto scene = Scene::gen();
+
+    //3x3 rects on a 4px grid, which leaves 1px gaps in between
+    auto begin = Clock::now();
+    for (auto i = 0; i < cnt; ++i) {
+        auto shape = Shape::gen();
+        shape->appendRect(float((i % (WIDTH / 4)) * 4), float((i / (WIDTH / 4)) % (HEIGHT / 4) * 4), 3, 3);
+        shape->fill(i % 256, 128, 255 - i % 256);
+        scene->add(shape);
+    }
+    auto add = _elapsed(begin, 1);
+
+    canvas->add(scene);
+    canvas->draw();
+    canvas->sync();
+
+    //update() walks the children with the transform changes
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) {
+        scene->translate(float(i % 2), 0.0f);
+        canvas->update();
+        canvas->sync();
+    }
+    auto update = _elapsed(begin, rounds);
+
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) {
+        scene->translate(float(i % 2), 0.0f);
+        canvas->update();
+        canvas->draw(true);
+        canvas->sync();
+    }
+    auto draw = _elapsed(begin, rounds);
+
+    float x, y, w, h;
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) scene->bounds(&x, &y, &w, &h);
+    auto bounds = _elapsed(begin, rounds);
+
+    //a gap inside the scene, so every child is tested
+    auto hits = 0;
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) hits += scene->intersects(11, 11) ? 1 : 0;
+    auto intersects = _elapsed(begin, rounds);
+
+    uint32_t sum = 0;
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) {
+        Paint* const* paints;
+        auto n = scene->paints(&paints);
+        for (uint32_t j = 0; j < n; ++j) sum += paints[j]->opacity();
+    }
+    auto array = _elapsed(begin, rounds);
+
+    begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) {
+        for (auto paint : scene->paints()) sum += paint->opacity();
+    }
+    auto list = _elapsed(begin, rounds);
+
+    printf("shapes: %d, rounds: %d (%d %u)\n", cnt, rounds, hits, sum);
+    printf("add %.2f  update %.2f  draw %.2f  bounds %.2f  intersects %.2f  paints(array) %.2f  paints(list) %.2f  (ms)\n", add, update, draw, bounds, intersects, array, list);
+
+    delete(canvas);
+    free(buffer);
+    Initializer::term();
+
+    return 0;
+}
@@ -0,0 +1,457 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Benchmark suite of the rendering and loading scenarios on the software engine, headless.
+ * Every scenario is run with the given numbers of threads (the main thread included)
+ * and reports the time of a round (update, draw and sync) in percentiles.
+ * The contents are generated with a fixed seed, so the runs are reproducible.
+ *
+ * Usage: tvgBenchSuite [-r rounds] [-t threads,...] [-j output.json] [scenario...]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <thorvg.h>
+
+using namespace tvg;
+using namespace std;
+using Clock = std::chrono::steady_clock;
+
+static constexpr uint32_t WIDTH = 800;
+static constexpr uint32_t HEIGHT = 800;
+
+static uint32_t seed;
+
+static float _random(float min, float max)
+{
+    seed = seed * 1103515245 + 12345;
+    return min + (max - min) * float((seed >> 8) & 0xffff) / 65535.0f;
+}
+
+static uint8_t _channel()
+{
+    return uint8_t(_random(0.0f, 255.0f));
+}
+
+//moves the content by a half pixel so that every round is rasterized again
+static void _jitter(Scene* scene, uint32_t round)
+{
+    scene->translate(float(round % 2) * 0.5f, 0.0f);
+}
+
+
+/************************************************************************/
+/* Scenarios                                                            */
+/************************************************************************/
+
+static bool _solidShapes(Scene* scene)
+{
+    for (auto i = 0; i < 2000; ++i) {
+        auto shape = Shape::gen();
+        auto x = _random(0.0f, WIDTH), y = _random(0.0f, HEIGHT);
+        if (i % 2) shape->appendRect(x, y, _random(4.0f, 80.0f), _random(4.0f, 80.0f), 4.0f, 4.0f);
+        else shape->appendCircle(x, y, _random(2.0f, 40.0f), _random(2.0f, 40.0f));
+        shape->fill(_channel(), _channel(), _channel(), _channel());
+        scene->add(shape);
+    }
+    return true;
+}
+
+
+static bool _gradients(Scene* scene)
+{
+    Fill::ColorStop stops[3] = {{0.0f, 255, 0, 0, 255}, {0.5f, 0, 255, 0, 160}, {1.0f, 0, 0, 255, 255}};
+
+    for (auto i = 0; i < 400; ++i) {
+        auto shape = Shape::gen();
+        auto x = _random(0.0f, WIDTH), y = _random(0.0f, HEIGHT), r = _random(10.0f, 80.0f);
+        shape->appendCircle(x, y, r, r);
+        if (i % 2) {
+            auto fill = LinearGradient::gen();
+            fill->linear(x - r, y - r, x + r, y + r);
+            fill->colorStops(stops, 3);
+            shape->fill(fill);
+        } else {
+            auto fill = RadialGradient::gen();
+            fill->radial(x, y, r, x, y, 0.0f);
+            fill->colorStops(stops, 3);
+            shape->fill(fill);
+        }
+        scene->add(shape);
+    }
+    return true;
+}
+
+
+static bool _dashedStrokes(Scene* scene)
+{
+    float dash[] = {10.0f, 5.0f, 2.0f, 5.0f};
+
+    for (auto i = 0; i < 100; ++i) {
+        auto shape = Shape::gen();
+        shape->moveTo(_random(0.0f, WIDTH), _random(0.0f, HEIGHT));
+        for (auto j = 0; j < 4; ++j) {
+            shape->cubicTo(_random(0.0f, WIDTH), _random(0.0f, HEIGHT), _random(0.0f, WIDTH), _random(0.0f, HEIGHT), _random(0.0f, WIDTH), _random(0.0f, HEIGHT));
+        }
+        shape->strokeWidth(_random(1.0f, 6.0f));
+        shape->strokeFill(_channel(), _channel(), _channel());
+        shape->strokeDash(dash, 4);
+        shape->strokeJoin(StrokeJoin::Round);
+        scene->add(shape);
+    }
+    return true;
+}
+
+
+static bool _nestedMasks(Scene* scene)
+{
+    for (auto i = 0; i < 16; ++i) {
+        auto cx = float(i % 4) * 200.0f + 100.0f, cy = float(i / 4) * 200.0f + 100.0f;
+        Scene* parent = scene;
+        //each level is masked by a smaller circle
+        for (auto depth = 0; depth < 4; ++depth) {
+            auto level = Scene::gen();
+            auto shape = Shape::gen();
+            shape->appendRect(cx - 100.0f, cy - 100.0f, 200.0f, 200.0f);
+            shape->fill(_channel(), _channel(), _channel());
+            level->add(shape);
+            auto mask = Shape::gen();
+            auto r = 100.0f - float(depth) * 20.0f;
+            mask->appendCircle(cx, cy, r, r);
+            mask->fill(0, 0, 0, 200);
+            level->mask(mask, (depth % 2) ? MaskMethod::InvAlpha : MaskMethod::Alpha);
+            parent->add(level);
+            parent = level;
+        }
+    }
+    return true;
+}
+
+
+static bool _blurs(Scene* scene)
+{
+    for (auto i = 0; i < 4; ++i) {
+        auto group = Scene::gen();
+        for (auto j = 0; j < 50; ++j) {
+            auto shape = Shape::gen();
+            auto x = float(i % 2) * 400.0f + _random(0.0f, 350.0f), y = float(i / 2) * 400.0f + _random(0.0f, 350.0f);
+            shape->appendCircle(x, y, _random(5.0f, 40.0f), _random(5.0f, 40.0f));
+            shape->fill(_channel(), _channel(), _channel());
+            group->add(shape);
+        }
+        group->add(SceneEffect::GaussianBlur, 2.0 + double(i) * 3.0, 0, 0, 100);
+        scene->add(group);
+    }
+    return true;
+}
+
+
+static bool _textParagraphs(Scene* scene)
+{
+    static const char* paragraph =
+        "The quick brown fox jumps over the lazy dog while the wizard quickly jinxed the gnomes before they vaporized. "
+        "Typography, kerning and tracking: WAVE, Tavern, Yawn, LATTE, Voyage, Kyoto, Pyramid, Flying, Awkward, Vowel.";
+
+    if (Text::load(TEST_DIR"/PublicSans-Regular.ttf") != Result::Success) return false;
+
+    for (auto i = 0; i < 12; ++i) {
+        auto text = Text::gen();
+        text->font(nullptr);
+        text->size(12.0f + float(i % 4) * 2.0f);
+        text->layout(380.0f, 0.0f);
+        text->wrap(TextWrap::Word);
+        text->text(paragraph);
+        text->fill(_channel(), _channel(), _channel());
+        text->translate(float(i % 2) * 400.0f + 10.0f, float(i / 2) * 130.0f + 10.0f);
+        scene->add(text);
+    }
+    return true;
+}
+
+
+static string svg;
+
+static bool _svgParse(Scene*)
+{
+    //a large document of paths with the inherited styles
+    char buf[256];
+    svg = "<svg xmlns=\"http://www.w3.org/2000/svg\" viewBox=\"0 0 800 800\">";
+    for (auto i = 0; i < 100; ++i) {
+        snprintf(buf, sizeof(buf), "<g fill=\"#%02x%02x%02x\" stroke=\"#000\" stroke-width=\"0.5\">", _channel(), _channel(), _channel());
+        svg += buf;
+        for (auto j = 0; j < 50; ++j) {
+            auto v = [](float range) { return int(_random(-range, range)); };
+            snprintf(buf, sizeof(buf), "<path d=\"M%d %d c %d %d %d %d %d %d l %d %d z\"/>", int(_random(0.0f, 800.0f)), int(_random(0.0f, 800.0f)),
+                     v(20.0f), v(20.0f), v(20.0f), v(20.0f), v(20.0f), v(20.0f), v(20.0f), v(20.0f));
+            svg += buf;
+        }
+        svg += "</g>";
+    }
+    svg += "</svg>";
+    return true;
+}
+
+//the document is parsed again every round
+static void _svgParseRound(Scene* scene, uint32_t)
+{
+    scene->remove();
+    auto picture = Picture::gen();
+    picture->load(svg.c_str(), uint32_t(svg.size()), "svg");
+    scene->add(picture);
+}
+
+
+static Animation* animation = nullptr;
+
+static bool _lottie(Scene* scene)
+{
+    animation = Animation::gen();
+    if (animation->picture()->load(TEST_DIR"/test13.lot") != Result::Success) return false;
+    animation->picture()->size(WIDTH, HEIGHT);
+    scene->add(animation->picture());
+    return true;
+}
+
+static void _lottieSequential(Scene*, uint32_t round)
+{
+    animation->frame(float(round % uint32_t(animation->totalFrame())));
+}
+
+static void _lottieSeek(Scene*, uint32_t)
+{
+    animation->frame(_random(0.0f, animation->totalFrame()));
+}
+
+static void _lottieTerm()
+{
+    delete(animation);
+    animation = nullptr;
+}
+
+
+static bool _imageScaling(Scene* scene)
+{
+    static constexpr uint32_t SIZE = 512;
+    static uint32_t image[SIZE * SIZE];
+
+    //a checkered gradient
+    for (uint32_t y = 0; y < SIZE; ++y) {
+        for (uint32_t x = 0; x < SIZE; ++x) {
+            auto c = ((x / 32 + y / 32) % 2) ? 255 : 64;
+            image[y * SIZE + x] = 0xff000000 | (c << 16) | ((x / 2) << 8) | (y / 2);
+        }
+    }
+    auto picture = Picture::gen();
+    if (picture->load(image, SIZE, SIZE, ColorSpace::ARGB8888, true) != Result::Success) return false;
+    scene->add(picture);
+    return true;
+}
+
+//down and up scaling with a slight rotation
+static void _imageScalingRound(Scene* scene, uint32_t round)
+{
+    static const float scales[] = {0.37f, 0.75f, 1.3f, 1.9f};
+    Paint* const* paints;
+    if (scene->paints(&paints) == 0) return;
+    auto picture = paints[0];
+    picture->scale(scales[round % 4]);
+    picture->rotate(float(round % 3) * 5.0f);
+}
+
+
+struct Scenario
+{
+    const char* name;
+    bool (*prepare)(Scene* scene);                      //builds the content once
+    void (*round)(Scene* scene, uint32_t round);        //changes the content before a round
+    void (*term)();                                     //releases the resources out of the scene
+};
+
+static const Scenario scenarios[] = {
+    {"solid-shapes", _solidShapes, _jitter, nullptr},
+    {"gradients", _gradients, _jitter, nullptr},
+    {"dashed-strokes", _dashedStrokes, _jitter, nullptr},
+    {"nested-masks", _nestedMasks, _jitter, nullptr},
+    {"blurs", _blurs, _jitter, nullptr},
+    {"text-paragraphs", _textParagraphs, _jitter, nullptr},
+    {"svg-parse", _svgParse, _svgParseRound, nullptr},
+    {"lottie-sequential", _lottie, _lottieSequential, _lottieTerm},
+    {"lottie-seek", _lottie, _lottieSeek, _lottieTerm},
+    {"image-scaling", _imageScaling, _imageScalingRound, nullptr},
+};
+
+
+/************************************************************************/
+/* Runner                                                               */
+/************************************************************************/
+
+struct Report
+{
+    const char* name;
+    uint32_t threads;
+    uint32_t rounds;
+    double min, mean, p50, p90, p99, max;   //milliseconds
+};
+
+static double _percentile(const vector<double>& sorted, double p)
+{
+    //nearest rank
+    auto idx = size_t(ceil(p * sorted.size()));
+    return sorted[idx > 0 ? idx - 1 : 0];
+}
+
+static bool _run(const Scenario& scenario, SwCanvas* canvas, uint32_t threads, uint32_t rounds, Report& report)
+{
+    seed = 7;
+
+    auto scene = Scene::gen();
+    if (!scenario.prepare(scene)) {
+        printf("%-18s failed to prepare\n", scenario.name);
+        Paint::rel(scene);
+        if (scenario.term) scenario.term();
+        return false;
+    }
+    canvas->add(scene);
+
+    auto frame = [&](uint32_t round) {
+        scenario.round(scene, round);
+        canvas->update();
+        canvas->draw(true);
+        canvas->sync();
+    };
+
+    //warm up the caches
+    for (uint32_t i = 0; i < 2; ++i) frame(i);
+
+    vector<double> samples;
+    samples.reserve(rounds);
+    for (uint32_t i = 0; i < rounds; ++i) {
+        auto begin = Clock::now();
+        frame(i + 2);
+        samples.push_back(std::chrono::duration<double, std::milli>(Clock::now() - begin).count());
+    }
+
+    canvas->remove(scene);
+    if (scenario.term) scenario.term();
+
+    sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (auto s : samples) sum += s;
+
+    report = {scenario.name, threads, rounds, samples.front(), sum / rounds, _percentile(samples, 0.5), _percentile(samples, 0.9), _percentile(samples, 0.99), samples.back()};
+    printf("%-18s %7u %9.3f %9.3f %9.3f %9.3f %9.3f\n", report.name, threads, report.p50, report.p90, report.p99, report.min, report.mean);
+    fflush(stdout);
+
+    return true;
+}
+
+static bool _export(const char* path, const vector<Report>& reports)
+{
+    auto fp = fopen(path, "w");
+    if (!fp) return false;
+
+    fprintf(fp, "{\n  \"canvas\": [%u, %u],\n  \"results\": [\n", WIDTH, HEIGHT);
+    for (size_t i = 0; i < reports.size(); ++i) {
+        auto& r = reports[i];
+        fprintf(fp, "    {\"scenario\": \"%s\", \"threads\": %u, \"rounds\": %u, \"min\": %.4f, \"mean\": %.4f, \"p50\": %.4f, \"p90\": %.4f, \"p99\": %.4f, \"max\": %.4f}%s\n",
+                r.name, r.threads, r.rounds, r.min, r.mean, r.p50, r.p90, r.p99, r.max, (i + 1 < reports.size()) ? "," : "");
+    }
+    fprintf(fp, "  ]\n}\n");
+    fclose(fp);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t rounds = 30;
+    const char* json = nullptr;
+    vector<uint32_t> threads;
+    vector<const char*> filters;
+
+    for (auto i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "-r") && i + 1 < argc) rounds = (uint32_t) atoi(argv[++i]);
+        else if (!strcmp(argv[i], "-j") && i + 1 < argc) json = argv[++i];
+        else if (!strcmp(argv[i], "-t") && i + 1 < argc) {
+            for (auto p = strtok(argv[++i], ","); p; p = strtok(nullptr, ",")) {
+                if (atoi(p) > 0) threads.push_back((uint32_t) atoi(p));
+            }
+        } else filters.push_back(argv[i]);
+    }
+    if (rounds == 0) return 1;
+
+    //1, 2, 4 and all the hardware threads by default
+    if (threads.empty()) {
+        auto n = std::max(std::thread::hardware_concurrency(), 1u);
+        for (auto t : {1u, 2u, 4u, n}) {
+            if (find(threads.begin(), threads.end(), t) == threads.end()) threads.push_back(t);
+        }
+    }
+
+    auto buffer = (uint32_t*) malloc(sizeof(uint32_t) * WIDTH * HEIGHT);
+    vector<Report> reports;
+
+    printf("canvas: %ux%u, rounds: %u\n", WIDTH, HEIGHT, rounds);
+    printf("%-18s %7s %9s %9s %9s %9s %9s  (ms)\n", "scenario", "threads", "p50", "p90", "p99", "min", "mean");
+
+    for (auto t : threads) {
+        //the main thread takes part in the tasks as well
+        if (Initializer::init(t - 1) != Result::Success) return 1;
+
+        auto canvas = SwCanvas::gen();
+        canvas->target(buffer, WIDTH, WIDTH, HEIGHT, ColorSpace::ARGB8888);
+
+        for (auto& scenario : scenarios) {
+            if (!filters.empty()) {
+                auto matched = false;
+                for (auto f : filters) {
+                    if (strstr(scenario.name, f)) matched = true;
+                }
+                if (!matched) continue;
+            }
+            Report report;
+            if (_run(scenario, canvas, t, rounds, report)) reports.push_back(report);
+        }
+
+        delete(canvas);
+        Initializer::term();
+    }
+
+    free(buffer);
+
+    if (json) {
+        if (!_export(json, reports)) {
+            printf("failed to write %s\n", json);
+            return 1;
+        }
+        printf("exported to %s\n", json);
+    }
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+/*
+ * Micro benchmark of the text layout, a paragraph is laid out repeatedly with the word wrapping.
+ *
+ * Usage: tvgBenchText [font path] [rounds]
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thorvg.h>
+
+using namespace tvg;
+using Clock = std::chrono::steady_clock;
+
+static const char* paragraph =
+    "AVAWAY To Ta Te Yo LT P. F, Wa. The quick brown fox jumps over the lazy dog while the wizard quickly "
+    "jinxed the gnomes before they vaporized. Typography, kerning and tracking: WAVE, Tavern, Yawn, LATTE, "
+    "Voyage, Kyoto, Pyramid, Flying, Awkward, Vowel, Toyota, Yvonne, AWAY, VALLEY, Wyoming. ";
+
+int main(int argc, char **argv)
+{
+    auto font = (argc > 1) ? argv[1] : TEST_DIR"/PublicSans-Regular.ttf";
+    auto rounds = (argc > 2) ? atoi(argv[2]) : 1000;
+    if (rounds <= 0) return 1;
+
+    if (Initializer::init(0) != Result::Success) return 1;
+
+    if (Text::load(font) != Result::Success) {
+        printf("failed to load the font: %s\n", font);
+        return 1;
+    }
+
+    auto text = Text::gen();
+    text->font(nullptr);
+    text->size(20);
+    text->layout(600, 0);
+    text->wrap(TextWrap::Word);
+
+    //the alternate lines force the relayout every round
+    char lines[2][1024];
+    snprintf(lines[0], sizeof(lines[0]), "%s%s", paragraph, paragraph);
+    snprintf(lines[1], sizeof(lines[1]), "%s%s.", paragraph, paragraph);
+
+    text->text(lines[1]);
+    text->lines();   //warm up the glyph cache
+
+    //lines() triggers the layout only, bounds() would measure the curves as well
+    uint32_t cnt = 0;
+    auto begin = Clock::now();
+    for (auto i = 0; i < rounds; ++i) {
+        text->text(lines[i % 2]);
+        cnt += text->lines();
+    }
+    auto elapsed = std::chrono::duration<double, std::micro>(Clock::now() - begin).count();
+
+    printf("font: %s, rounds: %d, layout: %.2f us/paragraph (%u lines)\n", font, rounds, elapsed / rounds, cnt / rounds);
+
+    Paint::rel(text);
+    Initializer::term();
+
+    return 0;
+}
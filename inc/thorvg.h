@@ -1,6 +1,7 @@
 #ifndef _THORVG_H_
 #define _THORVG_H_
 
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <list>
@@ -396,6 +397,50 @@ struct GlyphMetrics
 };
 
 
+/**
+ * @brief Describes where the time of the last frame of a canvas went.
+ *
+ * The timings are measured in milliseconds on the caller side of the canvas. The counters come from the rendering engine,
+ * the engines which don't track one of them leave it zero.
+ *
+ * @see Canvas::stats()
+ * @note Experimental API
+ */
+struct FrameStats
+{
+    float update;           ///< The time spent in Canvas::update(), preparing the render data of the paints.
+    float render;           ///< The time spent in Canvas::draw() and Canvas::sync(), including the compositing and the post effects.
+    float composite;        ///< The part of the render time spent in blending the compositions(masking, clipping, blending and opacity).
+    float effect;           ///< The part of the render time spent in applying the scene effects.
+    uint32_t tessellated;   ///< The number of the shapes whose geometry was generated again.
+    uint32_t reused;        ///< The number of the updated shapes which kept their previous geometry.
+    uint32_t spans;         ///< The number of the rle spans generated for the shapes and the strokes.
+    uint32_t compositors;   ///< The number of the compositor buffers newly allocated.
+    uint32_t tasks;         ///< The number of the render tasks scheduled.
+    uint32_t area;          ///< The redrawn area in pixels, the dirty regions with the partial rendering or the whole viewport.
+    uint32_t retries;       ///< The number of the rasterizations retried in the smaller bands, the shapes were too complex for the memory pools.
+};
+
+
+/**
+ * @brief The memory allocation callbacks replacing the system allocator of the engine.
+ *
+ * The callbacks follow the semantics of the standard C functions, the @p user is passed to them as given.
+ * They must be thread-safe if the engine runs with the worker threads.
+ *
+ * @see Initializer::init()
+ * @note Experimental API
+ */
+struct Allocator
+{
+    void* (*malloc)(size_t size, void* user);                ///< Allocates a memory block of the @p size bytes.
+    void* (*calloc)(size_t nmem, size_t size, void* user);   ///< Allocates a zero-initialized array of the @p nmem elements of the @p size bytes.
+    void* (*realloc)(void* ptr, size_t size, void* user);    ///< Resizes the memory block, @p ptr may be @c nullptr.
+    void (*free)(void* ptr, void* user);                     ///< Releases the memory block, @p ptr may be @c nullptr.
+    void* user;                                              ///< The user data passed to the callbacks.
+};
+
+
 /**
  * @class Paint
  *
@@ -910,10 +955,29 @@ struct TVG_API Canvas
      * @see Canvas::remove()
      *
      * @warning This is read-only. Do not modify the list.
+     * @note The list is assembled on demand from the internal storage. Prefer paints(Paint* const**) for frequent access.
      * @note 1.0
      */
     const std::list<Paint*>& paints() const noexcept;
 
+    /**
+     * @brief Retrieves the paints currently held by the Canvas as a contiguous array.
+     *
+     * Unlike paints(), this accessor exposes the internal storage directly without building a list.
+     *
+     * @param[out] paints The pointer to the array of the paints in the rendering order. Can be @c nullptr to query the count only.
+     *
+     * @return The number of the paints in the array.
+     *
+     * @warning Please avoid accessing the paints during Canvas update/draw. You can access them after calling sync().
+     * @warning This is read-only. The array is valid until the Canvas paints are changed.
+     *
+     * @see Canvas::paints()
+     * @note Experimental API
+     * @since 1.1
+     */
+    uint32_t paints(Paint* const** paints) const noexcept;
+
     /**
      * @brief Adds a paint object to the canvas root scene.
      *
@@ -1036,6 +1100,26 @@ struct TVG_API Canvas
      */
     Result sync() noexcept;
 
+    /**
+     * @brief Retrieves the performance statistics of the last rendered frame.
+     *
+     * The statistics are reset by every Canvas::update() and gathered until Canvas::sync().
+     * They can be used to tune the content or to catch the performance regressions.
+     *
+     * @param[out] stats The statistics of the last frame.
+     *
+     * @retval Result::InvalidArguments In case the @p stats is @c nullptr.
+     * @retval Result::InsufficientCondition If the canvas is not synced yet.
+     * @retval Result::NonSupport If thorvg is built without the statistics support(meson option 'stats').
+     *
+     * @note Experimental API
+     * @see FrameStats
+     * @see Canvas::sync()
+     *
+     * @since 1.1
+     */
+    Result stats(FrameStats* stats) const noexcept;
+
     _TVG_DECLARE_PRIVATE_BASE(Canvas);
 };
 
@@ -1582,6 +1666,29 @@ struct TVG_API Shape : Paint
      */
     static Shape* gen() noexcept;
 
+    /**
+     * @brief Creates a lightweight instance of this shape.
+     *
+     * The instance renders the path, the fill and the stroke of this shape without copying them,
+     * while it keeps its own transformation, opacity, blending, masking and clipping.
+     * This suits drawing the same graphic many times, such as particles or map markers,
+     * with far less memory and update cost than Paint::duplicate().
+     *
+     * A solid color set by fill(uint8_t r, uint8_t g, uint8_t b, uint8_t a) on the instance overrides the fill of this shape.
+     * The changes of this shape are applied to its instances in their next update.
+     *
+     * @return A new Shape object instancing this shape.
+     *
+     * @note This shape is retained by its instances until they are released.
+     * @note The other path and stroke properties set on the instance are ignored. Calling reset() turns it into a regular, empty shape.
+     * @note Instancing an instance refers to its source shape.
+     * @note Experimental API
+     * @see Paint::duplicate()
+     *
+     * @since 1.1
+     */
+    Shape* instance() noexcept;
+
     /**
      * @brief Returns the ID value of this class.
      *
@@ -1890,10 +1997,28 @@ struct TVG_API Scene : Paint
      * @see Scene::remove()
      *
      * @warning This is read-only. Do not modify the list.
+     * @note The list is assembled on demand from the internal storage. Prefer paints(Paint* const**) for frequent access.
      * @since 1.0
      */
     const std::list<Paint*>& paints() const noexcept;
 
+    /**
+     * @brief Retrieves the paints currently held by the Scene as a contiguous array.
+     *
+     * Unlike paints(), this accessor exposes the internal storage directly without building a list.
+     *
+     * @param[out] paints The pointer to the array of the paints in the rendering order. Can be @c nullptr to query the count only.
+     *
+     * @return The number of the paints in the array.
+     *
+     * @warning This is read-only. The array is valid until the Scene paints are changed.
+     *
+     * @see Scene::paints()
+     * @note Experimental API
+     * @since 1.1
+     */
+    uint32_t paints(Paint* const** paints) const noexcept;
+
     /**
      * @brief Removes a paint object or all paint objects from the scene.
      *
@@ -1932,6 +2057,34 @@ struct TVG_API Scene : Paint
      */
     Result add(SceneEffect effect, ...) noexcept;
 
+    /**
+     * @brief Finds the child paints whose filled area intersects a given region.
+     *
+     * The children are reported through the @p func from the topmost to the bottommost, in the reverse order of drawing.
+     * It's the hit-testing of Paint::intersects() on every child, but the candidates are looked up
+     * from a spatial index of the children's render regions, which is maintained along with the Canvas::update().
+     *
+     * The scene must be updated in a Canvas beforehand—typically after the Canvas has been drawn and synchronized.
+     *
+     * @param[in] x The x-coordinate of the top-left corner of the test region.
+     * @param[in] y The y-coordinate of the top-left corner of the test region.
+     * @param[in] w The width of the region to test. Must be greater than 0.
+     * @param[in] h The height of the region to test. Must be greater than 0.
+     * @param[in] func The function called for every intersected child @p paint. Return @c false to stop the picking.
+     * @param[in] data The user data passed to the @p func.
+     *
+     * @retval Result::InvalidArguments If the region is empty or the @p func is not given.
+     * @retval Result::InsufficientCondition If the scene has not been updated by the canvas.
+     *
+     * @note Only the direct children are reported, call pick() on a child scene to look into it.
+     * @note Hidden paints are excluded. This test does not take into account the results of blending or masking.
+     * @note Experimental API
+     * @see Paint::intersects()
+     *
+     * @since 1.1
+     */
+    Result pick(int32_t x, int32_t y, int32_t w, int32_t h, std::function<bool(Paint* paint, void* data)> func, void* data) noexcept;
+
     /**
      * @brief Creates a new Scene object.
      *
@@ -2553,6 +2706,29 @@ struct TVG_API Initializer final
      */
     static Result init(uint32_t threads = 0) noexcept;
 
+    /**
+     * @brief Initializes the ThorVG engine runtime with the custom memory allocator.
+     *
+     * Same as init(), but the memory of the engine is allocated through the given @p allocator.
+     * It's installed with the first initialization only, the system allocator is used if @p allocator is @c nullptr.
+     *
+     * @param[in] threads The number of worker threads to launch.
+     * @param[in] allocator The memory allocation callbacks. The structure is copied.
+     *
+     * @retval Result::InvalidArguments If any of the callbacks is not given.
+     *
+     * @note Every paint, canvas, saver and animation must be created after the initialization,
+     *       and released before the next initialization, which may be after the termination.
+     *       The allocator stays installed until the next initialization, the callbacks must stay valid until then.
+     * @note The C++ objects are allocated by the global operator new, which is shared with the application.
+     *       The allocator covers the rest, which are the most of the engine data such as paths, spans and pixel buffers.
+     * @note Experimental API
+     *
+     * @see Initializer::term()
+     * @since 1.1
+     */
+    static Result init(uint32_t threads, const Allocator* allocator) noexcept;
+
     /**
      * @brief Terminates the ThorVG engine.
      *
@@ -2579,6 +2755,23 @@ struct TVG_API Initializer final
      */
     static const char* version(uint32_t* major, uint32_t* minor, uint32_t* micro) noexcept;
 
+    /**
+     * @brief Limits the memory used by the decoded raster images.
+     *
+     * When the decoded pixels of the raster images (PNG, JPG, WEBP) exceed the budget, the least recently drawn ones
+     * which were not drawn in the last frame release their pixels at the next Canvas::update(). The released images are decoded
+     * again from their sources once they come into the viewport.
+     *
+     * @param[in] kbytes The memory budget in kilobytes. @c 0 means unlimited. (default)
+     *
+     * @note The images loaded from the raw pixels or by the external loaders are not counted in the budget.
+     * @note A canvas releases the images drawn by itself only. The images shared with the other canvases keep their pixels.
+     * @note Experimental API
+     *
+     * @since 1.1
+     */
+    static Result budget(uint32_t kbytes) noexcept;
+
     _TVG_DISABLE_CTOR(Initializer);
 };
 
@@ -2757,6 +2950,31 @@ struct TVG_API Saver final
      */
     Result save(Paint* paint, const char* filename, uint32_t quality = 100) noexcept;
 
+    /**
+     * @brief Exports the given @p paint data through the @p writer instead of a file.
+     *
+     * The encoded data is delivered to the @p writer in order, chunk by chunk as it's produced.
+     * This allows to keep the result in memory or to pass it straight to a network stream without the filesystem.
+     *
+     * @param[in] paint The paint to be saved with all its associated properties.
+     * @param[in] mimeType The encoding format, same as the file extension name (i.e. "gif", "png").
+     * @param[in] writer The function receiving the encoded @p data of the @p size bytes. Return @c false to abort the saving.
+     * @param[in] user The user data passed to the @p writer.
+     * @param[in] quality The encoded quality level. @c 0 is the minimum, @c 100 is the maximum value(recommended).
+     *
+     * @retval Result::InvalidArguments If the @p writer is not given.
+     * @retval Result::InsufficientCondition If currently saving other resources.
+     * @retval Result::NonSupport When trying to save in an unsupported format.
+     * @retval Result::Unknown In case an empty paint is to be saved.
+     *
+     * @note The @p writer may be called in a worker thread if the saving is asynchronous. It's called no more after sync().
+     * @note Experimental API
+     * @see Saver::sync()
+     *
+     * @since 1.1
+     */
+    Result save(Paint* paint, const char* mimeType, std::function<bool(const uint8_t* data, uint32_t size, void* user)> writer, void* user, uint32_t quality = 100) noexcept;
+
     /**
      * @brief Export the provided animation data to the specified file path.
      *
@@ -2780,6 +2998,32 @@ struct TVG_API Saver final
      */
     Result save(Animation* animation, const char* filename, uint32_t quality = 100, uint32_t fps = 0) noexcept;
 
+    /**
+     * @brief Exports the provided animation data through the @p writer instead of a file.
+     *
+     * The encoded data is delivered to the @p writer in order, at least once per encoded frame.
+     * This allows to keep the result in memory or to pass it straight to a network stream without the filesystem.
+     *
+     * @param[in] animation The animation to be saved, including all associated properties.
+     * @param[in] mimeType The encoding format, same as the file extension name (i.e. "gif", "png").
+     * @param[in] writer The function receiving the encoded @p data of the @p size bytes. Return @c false to abort the saving.
+     * @param[in] user The user data passed to the @p writer.
+     * @param[in] quality The encoded quality level. @c 0 is the minimum, @c 100 is the maximum value(recommended).
+     * @param[in] fps The desired frames per second (FPS). Pass 0 to keep the original frame data.
+     *
+     * @retval Result::InvalidArguments If the @p writer is not given.
+     * @retval Result::InsufficientCondition if there are ongoing resource-saving operations.
+     * @retval Result::NonSupport if an attempt is made to save in an unsupported format.
+     * @retval Result::Unknown if attempting to save an empty paint.
+     *
+     * @note The @p writer may be called in a worker thread if the saving is asynchronous. It's called no more after sync().
+     * @note Experimental API
+     * @see Saver::sync()
+     *
+     * @since 1.1
+     */
+    Result save(Animation* animation, const char* mimeType, std::function<bool(const uint8_t* data, uint32_t size, void* user)> writer, void* user, uint32_t quality = 100, uint32_t fps = 0) noexcept;
+
     /**
      * @brief Guarantees that the saving task is finished.
      *
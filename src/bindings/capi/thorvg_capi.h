@@ -1,6 +1,7 @@
 #ifndef __THORVG_CAPI_H__
 #define __THORVG_CAPI_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -138,6 +139,45 @@ typedef struct
     float e31, e32, e33;
 } Tvg_Matrix;
 
+/**
+ * @brief A data structure describing where the time of the last frame of a canvas went.
+ *
+ * @see tvg_canvas_get_stats()
+ * @note Experimental API
+ */
+typedef struct
+{
+    float update;           ///< The time spent in tvg_canvas_update() in milliseconds.
+    float render;           ///< The time spent in tvg_canvas_draw() and tvg_canvas_sync() in milliseconds, including the compositing and the post effects.
+    float composite;        ///< The part of the render time spent in blending the compositions.
+    float effect;           ///< The part of the render time spent in applying the scene effects.
+    uint32_t tessellated;   ///< The number of the shapes whose geometry was generated again.
+    uint32_t reused;        ///< The number of the updated shapes which kept their previous geometry.
+    uint32_t spans;         ///< The number of the rle spans generated for the shapes and the strokes.
+    uint32_t compositors;   ///< The number of the compositor buffers newly allocated.
+    uint32_t tasks;         ///< The number of the render tasks scheduled.
+    uint32_t area;          ///< The redrawn area in pixels.
+    uint32_t retries;       ///< The number of the rasterizations retried in the smaller bands.
+} Tvg_Frame_Stats;
+
+/**
+ * @brief The memory allocation callbacks replacing the system allocator of the engine.
+ *
+ * The callbacks follow the semantics of the standard C functions, the @c user is passed to them as given.
+ * They must be thread-safe if the engine runs with the worker threads.
+ *
+ * @see tvg_engine_init_with_allocator()
+ * @note Experimental API
+ */
+typedef struct
+{
+    void* (*malloc)(size_t size, void* user);                ///< Allocates a memory block of the @c size bytes.
+    void* (*calloc)(size_t nmem, size_t size, void* user);   ///< Allocates a zero-initialized array of the @c nmem elements of the @c size bytes.
+    void* (*realloc)(void* ptr, size_t size, void* user);    ///< Resizes the memory block, @c ptr may be @c NULL.
+    void (*free)(void* ptr, void* user);                     ///< Releases the memory block, @c ptr may be @c NULL.
+    void* user;                                              ///< The user data passed to the callbacks.
+} Tvg_Allocator;
+
 /**
  * @brief Enumeration specifying the methods of combining the 8-bit color channels into 32-bit color.
  *
@@ -451,6 +491,26 @@ typedef bool (*Tvg_Picture_Asset_Resolver)(Tvg_Paint paint, const char* src, voi
  */
 TVG_API Tvg_Result tvg_engine_init(unsigned threads);
 
+/**
+ * @brief Initializes the ThorVG engine with the custom memory allocator.
+ *
+ * Same as tvg_engine_init(), but the memory of the engine is allocated through the given @p allocator.
+ * It's installed with the first initialization only, the system allocator is used if @p allocator is @c NULL.
+ *
+ * @param[in] threads The number of worker threads to create.
+ * @param[in] allocator The memory allocation callbacks. The structure is copied.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT If any of the callbacks is not given.
+ *
+ * @note Every object of the engine must be created after the initialization and released before the next initialization,
+ *       which may be after the termination. The allocator stays installed until the next initialization,
+ *       the callbacks must stay valid until then.
+ * @note Experimental API
+ *
+ * @see tvg_engine_term()
+ */
+TVG_API Tvg_Result tvg_engine_init_with_allocator(unsigned threads, const Tvg_Allocator* allocator);
+
 /**
  * @brief Terminates the ThorVG engine.
  *
@@ -477,6 +537,21 @@ TVG_API Tvg_Result tvg_engine_term(void);
  */
 TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t* micro, const char** version);
 
+/**
+ * @brief Limits the memory used by the decoded raster images.
+ *
+ * The least recently drawn images over the budget release their pixels and are decoded again once they come into the viewport.
+ *
+ * @param[in] kbytes The memory budget in kilobytes. @c 0 means unlimited. (default)
+ *
+ * @retval TVG_RESULT_SUCCESS.
+ *
+ * @note A canvas releases the images drawn by itself only. The images shared with the other canvases keep their pixels.
+ * @note Experimental API
+ * @since 1.1
+ */
+TVG_API Tvg_Result tvg_engine_budget(uint32_t kbytes);
+
 /** \} */   // end defgroup ThorVGCapi_Initializer
 
 /**
@@ -855,6 +930,24 @@ TVG_API Tvg_Result tvg_canvas_sync(Tvg_Canvas canvas);
  */
 TVG_API Tvg_Result tvg_canvas_set_viewport(Tvg_Canvas canvas, int32_t x, int32_t y, int32_t w, int32_t h);
 
+/**
+ * @brief Retrieves the performance statistics of the last rendered frame.
+ *
+ * The statistics are reset by every tvg_canvas_update() and gathered until tvg_canvas_sync().
+ *
+ * @param[in] canvas The canvas object to be queried.
+ * @param[out] stats The statistics of the last frame.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT An invalid canvas or @p stats pointer passed.
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION If the canvas is not in a synced state.
+ * @retval TVG_RESULT_NOT_SUPPORTED If thorvg is built without the statistics support.
+ *
+ * @note Experimental API
+ * @see tvg_canvas_sync()
+ * @since 1.1
+ */
+TVG_API Tvg_Result tvg_canvas_get_stats(const Tvg_Canvas canvas, Tvg_Frame_Stats* stats);
+
 /** \} */   // end defgroup ThorVGCapi_Canvas
 
 /**
@@ -2759,6 +2852,22 @@ TVG_API Tvg_Result tvg_font_unload(const char* path);
  * \{
  */
 
+/**
+ * @brief Callback function type for receiving the encoded data of the Tvg_Saver.
+ *
+ * @param[in] data The encoded data chunk, valid only during the call.
+ * @param[in] size The size of the @p data in bytes.
+ * @param[in] user User-provided custom data passed to the callback for context.
+ *
+ * @return @c true to continue the saving, @c false to abort it.
+ *
+ * @see tvg_saver_save_paint_stream()
+ * @see tvg_saver_save_animation_stream()
+ *
+ * @note Experimental API
+ */
+typedef bool (*Tvg_Saver_Writer)(const uint8_t* data, uint32_t size, void* user);
+
 /************************************************************************/
 /* Saver API                                                            */
 /************************************************************************/
@@ -2816,6 +2925,55 @@ TVG_API Tvg_Result tvg_saver_save_paint(Tvg_Saver saver, Tvg_Paint paint, const
 */
 TVG_API Tvg_Result tvg_saver_save_animation(Tvg_Saver saver, Tvg_Animation animation, const char* path, uint32_t quality, uint32_t fps);
 
+/**
+ * @brief Exports the given @p paint data through the @p writer instead of a file.
+ *
+ * The encoded data is delivered to the @p writer in order, chunk by chunk as it's produced.
+ *
+ * @param[in] saver The Tvg_Saver object connected with the saving task.
+ * @param[in] paint The paint to be saved with all its associated properties.
+ * @param[in] mimetype The encoding format, same as the file extension name (i.e. "gif").
+ * @param[in] writer The callback receiving the encoded data.
+ * @param[in] user The user data passed to the @p writer.
+ * @param[in] quality The encoded quality level. @c 0 is the minimum, @c 100 is the maximum value(recommended).
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT The @p writer is not given.
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION Currently saving other resources.
+ * @retval TVG_RESULT_NOT_SUPPORTED Trying to save in an unsupported format.
+ * @retval TVG_RESULT_UNKNOWN An empty paint is to be saved.
+ *
+ * @note The @p writer may be called in a worker thread if the saving is asynchronous.
+ * @note Experimental API
+ * @see tvg_saver_sync()
+ * @since 1.1
+ */
+TVG_API Tvg_Result tvg_saver_save_paint_stream(Tvg_Saver saver, Tvg_Paint paint, const char* mimetype, Tvg_Saver_Writer writer, void* user, uint32_t quality);
+
+/**
+ * @brief Exports the given @p animation data through the @p writer instead of a file.
+ *
+ * The encoded data is delivered to the @p writer in order, at least once per encoded frame.
+ *
+ * @param[in] saver The Tvg_Saver object connected with the saving task.
+ * @param[in] animation The animation to be saved with all its associated properties.
+ * @param[in] mimetype The encoding format, same as the file extension name (i.e. "gif").
+ * @param[in] writer The callback receiving the encoded data.
+ * @param[in] user The user data passed to the @p writer.
+ * @param[in] quality The encoded quality level. @c 0 is the minimum, @c 100 is the maximum value(recommended).
+ * @param[in] fps The frames per second for the animation. If @c 0, the default fps is used.
+ *
+ * @retval TVG_RESULT_INVALID_ARGUMENT The @p writer is not given.
+ * @retval TVG_RESULT_INSUFFICIENT_CONDITION Currently saving other resources or animation has no frames.
+ * @retval TVG_RESULT_NOT_SUPPORTED Trying to save in an unsupported format.
+ * @retval TVG_RESULT_UNKNOWN Unknown if attempting to save an empty paint.
+ *
+ * @note The @p writer may be called in a worker thread if the saving is asynchronous.
+ * @note Experimental API
+ * @see tvg_saver_sync()
+ * @since 1.1
+ */
+TVG_API Tvg_Result tvg_saver_save_animation_stream(Tvg_Saver saver, Tvg_Animation animation, const char* mimetype, Tvg_Saver_Writer writer, void* user, uint32_t quality, uint32_t fps);
+
 /**
  * @brief Guarantees that the saving task is finished.
  *
@@ -49,6 +49,12 @@ TVG_API Tvg_Result tvg_engine_init(unsigned threads)
 }
 
 
+TVG_API Tvg_Result tvg_engine_init_with_allocator(unsigned threads, const Tvg_Allocator* allocator)
+{
+    return (Tvg_Result) Initializer::init(threads, reinterpret_cast<const Allocator*>(allocator));
+}
+
+
 TVG_API Tvg_Result tvg_engine_term()
 {
     return (Tvg_Result) Initializer::term();
@@ -61,6 +67,12 @@ TVG_API Tvg_Result tvg_engine_version(uint32_t* major, uint32_t* minor, uint32_t
     return TVG_RESULT_SUCCESS;
 }
 
+
+TVG_API Tvg_Result tvg_engine_budget(uint32_t kbytes)
+{
+    return (Tvg_Result) Initializer::budget(kbytes);
+}
+
 /************************************************************************/
 /* Canvas API                                                           */
 /************************************************************************/
@@ -171,6 +183,13 @@ TVG_API Tvg_Result tvg_canvas_set_viewport(Tvg_Canvas canvas, int32_t x, int32_t
 }
 
 
+TVG_API Tvg_Result tvg_canvas_get_stats(const Tvg_Canvas canvas, Tvg_Frame_Stats* stats)
+{
+    if (canvas) return (Tvg_Result) reinterpret_cast<const Canvas*>(canvas)->stats(reinterpret_cast<FrameStats*>(stats));
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 /************************************************************************/
 /* Paint API                                                            */
 /************************************************************************/
@@ -1063,6 +1082,20 @@ TVG_API Tvg_Result tvg_saver_save_animation(Tvg_Saver saver, Tvg_Animation anima
 }
 
 
+TVG_API Tvg_Result tvg_saver_save_paint_stream(Tvg_Saver saver, Tvg_Paint paint, const char* mimetype, Tvg_Saver_Writer writer, void* user, uint32_t quality)
+{
+    if (saver && writer) return (Tvg_Result) reinterpret_cast<Saver*>(saver)->save((Paint*)paint, mimetype, writer, user, quality);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
+TVG_API Tvg_Result tvg_saver_save_animation_stream(Tvg_Saver saver, Tvg_Animation animation, const char* mimetype, Tvg_Saver_Writer writer, void* user, uint32_t quality, uint32_t fps)
+{
+    if (saver && writer) return (Tvg_Result) reinterpret_cast<Saver*>(saver)->save((Animation*)animation, mimetype, writer, user, quality, fps);
+    return TVG_RESULT_INVALID_ARGUMENT;
+}
+
+
 TVG_API Tvg_Result tvg_saver_sync(Tvg_Saver saver)
 {
     if (saver) return (Tvg_Result) reinterpret_cast<Saver*>(saver)->sync();
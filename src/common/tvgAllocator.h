@@ -25,32 +25,47 @@
 
 #include <cstdlib>
 #include <cstddef>
+#include "thorvg.h"
 
 //separate memory alloators for clean customization
 namespace tvg
 {
+    //the custom allocator given by Initializer::init(), a single instance without a definition in a translation unit
+    template<typename T = void>
+    struct Allocators
+    {
+        static const Allocator* custom;
+    };
+
+    template<typename T>
+    const Allocator* Allocators<T>::custom = nullptr;
+
     template<typename T = void>
     static inline T* malloc(size_t size)
     {
+        if (auto custom = Allocators<>::custom) return static_cast<T*>(custom->malloc(size, custom->user));
         return static_cast<T*>(std::malloc(size));
     }
 
     template<typename T = void>
     static inline T* calloc(size_t nmem, size_t size)
     {
+        if (auto custom = Allocators<>::custom) return static_cast<T*>(custom->calloc(nmem, size, custom->user));
         return static_cast<T*>(std::calloc(nmem, size));
     }
 
     template<typename T = void>
     static inline T* realloc(T* ptr, size_t size)
     {
+        if (auto custom = Allocators<>::custom) return static_cast<T*>(custom->realloc(ptr, size, custom->user));
         return static_cast<T*>(std::realloc(ptr, size));
     }
 
     template<typename T = void>
     static inline void free(T* ptr)
     {
-        std::free(ptr);
+        if (auto custom = Allocators<>::custom) custom->free(ptr, custom->user);
+        else std::free(ptr);
     }
 }
 
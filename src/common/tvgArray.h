@@ -71,6 +71,25 @@ struct Array
         count += rhs.count;
     }
 
+    void insert(uint32_t idx, T element)
+    {
+        if (idx >= count) {
+            push(element);
+            return;
+        }
+        if (full()) grow((count + 2) / 2);
+        memmove(data + idx + 1, data + idx, sizeof(T) * (count - idx));
+        data[idx] = element;
+        ++count;
+    }
+
+    void remove(uint32_t idx)
+    {
+        if (idx >= count) return;
+        memmove(data + idx, data + idx + 1, sizeof(T) * (count - idx - 1));
+        --count;
+    }
+
     bool reserve(uint32_t size)
     {
         if (size > reserved) {
@@ -92,7 +92,8 @@ struct Inlist
         --count;
         auto t = tail;
         tail = t->prev;
-        if (!tail) head = nullptr;
+        if (tail) tail->next = nullptr;
+        else head = nullptr;
         return t;
     }
 
@@ -102,7 +103,8 @@ struct Inlist
         --count;
         auto t = head;
         head = t->next;
-        if (!head) tail = nullptr;
+        if (head) head->prev = nullptr;
+        else tail = nullptr;
         return t;
     }
 
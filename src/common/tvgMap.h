@@ -23,18 +23,25 @@
 #ifndef _TVG_MAP_H_
 #define _TVG_MAP_H_
 
+#include <new>
+#include <cstring>
 #include "tvgCommon.h"
-#include "tvgInlist.h"
+
+//NOTE: the items must not be inserted or removed during the iteration
+#define MAP_FOREACH(MAP, ITEM) \
+    for (auto ITEM = (MAP).begin(); ITEM; ITEM = (MAP).next(ITEM))
 
 namespace tvg
 {
 
+//Open-addressing hash map with the linear probing. The items are stored in a single contiguous table
+//which grows by the load factor, so the item pointers are valid only until the next insertion.
+//Like tvg::Array, the items are relocated by memory copy on growing.
 template<typename K, typename V>
 struct Map
 {
     struct Item
     {
-        INLIST_ITEM(Item);
         K key;
         V val;
 
@@ -43,79 +50,173 @@ struct Map
 
     Item* find(const K& key)
     {
-        auto& bucket = buckets[hash(key)];
-        INLIST_FOREACH(bucket, item) {
-            if (item->key == key) return item;
+        if (count == 0) return nullptr;
+        auto h = hash(key);
+        auto tag = this->tag(h);
+        for (auto i = slot(h); tags[i]; i = (i + 1) & mask) {
+            if (tags[i] == tag && items[i].key == key) return &items[i];
         }
         return nullptr;
     }
 
     void remove(const K& key)
     {
-        auto& bucket = buckets[hash(key)];
-        INLIST_FOREACH(bucket, item) {
-            if (item->key == key) {
-                bucket.remove(item);
-                delete (item);
-                return;
+        auto item = find(key);
+        if (!item) return;
+        item->~Item();
+
+        //backward shift deletion, pull the next items of the probe sequence into the hole
+        auto hole = uint32_t(item - items);
+        for (auto i = (hole + 1) & mask; tags[i]; i = (i + 1) & mask) {
+            auto home = slot(hash(items[i].key));
+            if (((i - home) & mask) >= ((i - hole) & mask)) {
+                memcpy((void*)&items[hole], (void*)&items[i], sizeof(Item));
+                tags[hole] = tags[i];
+                hole = i;
             }
         }
+        tags[hole] = 0;
+        --count;
     }
 
     void clear()
     {
-        for (size_t i = 0; i < size; ++i) {
-            buckets[i].free();
+        if (count == 0) return;
+        for (uint32_t i = 0; i < capacity; ++i) {
+            if (tags[i]) items[i].~Item();
         }
+        memset(tags, 0, capacity);
+        count = 0;
     }
 
     V& operator[](const K& key)
     {
         if (auto item = find(key)) return item->val;
 
-        auto& bucket = buckets[hash(key)];
-        auto item = new Item(key);
-        bucket.back(item);
-        return item->val;
+        //keep the load factor under 0.75
+        if ((count + 1) * 4 > capacity * 3) rehash(capacity > 0 ? capacity * 2 : reserved);
+
+        auto h = hash(key);
+        auto i = slot(h);
+        while (tags[i]) i = (i + 1) & mask;
+        tags[i] = tag(h);
+        ++count;
+        return (new (&items[i]) Item(key))->val;
+    }
+
+    //prepare the table for the given number of items
+    void reserve(uint32_t size)
+    {
+        auto capacity = _capacity(size);
+        if (capacity > this->capacity) rehash(capacity);
     }
 
-    Map(size_t size = 32)
+    Item* begin()
     {
-        if (size < 1) size = 1;
-        buckets = new Inlist<Item>[size];
-        this->size = size;
+        return seek(0);
+    }
+
+    Item* next(const Item* item)
+    {
+        return seek(uint32_t(item - items) + 1);
+    }
+
+    Map(uint32_t size = 32)
+    {
+        reserved = _capacity(size);
     }
 
     ~Map()
     {
-        delete[] buckets;
+        clear();
+        tvg::free(items);
+        tvg::free(tags);
     }
 
     Map(const Map&) = delete;
     Map& operator=(const Map&) = delete;
 
-    Inlist<Item>* buckets = nullptr;
-    size_t size = 0;
+    Item* items = nullptr;
+    uint8_t* tags = nullptr;     //per slot, 0: empty, otherwise 7 bits of the key hash to skip the most of mismatches
+    uint32_t count = 0;          //number of items
+    uint32_t capacity = 0;       //number of slots, power of two
 
 private:
-    uintptr_t shuffle(uintptr_t x) const
+    uint32_t mask = 0;
+    uint32_t shift = 0;          //bits of the hash to drop for the slot index
+    uint32_t reserved;           //initial capacity
+
+    static uint32_t _capacity(uint32_t size)
+    {
+        uint32_t capacity = 8;
+        while (capacity * 3 < size * 4) capacity <<= 1;
+        return capacity;
+    }
+
+    Item* seek(uint32_t i)
     {
-        x ^= x >> (sizeof(uintptr_t) * 4);
-        x *= 0x9e3779b1u;
-        x ^= x >> (sizeof(uintptr_t) * 4);
-        return x;
+        for (; i < capacity; ++i) {
+            if (tags[i]) return &items[i];
+        }
+        return nullptr;
+    }
+
+    void rehash(uint32_t size)
+    {
+        auto oldItems = items;
+        auto oldTags = tags;
+        auto oldCapacity = capacity;
+
+        items = tvg::malloc<Item>(sizeof(Item) * size);
+        tags = tvg::calloc<uint8_t>(size, sizeof(uint8_t));
+        capacity = size;
+        mask = size - 1;
+        shift = sizeof(uintptr_t) * 8;
+        while (size > 1) {
+            size >>= 1;
+            --shift;
+        }
+
+        for (uint32_t i = 0; i < oldCapacity; ++i) {
+            if (!oldTags[i]) continue;
+            auto h = hash(oldItems[i].key);
+            auto j = slot(h);
+            while (tags[j]) j = (j + 1) & mask;
+            memcpy((void*)&items[j], (void*)&oldItems[i], sizeof(Item));
+            tags[j] = tag(h);
+        }
+
+        tvg::free(oldItems);
+        tvg::free(oldTags);
+    }
+
+    //fibonacci hashing, the upper bits of the product decide the slot
+    static uintptr_t _mix(uintptr_t x)
+    {
+        return x * uintptr_t(sizeof(uintptr_t) == 8 ? 0x9e3779b97f4a7c15ull : 0x9e3779b9u);
     }
 
     template<typename T>
     uintptr_t hash(T v) const
     {
-        return shuffle(static_cast<uintptr_t>(v)) % size;
+        return _mix(static_cast<uintptr_t>(v));
     }
 
     template<typename T>
     uintptr_t hash(T* p) const
     {
-        return shuffle(reinterpret_cast<uintptr_t>(p)) % size;
+        return _mix(reinterpret_cast<uintptr_t>(p));
+    }
+
+    uint32_t slot(uintptr_t h) const
+    {
+        return uint32_t(h >> shift);
+    }
+
+    //the next 7 bits below the slot index
+    uint8_t tag(uintptr_t h) const
+    {
+        return uint8_t(0x80 | (h >> (shift - 7)));
     }
 };
 
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "tvgTrace.h"
+
+#ifdef THORVG_TRACE_SUPPORT
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <cstdio>
+#include <cstdlib>
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+namespace tvg
+{
+
+#define TRACE_EVENTS_LIMIT (1 << 18)   //per thread, the later events are dropped
+
+struct TraceEvent
+{
+    const char* name;
+    uint64_t begin, end;
+};
+
+/* Events of a thread, only the owner thread writes on it.
+   The diagnostic memory bypasses the custom allocator not to be accounted for the engine. */
+struct TraceBuffer
+{
+    TraceEvent* events = nullptr;
+    uint32_t count = 0;
+    uint32_t reserved = 0;
+    uint32_t dropped = 0;
+    const char* name = nullptr;
+    uint32_t idx = 0;
+    uint32_t tid;
+    TraceBuffer* next = nullptr;
+
+    ~TraceBuffer()
+    {
+        std::free(events);
+    }
+
+    void push(const TraceEvent& event)
+    {
+        if (count == reserved) {
+            if (reserved == TRACE_EVENTS_LIMIT) {
+                ++dropped;
+                return;
+            }
+            reserved = reserved ? reserved * 2 : 256;
+            events = static_cast<TraceEvent*>(std::realloc(events, sizeof(TraceEvent) * reserved));
+        }
+        events[count++] = event;
+    }
+};
+
+static mutex _mtx;
+static TraceBuffer* _head = nullptr;   //the buffers in the tid order
+static TraceBuffer* _tail = nullptr;
+static atomic<uint32_t> _session{0};   //invalidates the buffers of the threads after a termination
+
+static TraceBuffer* _buffer()
+{
+    static thread_local TraceBuffer* buffer = nullptr;
+    static thread_local uint32_t session = UINT32_MAX;
+
+    if (session != _session.load(memory_order_acquire) || !buffer) {
+        lock_guard<mutex> lock(_mtx);
+        buffer = new TraceBuffer;
+        buffer->tid = _tail ? _tail->tid + 1 : 1;
+        if (_tail) _tail->next = buffer;
+        else _head = buffer;
+        _tail = buffer;
+        session = _session;
+    }
+    return buffer;
+}
+
+
+static void _write(FILE* fp)
+{
+    fprintf(fp, "{\"traceEvents\":[\n");
+    auto first = true;
+    for (auto buffer = _head; buffer; buffer = buffer->next) {
+        //the thread name metadata
+        if (buffer->name) {
+            fprintf(fp, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":\"%s", first ? "" : ",\n", buffer->tid, buffer->name);
+            if (buffer->idx > 0) fprintf(fp, " %u", buffer->idx);
+            fprintf(fp, "\"}}");
+            first = false;
+        }
+        for (auto e = buffer->events; e < buffer->events + buffer->count; ++e) {
+            fprintf(fp, "%s{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", first ? "" : ",\n", e->name, buffer->tid, double(e->begin) * 0.001, double(e->end - e->begin) * 0.001);
+            first = false;
+        }
+    }
+    fprintf(fp, "\n],\"displayTimeUnit\":\"ms\"}\n");
+}
+
+}
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+void Trace::term()
+{
+    lock_guard<mutex> lock(_mtx);
+
+    const char* path = getenv("THORVG_TRACE");
+    if (!path) path = "thorvg.trace.json";
+
+    auto events = 0, dropped = 0;
+    for (auto buffer = _head; buffer; buffer = buffer->next) {
+        events += buffer->count;
+        dropped += buffer->dropped;
+    }
+    if (dropped > 0) TVGERR("TRACE", "%d events are dropped over the limit of %d per thread", dropped, TRACE_EVENTS_LIMIT);
+
+    if (events > 0) {
+        if (auto fp = fopen(path, "w")) {
+            _write(fp);
+            fclose(fp);
+            TVGLOG("TRACE", "%d events are written in %s", events, path);
+        } else TVGERR("TRACE", "Failed to open %s", path);
+    }
+
+    while (_head) {
+        auto next = _head->next;
+        delete(_head);
+        _head = next;
+    }
+    _tail = nullptr;
+    _session.fetch_add(1, memory_order_release);
+}
+
+
+void Trace::thread(const char* name, uint32_t idx)
+{
+    auto buffer = _buffer();
+    buffer->name = name;
+    buffer->idx = idx;
+}
+
+
+uint64_t Trace::now()
+{
+    using namespace std::chrono;
+    return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+void Trace::record(const char* name, uint64_t begin)
+{
+    _buffer()->push({name, begin, now()});
+}
+
+#endif
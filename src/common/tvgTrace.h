@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_TRACE_H_
+#define _TVG_TRACE_H_
+
+#include "tvgCommon.h"
+
+#ifdef THORVG_TRACE_SUPPORT
+
+namespace tvg
+{
+
+/* Records the scoped events of the calling threads and writes them in the Chrome trace event format
+   at the termination of the engine. Set THORVG_TRACE in the environment to change the output file. */
+namespace Trace
+{
+    void term();
+    void thread(const char* name, uint32_t idx);   //names the calling thread
+    uint64_t now();                                //nano seconds
+    void record(const char* name, uint64_t begin);
+}
+
+struct TraceScope
+{
+    const char* name;
+    uint64_t begin;
+
+    TraceScope(const char* name) : name(name), begin(Trace::now()) {}
+    ~TraceScope() { Trace::record(name, begin); }
+};
+
+}
+
+    #define _TVG_TRACE_SCOPE(name, line) tvg::TraceScope _traceScope##line(name)
+    #define _TVG_TRACE_LINE(name, line) _TVG_TRACE_SCOPE(name, line)
+    #define TVGTRACE(name) _TVG_TRACE_LINE(name, __LINE__)
+    #define TVGTRACE_THREAD(name, idx) tvg::Trace::thread(name, idx)
+#else
+    #define TVGTRACE(...) do {} while(0)
+    #define TVGTRACE_THREAD(...) do {} while(0)
+#endif
+
+#endif //_TVG_TRACE_H_
@@ -61,8 +61,10 @@ Result JpgLoader::open(const char* path, const LoaderOps& ops)
 
     int width, height, subSample, colorSpace;
     if (tjDecompressHeader3(jpegDecompressor, data, size, &width, &height, &subSample, &colorSpace) < 0) return Result::InvalidArguments;
+
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    reduction = PictureOps::downscale(ops, width, height, 3);
     return Result::Success;
 #else
     return Result::NonSupport;
@@ -83,6 +85,7 @@ Result JpgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     owner = ops.owner;
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    reduction = PictureOps::downscale(ops, width, height, 3);
     this->size = size;
 
     return Result::Success;
@@ -106,19 +109,23 @@ bool JpgLoader::read()
         cs = ColorSpace::ABGR8888;
     }
 
-    if (static_cast<int>(w) > INT_MAX / static_cast<int>(h) / tjPixelSize[format]) return false;
+    //the reduced pixels, turbojpeg picks up the scaling factor (1/2, 1/4, 1/8) matching to the given size
+    auto full = extent();
+    auto width = full.sw(), height = full.sh();
+
+    if (width > INT_MAX / height / tjPixelSize[format]) return false;
 
-    auto image = (unsigned char *)tjAlloc(static_cast<int>(w) * static_cast<int>(h) * tjPixelSize[format]);
+    auto image = (unsigned char *)tjAlloc(width * height * tjPixelSize[format]);
 
     //decompress jpg image
-    if (tjDecompress2(jpegDecompressor, data, size, image, static_cast<int>(w), 0, static_cast<int>(h), format, 0) < 0) {
+    if (tjDecompress2(jpegDecompressor, data, size, image, width, 0, height, format, 0) < 0) {
         TVGERR("JPG LOADER", "%s", tjGetErrorStr());
         tjFree(image);
         image = nullptr;
         return false;
     }
 
-    surface.setup((pixel_t*)image, w, w, h, sizeof(uint32_t), cs, true);
+    surface.setup((pixel_t*)image, full.w(), full.w(), full.h(), sizeof(uint32_t), cs, true);
     clear();
     return true;
 }
@@ -20,6 +20,7 @@
  * SOFTWARE.
  */
 
+#include "tvgLoaderMgr.h"
 #include "tvgJpgLoader.h"
 
 /************************************************************************/
@@ -38,8 +39,21 @@ void JpgLoader::clear()
 
 void JpgLoader::run(unsigned tid)
 {
-    surface.setup((pixel_t*)jpgdDecompress(decoder), static_cast<uint32_t>(w), static_cast<uint32_t>(w), static_cast<uint32_t>(h), sizeof(uint32_t), ColorSpace::ABGR8888, true);
-    clear();
+    //jpg is opaque, only the channel order of the desired colorspace matters.
+    auto bgra = (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S);
+    auto cs = bgra ? ColorSpace::ARGB8888 : ColorSpace::ABGR8888;
+    if (striped) {
+        surface.setup((pixel_t*)jpgdDecompress(decoder, reduction, bgra, area.sx(), area.sy(), area.sw(), area.sh()), area.w(), area.w(), area.h(), sizeof(uint32_t), cs, true);
+    } else {
+        auto full = extent();
+        surface.setup((pixel_t*)jpgdDecompress(decoder, reduction, bgra), full.w(), full.w(), full.h(), sizeof(uint32_t), cs, true);
+    }
+
+    //keep the source data to decode the other area or the evicted pixels again, see stripe() and evict()
+    if (striped || LoaderMgr::budgeted()) {
+        jpgdDelete(decoder);
+        decoder = nullptr;
+    } else clear();
 }
 
 
@@ -62,8 +76,19 @@ Result JpgLoader::open(const char* path, const LoaderOps& ops)
 
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    reduction = PictureOps::downscale(ops, width, height, 3);  // jpgd supports the reduced IDCT up to 1/8
+    auto full = extent();
+    striped = huge(full.sw(), full.sh());
     owner = Ownership::Transfer;
 
+    //decoded again later, the source data is required
+    if (striped || LoaderMgr::budgeted()) {
+        jpgdDelete(decoder);
+        decoder = nullptr;
+        if (!(data = Loader::open(path, size))) return Result::InvalidArguments;
+        if (!(decoder = jpgdHeader(data, size, &width, &height))) return Result::InvalidArguments;
+    }
+
     return Result::Success;
 #else
     return Result::NonSupport;
@@ -79,6 +104,7 @@ Result JpgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
         this->data = (char *) data;
     }
     owner = ops.owner;
+    this->size = size;
 
     int width, height;
     decoder = jpgdHeader(this->data, size, &width, &height);
@@ -86,6 +112,9 @@ Result JpgLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
 
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    reduction = PictureOps::downscale(ops, width, height, 3);  // jpgd supports the reduced IDCT up to 1/8
+    auto full = extent();
+    striped = huge(full.sw(), full.sh());
 
     return Result::Success;
 }
@@ -94,7 +123,18 @@ bool JpgLoader::read()
 {
     if (!Loader::read()) return true;
 
-    if (!decoder || w == 0 || h == 0) return false;
+    if ((!decoder && !data) || w == 0 || h == 0) return false;
+
+    //the decoder was released with the evicted pixels
+    if (!decoder) {
+        int width, height;
+        if (!(decoder = jpgdHeader(data, size, &width, &height))) return false;
+    }
+
+    surface.cs = BitmapLoader::cs;
+
+    //the visible area is not known yet, see BitmapLoader::stripe()
+    if (striped && area.invalid()) return true;
 
     TaskScheduler::request(this);
 
@@ -115,3 +155,18 @@ RenderSurface* JpgLoader::bitmap()
     this->done();
     return BitmapLoader::bitmap();
 }
+
+
+bool JpgLoader::evictable()
+{
+    return data != nullptr;
+}
+
+
+void JpgLoader::evict()
+{
+    this->done();
+    tvg::free(surface.buf8);
+    surface.data = nullptr;
+    readied = false;
+}
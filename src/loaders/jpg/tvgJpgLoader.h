@@ -38,10 +38,13 @@ struct JpgLoader : BitmapLoader, Task
     bool close() override;
 
     RenderSurface* bitmap() override;
+    bool evictable() override;
+    void evict() override;
 
 private:
     jpeg_decoder* decoder = nullptr;
     char* data = nullptr;
+    uint32_t size = 0;
 
     void clear();
     void run(unsigned tid) override;
@@ -128,8 +128,9 @@ public:
     ~jpeg_decoder();
 
     // Call this method after constructing the object to begin decompression.
+    // The scale (0~3) reduces the output by 1/2^scale in the DCT domain, see get_scaled_width() and get_scaled_height().
     // If JPGD_SUCCESS is returned you may then call decode() on each scanline.
-    int begin_decoding();
+    int begin_decoding(int scale = 0);
     // Returns the next scan line.
     // For grayscale images, pScan_line will point to a buffer containing 8-bit pixels (get_bytes_per_pixel() will return 1).
     // Otherwise, it will always point to a buffer containing 32-bit RGBA pixels (A will always be 255, and get_bytes_per_pixel() will return 4).
@@ -137,9 +138,13 @@ public:
     // Returns JPGD_DONE if all scan lines have been returned.
     // Returns JPGD_FAILED if an error occurred. Call get_error_code() for a more info.
     int decode(const void** pScan_line);
+    // Advances a scan line without returning it, JPGD_SUCCESS if the line was skipped.
+    int skip();
     inline jpgd_status get_error_code() const { return m_error_code; }
     inline int get_width() const { return m_image_x_size; }
     inline int get_height() const { return m_image_y_size; }
+    inline int get_scaled_width() const { return (m_image_x_size + (1 << m_scale) - 1) >> m_scale; }
+    inline int get_scaled_height() const { return (m_image_y_size + (1 << m_scale) - 1) >> m_scale; }
     inline int get_num_components() const { return m_comps_in_frame; }
     inline int get_bytes_per_pixel() const { return m_dest_bytes_per_pixel; }
     inline int get_bytes_per_scan_line() const { return m_image_x_size * get_bytes_per_pixel(); }
@@ -213,6 +218,7 @@ private:
     int m_real_dest_bytes_per_scan_line;
     int m_dest_bytes_per_scan_line;               // rounded up
     int m_dest_bytes_per_pixel;                   // 4 (RGB) or 1 (Y)
+    int m_scale;                                  // output reduction by 1/2^m_scale (0~3)
     huff_tables* m_pHuff_tabs[JPGD_MAX_HUFF_TABLES];
     coeff_buf* m_dc_coeffs[JPGD_MAX_COMPONENTS];
     coeff_buf* m_ac_coeffs[JPGD_MAX_COMPONENTS];
@@ -291,6 +297,7 @@ private:
     void H1V2Convert();
     void H1V1Convert();
     void gray_convert();
+    void scaled_convert();
     void find_eoi();
     inline uint32_t get_char();
     inline uint32_t get_char(bool *pPadding_flag);
@@ -574,6 +581,49 @@ void idct(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag)
 }
 
 
+// Scaled cosine bases of the 4 and 2 point IDCTs, FIX(C(u)/2 * cos((2x+1)u*PI/2N)) in [x][u] order.
+static const int s_idct_red4[16] = { 2896, 3784, 2896, 1567, 2896, 1567, -2896, -3784, 2896, -1567, -2896, 3784, 2896, -3784, 2896, -1567 };
+static const int s_idct_red2[4] = { 2896, 2896, 2896, -2896 };
+
+
+// Reduced size IDCT: only the low frequency NxN coefficients (N = 8 >> scale) are transformed,
+// which produces the block downscaled by 1/2^scale. The result is stored at the top-left corner of the 8x8 block.
+void idct_reduced(const jpgd_block_t* pSrc_ptr, uint8_t* pDst_ptr, int block_max_zag, int scale)
+{
+    if (block_max_zag <= 1 || scale == 3) {
+        int k = ((pSrc_ptr[0] + 4) >> 3) + 128;
+        k = CLAMP(k);
+        for (int y = 0; y < (8 >> scale); y++) {
+            for (int x = 0; x < (8 >> scale); x++) pDst_ptr[y * 8 + x] = (uint8_t)k;
+        }
+        return;
+    }
+
+    const int n = 8 >> scale;
+    const int* tab = (scale == 1) ? s_idct_red4 : s_idct_red2;
+    int temp[16];
+
+    // Rows: the coefficients v, u -> temp v, x
+    for (int v = 0; v < n; v++) {
+        for (int x = 0; x < n; x++) {
+            int sum = 0;
+            for (int u = 0; u < n; u++) sum += MULTIPLY(pSrc_ptr[v * 8 + u], tab[x * n + u]);
+            temp[v * n + x] = DESCALE(sum, CONST_BITS - PASS1_BITS);
+        }
+    }
+
+    // Columns: temp v, x -> pixel y, x
+    for (int y = 0; y < n; y++) {
+        for (int x = 0; x < n; x++) {
+            int sum = 0;
+            for (int v = 0; v < n; v++) sum += MULTIPLY(temp[v * n + x], tab[y * n + v]);
+            int i = DESCALE_ZEROSHIFT(sum, CONST_BITS + PASS1_BITS);
+            pDst_ptr[y * 8 + x] = (uint8_t)CLAMP(i);
+        }
+    }
+}
+
+
 // Retrieve one character from the input stream.
 inline uint32_t jpeg_decoder::get_char()
 {
@@ -1236,6 +1286,7 @@ void jpeg_decoder::init(jpeg_decoder_stream *pStream)
     m_real_dest_bytes_per_scan_line = 0;
     m_dest_bytes_per_scan_line = 0;
     m_dest_bytes_per_pixel = 0;
+    m_scale = 0;
 
     memset(m_pHuff_tabs, 0, sizeof(m_pHuff_tabs));
 
@@ -1328,7 +1379,8 @@ void jpeg_decoder::transform_mcu(int mcu_row)
     uint8_t* pDst_ptr = m_pSample_buf + mcu_row * m_blocks_per_mcu * 64;
 
     for (int mcu_block = 0; mcu_block < m_blocks_per_mcu; mcu_block++) {
-        idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block]);
+        if (m_scale > 0) idct_reduced(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block], m_scale);
+        else idct(pSrc_ptr, pDst_ptr, m_mcu_block_max_zag[mcu_block]);
         pSrc_ptr += 64;
         pDst_ptr += 64;
     }
@@ -1700,6 +1752,41 @@ void jpeg_decoder::gray_convert()
 }
 
 
+// Any subsampling to RGB (or 8-bit grayscale) from the reduced blocks. The sampling factors decide the block layout of a MCU:
+// the luminance blocks are ordered in rows (hs x vs) and the chroma blocks follow them. Each block carries (8 >> m_scale)^2 samples.
+void jpeg_decoder::scaled_convert()
+{
+    const int bs = 8 >> m_scale;
+    const int hs = m_comp_h_samp[0];
+    const int vs = m_comp_v_samp[0];
+    const int row = bs * vs - m_mcu_lines_left;
+    uint8_t *d = m_pScan_line_0;
+    uint8_t *s = m_pSample_buf;
+
+    const int ofs = (row / bs) * hs * 64 + (row % bs) * 8;
+
+    for (int i = m_max_mcus_per_row; i > 0; i--) {
+        const uint8_t* y = s + ofs;
+        if (m_scan_type == JPGD_GRAYSCALE) {
+            for (int j = 0; j < bs; j++) *d++ = y[j];
+        } else {
+            const uint8_t* c = s + hs * vs * 64 + (row / vs) * 8;
+            for (int j = 0; j < bs * hs; j++) {
+                int yy = y[(j / bs) * 64 + (j % bs)];
+                int cb = c[j / hs];
+                int cr = c[64 + j / hs];
+                d[0] = clamp(yy + m_crr[cr]);
+                d[1] = clamp(yy + ((m_crg[cr] + m_cbg[cb]) >> 16));
+                d[2] = clamp(yy + m_cbb[cb]);
+                d[3] = 255;
+                d += 4;
+            }
+        }
+        s += m_max_blocks_per_mcu * 64;
+    }
+}
+
+
 // Find end of image (EOI) marker, so we can return to the user the exact size of the input stream.
 void jpeg_decoder::find_eoi()
 {
@@ -1719,6 +1806,24 @@ void jpeg_decoder::find_eoi()
 }
 
 
+// Advances a scan line without the color conversion.
+int jpeg_decoder::skip()
+{
+    if ((m_error_code) || (!m_ready_flag)) return JPGD_FAILED;
+    if (m_total_lines_left == 0) return JPGD_DONE;
+    if (m_mcu_lines_left == 0) {
+        if (m_progressive_flag) load_next_row();
+        else if (!decode_next_row()) return JPGD_FAILED;
+        // Find the EOI marker if that was the last row.
+        if (m_total_lines_left <= (m_max_mcu_y_size >> m_scale)) find_eoi();
+        m_mcu_lines_left = m_max_mcu_y_size >> m_scale;
+    }
+    m_mcu_lines_left--;
+    m_total_lines_left--;
+    return JPGD_SUCCESS;
+}
+
+
 int jpeg_decoder::decode(const void** pScan_line)
 {
     if ((m_error_code) || (!m_ready_flag)) return JPGD_FAILED;
@@ -1727,8 +1832,16 @@ int jpeg_decoder::decode(const void** pScan_line)
         if (m_progressive_flag) load_next_row();
         else if (!decode_next_row()) return JPGD_FAILED;
         // Find the EOI marker if that was the last row.
-        if (m_total_lines_left <= m_max_mcu_y_size) find_eoi();
-        m_mcu_lines_left = m_max_mcu_y_size;
+        if (m_total_lines_left <= (m_max_mcu_y_size >> m_scale)) find_eoi();
+        m_mcu_lines_left = m_max_mcu_y_size >> m_scale;
+    }
+
+    if (m_scale > 0) {
+        scaled_convert();
+        *pScan_line = m_pScan_line_0;
+        m_mcu_lines_left--;
+        m_total_lines_left--;
+        return JPGD_SUCCESS;
     }
 
     switch (m_scan_type) {
@@ -2041,7 +2154,7 @@ bool jpeg_decoder::init_frame()
 
     m_pSample_buf = (uint8_t *)alloc(m_max_blocks_per_row * 64);
 
-    m_total_lines_left = m_image_y_size;
+    m_total_lines_left = get_scaled_height();
     m_mcu_lines_left = 0;
     create_look_ups();
 
@@ -2334,10 +2447,11 @@ jpeg_decoder::jpeg_decoder(jpeg_decoder_stream *pStream)
 }
 
 
-int jpeg_decoder::begin_decoding()
+int jpeg_decoder::begin_decoding(int scale)
 {
     if (m_ready_flag) return JPGD_SUCCESS;
     if (m_error_code) return JPGD_FAILED;
+    m_scale = JPGD_MIN(JPGD_MAX(scale, 0), 3);
     if (!decode_start()) return JPGD_FAILED;
     m_ready_flag = true;
 
@@ -2482,29 +2596,58 @@ void jpgdDelete(jpeg_decoder* decoder)
     delete(decoder);
 }
 
-unsigned char* jpgdDecompress(jpeg_decoder* decoder)
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, int scale, bool bgra)
+{
+    if (!decoder || decoder->begin_decoding(scale) != JPGD_SUCCESS) return nullptr;
+    return jpgdDecompress(decoder, scale, bgra, 0, 0, decoder->get_scaled_width(), decoder->get_scaled_height());
+}
+
+
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, int scale, bool bgra, int x, int y, int w, int h)
 {
-    if (!decoder || decoder->begin_decoding() != JPGD_SUCCESS) return nullptr;
+    if (!decoder || decoder->begin_decoding(scale) != JPGD_SUCCESS) return nullptr;
 
     auto channel = 4; //OPTIMIZE: jpg is 3 channel format, not really need 4 channel components.
-    auto width = decoder->get_width();
-    auto height = decoder->get_height();
+    auto width = decoder->get_scaled_width();
+    auto height = decoder->get_scaled_height();
+    if (x < 0 || y < 0 || w <= 0 || h <= 0 || x + w > width || y + h > height) return nullptr;
+
     //auto actual_comps = decoder->get_num_components();
-    const auto stride = width * channel;
-    auto ret = tvg::malloc<uint8_t>(stride * height);
+    const auto stride = w * channel;
+    auto ret = tvg::malloc<uint8_t>(stride * h);
     auto dst = ret;
 
-    for (int y = 0; y < height; y++) {
+    //the lines above the area are skipped without the color conversion, from an even line not to break the paired conversions.
+    for (int line = 0; line < (y & ~1); line++) {
+        if (decoder->skip() != JPGD_SUCCESS) {
+            tvg::free(ret);
+            return nullptr;
+        }
+    }
+
+    //the lines below the area are never decoded.
+    for (int line = y & ~1; line < y + h; line++) {
         uint8_t* src = nullptr;
         if (decoder->decode((const void**)&src) != JPGD_SUCCESS) {
             tvg::free(ret);
             return nullptr;
         }
+        if (line < y) continue;
         if (decoder->get_num_components() == 3) {
-            memcpy(dst, src, stride);
+            src += x * channel;
+            //the scanline is copied out anyway, swap the channels on the way for the BGRA target.
+            if (bgra) {
+                auto in = (const uint32_t*)src;
+                auto out = (uint32_t*)dst;
+                for (int i = 0; i < w; i++) {
+                    auto p = in[i];
+                    out[i] = (p & 0xff00ff00) | ((p & 0xff) << 16) | ((p >> 16) & 0xff);
+                }
+            } else memcpy(dst, src, stride);
             dst += stride;
         } else if (decoder->get_num_components() == 1) {
-            for (int x = 0; x < width; x++, src++, dst += 4) {
+            src += x;
+            for (int i = 0; i < w; i++, src++, dst += 4) {
                 dst[0] = *src;
                 dst[1] = *src;
                 dst[2] = *src;
@@ -27,7 +27,9 @@ class jpeg_decoder;
 
 jpeg_decoder* jpgdHeader(const char* data, int size, int* width, int* height);
 jpeg_decoder* jpgdHeader(const char* filename, int* width, int* height);
-unsigned char* jpgdDecompress(jpeg_decoder* decoder);
+// scale: decode at 1/2^scale (0~3) of the image size, the output is ceil(width/2^scale) x ceil(height/2^scale)
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, int scale = 0, bool bgra = false);
+unsigned char* jpgdDecompress(jpeg_decoder* decoder, int scale, bool bgra, int x, int y, int w, int h);  //the given area only
 void jpgdDelete(jpeg_decoder* decoder);
 
 #endif //_TVG_JPGD_H_
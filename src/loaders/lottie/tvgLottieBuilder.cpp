@@ -26,6 +26,7 @@
 #include "tvgScene.h"
 #include "tvgText.h"
 #include "tvgLoader.h"
+#include "tvgTrace.h"
 #include "tvgLottieModel.h"
 #include "tvgLottieBuilder.h"
 #include "tvgLottieExpressions.h"
@@ -1156,7 +1157,7 @@ bool LottieBuilder::updateTextRange(LottieText* text, float frameNo, Shape* shap
         if (spacing > ctx.lineSpace) ctx.lineSpace = spacing;
     }
     // Apply line group transformation just once
-    if (ctx.lineScene->paints().empty() && needGroup) {
+    if (ctx.lineScene->paints(nullptr) == 0 && needGroup) {
         tvg::identity(&transform);
         translate(&transform, ctx.cursor);
 
@@ -1742,6 +1743,8 @@ bool LottieBuilder::update(LottieComposition* comp, float frameNo)
 {
     if (comp->root->children.empty()) return false;
 
+    TVGTRACE("LottieBuilder::update");
+
     comp->clamp(frameNo);
 
     if (tween.active) comp->clamp(tween.to);
@@ -1094,10 +1094,10 @@ void LottieParser::parseFontData(LottieFont* font, const char* data)
     if (!strncmp(data, "data:font/", sizeof("data:font/") - 1)) {
         data += sizeof("data:font/") - 1;
         if (!strncasecmp(data, TTF, 3)) {
-            font->mime = strdup(TTF);
+            font->mime = duplicate(TTF);
             data += 3;
         } else if (!strncasecmp(data, OTF, 3)) {
-            font->mime = strdup(OTF);
+            font->mime = duplicate(OTF);
             data += 3;
         } else {
             TVGLOG("LOTTIE", "Not support the current font type!");
@@ -60,20 +60,18 @@ private:
     void release()
     {
         // delete the fill values
-        for (size_t i = 0; i < data.size; ++i) {
-            INLIST_FOREACH(data.buckets[i], item) {
-                auto& value = item->val;
-                if (value.type == 0) {
-                    continue;
-                } else if (value.type == 1) {  // path
-                    free(value.from.vPath.pts);
-                    free(value.from.vPath.cmds);
-                    free(value.cur.vPath.pts);
-                    free(value.cur.vPath.cmds);
-                } else {  // fill
-                    delete (value.from.vFill);
-                    delete (value.cur.vFill);
-                }
+        MAP_FOREACH(data, item) {
+            auto& value = item->val;
+            if (value.type == 0) {
+                continue;
+            } else if (value.type == 1) {  // path
+                free(value.from.vPath.pts);
+                free(value.from.vPath.cmds);
+                free(value.cur.vPath.pts);
+                free(value.cur.vPath.cmds);
+            } else {  // fill
+                delete (value.from.vFill);
+                delete (value.cur.vFill);
             }
         }
         data.clear();
@@ -137,10 +135,8 @@ public:
         legacy = false;
 
         // initialize the data
-        for (size_t i = 0; i < data.size; ++i) {
-            INLIST_FOREACH(data.buckets[i], item) {
-                item->val.inited = false;
-            }
+        MAP_FOREACH(data, item) {
+            item->val.inited = false;
         }
     }
 
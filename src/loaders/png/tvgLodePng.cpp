@@ -46,6 +46,8 @@
 
 #include "tvgCommon.h"
 #include "tvgLodePng.h"
+#include "tvgLodePngAvx.h"
+#include "tvgLodePngNeon.h"
 
 
 /************************************************************************/
@@ -211,6 +213,14 @@ static unsigned lodepng_read32bitInt(const unsigned char* buffer)
 }
 
 
+/* little endian 64 bits, compilers merge this into a single load where it's possible */
+static LODEPNG_INLINE uint64_t lodepng_read64bitLE(const unsigned char* buffer)
+{
+    return ((uint64_t)buffer[0]) | ((uint64_t)buffer[1] << 8u) | ((uint64_t)buffer[2] << 16u) | ((uint64_t)buffer[3] << 24u) |
+           ((uint64_t)buffer[4] << 32u) | ((uint64_t)buffer[5] << 40u) | ((uint64_t)buffer[6] << 48u) | ((uint64_t)buffer[7] << 56u);
+}
+
+
 /* ////////////////////////////////////////////////////////////////////////// */
 /* ////////////////////////////////////////////////////////////////////////// */
 /* // End of common code and tools. Begin of Zlib related code.            // */
@@ -442,6 +452,7 @@ struct HuffmanTree
     /* for reading only */
     unsigned char* table_len; /*length of symbol from lookup table, or max length if secondary lookup needed*/
     unsigned short* table_value; /*value of symbol from lookup table, or pointer to secondary table if needed*/
+    unsigned* table_pair; /*two literals decoded at once: literal0 | literal1 << 8 | total length << 16, or 0 if not available*/
 };
 
 
@@ -451,6 +462,7 @@ static void HuffmanTree_init(HuffmanTree* tree)
     tree->lengths = 0;
     tree->table_len = 0;
     tree->table_value = 0;
+    tree->table_pair = 0;
 }
 
 
@@ -460,6 +472,7 @@ static void HuffmanTree_cleanup(HuffmanTree* tree)
     tvg::free(tree->lengths);
     tvg::free(tree->table_len);
     tvg::free(tree->table_value);
+    tvg::free(tree->table_pair);
 }
 
 
@@ -588,6 +601,36 @@ static unsigned HuffmanTree_makeTable(HuffmanTree* tree)
 }
 
 
+/* amount of bits for the literal pair lookup table, see HuffmanTree_makePairTable */
+#define PAIRBITS 11u
+
+/* make the table of the literal pairs whose codes fit together in PAIRBITS, the literal/length tree only.
+   Must be called after HuffmanTree_makeTable. */
+static unsigned HuffmanTree_makePairTable(HuffmanTree* tree)
+{
+    static const unsigned size = 1u << PAIRBITS;
+    static const unsigned mask = (1u << FIRSTBITS) - 1u;
+
+    tree->table_pair = tvg::malloc<unsigned>(size * sizeof(unsigned));
+    if (!tree->table_pair) return 83; /*alloc fail*/
+
+    for (unsigned i = 0; i < size; ++i) {
+        unsigned pair = 0;
+        unsigned l0 = tree->table_len[i & mask];
+        unsigned v0 = tree->table_value[i & mask];
+        /*the first symbol must be a literal fully decoded by the first table*/
+        if (l0 < PAIRBITS && l0 <= FIRSTBITS && v0 <= 255) {
+            /*the remaining bits are zero filled, fine as long as the second code fits in them*/
+            unsigned l1 = tree->table_len[(i >> l0) & mask];
+            unsigned v1 = tree->table_value[(i >> l0) & mask];
+            if (l1 <= FIRSTBITS && l0 + l1 <= PAIRBITS && v1 <= 255) pair = v0 | (v1 << 8u) | ((l0 + l1) << 16u);
+        }
+        tree->table_pair[i] = pair;
+    }
+    return 0;
+}
+
+
 /*
   Second step for the ...makeFromLengths and ...makeFromFrequencies functions.
   numcodes, lengths and maxbitlen must already be filled in correctly. return
@@ -853,8 +896,161 @@ static unsigned getTreeInflateDynamic(HuffmanTree* tree_ll, HuffmanTree* tree_d,
 }
 
 
+/* room for the longest match (258) and the overrun of the wide copy, see inflateHuffmanFast */
+#define INFLATE_FAST_OUTPUT_MARGIN 266u
+/* the fast path consumes up to 48 bits (15 + 5 + 15 + 13) per symbol from a single 64 bits refill */
+#define INFLATE_FAST_INPUT_MARGIN 8u
+
+/*
+  The streaming output of the inflation. The output is handed over to the sink and drained once it grows beyond
+  the threshold, only the last 32K window is kept for the backward references. consume() returns non-zero to stop
+  the inflation: an error or INFLATE_SINK_DONE if the sink doesn't need the rest of the data.
+*/
+struct InflateSink
+{
+    unsigned (*consume)(InflateSink* sink, const unsigned char* data, size_t size);
+    size_t threshold;  /*drains the output beyond this size*/
+    unsigned adler;    /*the checksum of the drained output*/
+    unsigned done;     /*the sink stopped the inflation*/
+};
+
+#define INFLATE_WINDOW 32768u
+#define INFLATE_SINK_DONE 255u
+
+static unsigned update_adler32(unsigned adler, const unsigned char* data, unsigned len);
+
+static unsigned inflateDrain(ucvector* out, InflateSink* sink, bool final)
+{
+    size_t keep = final ? 0 : INFLATE_WINDOW;
+    if (out->size <= keep) return 0;
+
+    auto size = out->size - keep;
+    sink->adler = update_adler32(sink->adler, out->data, (unsigned)size);
+    auto error = sink->consume(sink, out->data, size);
+    if (error == INFLATE_SINK_DONE) sink->done = 1;
+
+    memmove(out->data, out->data + size, keep);
+    out->size = keep;
+    return error;
+}
+
+
+/*
+  Decodes the symbols as long as the 64 bits refill and the longest match are guaranteed without the bound checks,
+  the remaining symbols are left to the careful path in inflateHuffmanBlock. The literal pairs are resolved by a single
+  lookup and the matches are copied in 8 bytes if the distance allows it. done is set when the end code is reached.
+*/
+static unsigned inflateHuffmanFast(ucvector* out, LodePNGBitReader* reader, const HuffmanTree* tree_ll, const HuffmanTree* tree_d, unsigned* done)
+{
+    static const unsigned firstmask = (1u << FIRSTBITS) - 1u;
+    static const unsigned pairmask = (1u << PAIRBITS) - 1u;
+
+    if (reader->size < INFLATE_FAST_INPUT_MARGIN || out->allocsize < INFLATE_FAST_OUTPUT_MARGIN) return 0;
+
+    const unsigned char* in = reader->data;
+    const size_t inlimit = reader->size - INFLATE_FAST_INPUT_MARGIN;
+    unsigned char* base = out->data;
+    unsigned char* o = base + out->size;
+    const unsigned char* olimit = base + out->allocsize - INFLATE_FAST_OUTPUT_MARGIN;
+    size_t bp = reader->bp;
+    unsigned error = 0;
+
+    while ((bp >> 3u) <= inlimit && o <= olimit) {
+        uint64_t bits = lodepng_read64bitLE(in + (bp >> 3u)) >> (bp & 7u);
+
+        /*two literals at once*/
+        unsigned pair = tree_ll->table_pair[bits & pairmask];
+        if (pair) {
+            o[0] = (unsigned char)pair;
+            o[1] = (unsigned char)(pair >> 8u);
+            o += 2;
+            bp += pair >> 16u;
+            continue;
+        }
+
+        /*literal, length or end code*/
+        unsigned index = (unsigned)bits & firstmask;
+        unsigned l = tree_ll->table_len[index];
+        unsigned code_ll = tree_ll->table_value[index];
+        if (l > FIRSTBITS) {
+            index = code_ll + (((unsigned)bits >> FIRSTBITS) & ((1u << (l - FIRSTBITS)) - 1u));
+            l = tree_ll->table_len[index];
+            code_ll = tree_ll->table_value[index];
+        }
+        bits >>= l;
+        bp += l;
+
+        if (code_ll <= 255) {
+            *o++ = (unsigned char)code_ll;
+            continue;
+        }
+        if (code_ll == 256) {
+            *done = 1;
+            break;
+        }
+        if (code_ll > LAST_LENGTH_CODE_INDEX) {
+            error = 16; /*error: tried to read disallowed huffman symbol*/
+            break;
+        }
+
+        /*length*/
+        size_t length = LENGTHBASE[code_ll - FIRST_LENGTH_CODE_INDEX];
+        unsigned numextrabits = LENGTHEXTRA[code_ll - FIRST_LENGTH_CODE_INDEX];
+        length += (unsigned)bits & ((1u << numextrabits) - 1u);
+        bits >>= numextrabits;
+        bp += numextrabits;
+
+        /*distance*/
+        index = (unsigned)bits & firstmask;
+        l = tree_d->table_len[index];
+        unsigned code_d = tree_d->table_value[index];
+        if (l > FIRSTBITS) {
+            index = code_d + (((unsigned)bits >> FIRSTBITS) & ((1u << (l - FIRSTBITS)) - 1u));
+            l = tree_d->table_len[index];
+            code_d = tree_d->table_value[index];
+        }
+        bits >>= l;
+        bp += l;
+
+        if (code_d > 29) {
+            error = (code_d <= 31) ? 18 : 16; /*error: invalid distance code (30-31 are never used) or disallowed huffman symbol*/
+            break;
+        }
+        size_t distance = DISTANCEBASE[code_d];
+        numextrabits = DISTANCEEXTRA[code_d];
+        distance += (unsigned)bits & ((1u << numextrabits) - 1u);
+        bp += numextrabits;
+
+        if (distance > (size_t)(o - base)) {
+            error = 52; /*too long backward distance*/
+            break;
+        }
+
+        /*copy the match, the wide copy may overrun the length up to 7 bytes (see INFLATE_FAST_OUTPUT_MARGIN)*/
+        const unsigned char* src = o - distance;
+        unsigned char* end = o + length;
+        if (distance >= 8) {
+            do {
+                memcpy(o, src, 8);
+                o += 8;
+                src += 8;
+            } while (o < end);
+        } else if (distance == 1) {
+            memset(o, *src, length);
+        } else {
+            while (o < end) *o++ = *src++;
+        }
+        o = end;
+    }
+
+    reader->bp = bp;
+    out->size = o - base;
+    return error;
+}
+
+
 /*inflate a block with dynamic of fixed Huffman tree. btype must be 1 or 2.*/
-static unsigned inflateHuffmanBlock(ucvector* out, LodePNGBitReader* reader, unsigned btype)
+static unsigned inflateHuffmanBlock(ucvector* out, LodePNGBitReader* reader, unsigned btype, InflateSink* sink)
 {
     unsigned error = 0;
     HuffmanTree tree_ll; /*the huffman tree for literal and length codes*/
@@ -866,9 +1062,15 @@ static unsigned inflateHuffmanBlock(ucvector* out, LodePNGBitReader* reader, uns
     if (btype == 1) error = getTreeInflateFixed(&tree_ll, &tree_d);
     else /*if(btype == 2)*/ error = getTreeInflateDynamic(&tree_ll, &tree_d, reader);
 
+    if (!error) error = HuffmanTree_makePairTable(&tree_ll);
+
     while (!error) /*decode all symbols until end reached, breaks at end code*/ {
         /*code_ll is literal, length or end code*/
-        unsigned code_ll;
+        unsigned code_ll, done = 0;
+        if (sink && out->size >= sink->threshold && (error = inflateDrain(out, sink, false))) break;
+        error = inflateHuffmanFast(out, reader, &tree_ll, &tree_d, &done);
+        if (error || done) break;
+
         ensureBits25(reader, 20); /* up to 15 for the huffman symbol, up to 5 for the length extra bits */
         code_ll = huffmanDecodeSymbol(reader, &tree_ll);
         if (code_ll <= 255) /*literal symbol*/ {
@@ -978,7 +1180,7 @@ static unsigned inflateNoCompression(ucvector* out, LodePNGBitReader* reader, co
 }
 
 
-static unsigned lodepng_inflatev(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings)
+static unsigned lodepng_inflatev(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings, InflateSink* sink)
 {
     unsigned BFINAL = 0;
     LodePNGBitReader reader;
@@ -994,8 +1196,9 @@ static unsigned lodepng_inflatev(ucvector* out, const unsigned char* in, size_t
 
         if (BTYPE == 3) return 20; /*error: invalid BTYPE*/
         else if (BTYPE == 0) error = inflateNoCompression(out, &reader, settings); /*no compression*/
-        else error = inflateHuffmanBlock(out, &reader, BTYPE); /*compression, BTYPE 01 or 10*/
+        else error = inflateHuffmanBlock(out, &reader, BTYPE, sink); /*compression, BTYPE 01 or 10*/
 
+        if (!error && sink) error = inflateDrain(out, sink, BFINAL);
         if (error) return error;
     }
 
@@ -1003,14 +1206,14 @@ static unsigned lodepng_inflatev(ucvector* out, const unsigned char* in, size_t
 }
 
 
-static unsigned inflatev(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings)
+static unsigned inflatev(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings, InflateSink* sink)
 {
-    if (settings->custom_inflate) {
+    if (settings->custom_inflate && !sink) {
         unsigned error = settings->custom_inflate(&out->data, &out->size, in, insize, settings);
         out->allocsize = out->size;
         return error;
     } else {
-        return lodepng_inflatev(out, in, insize, settings);
+        return lodepng_inflatev(out, in, insize, settings, sink);
     }
 }
 
@@ -1050,7 +1253,7 @@ static unsigned adler32(const unsigned char* data, unsigned len)
 /* / Zlib                                                                   / */
 /* ////////////////////////////////////////////////////////////////////////// */
 
-static unsigned lodepng_zlib_decompressv(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings)
+static unsigned lodepng_zlib_decompressv(ucvector* out, const unsigned char* in, size_t insize, const LodePNGDecompressSettings* settings, InflateSink* sink = nullptr)
 {
     unsigned error = 0;
     unsigned CM, CINFO, FDICT;
@@ -1078,12 +1281,13 @@ static unsigned lodepng_zlib_decompressv(ucvector* out, const unsigned char* in,
         return 26;
     }
 
-    error = inflatev(out, in + 2, insize - 2, settings);
+    error = inflatev(out, in + 2, insize - 2, settings, sink);
+    if (sink && sink->done) return 0; /*stopped before the end, nothing to verify*/
     if (error) return error;
 
     if (!settings->ignore_adler32) {
         unsigned ADLER32 = lodepng_read32bitInt(&in[insize - 4]);
-        unsigned checksum = adler32(out->data, (unsigned)(out->size));
+        unsigned checksum = sink ? sink->adler : adler32(out->data, (unsigned)(out->size));
         if(checksum != ADLER32) return 58; /*error, adler checksum not correct, data must be corrupted*/
     }
 
@@ -1737,6 +1941,15 @@ static void getPixelColorRGBA8(unsigned char* r, unsigned char* g, unsigned char
 }
 
 
+/* whether the RGBA 8 bits output is finished while decoding, the ICC profile conversion requires the straight colors */
+static bool lodepng_finishing(const LodePNGState* state)
+{
+    if (!state->decoder.premultiply && !state->decoder.swap_rb) return false;
+    if (!state->decoder.color_convert || state->info_png.iccp_defined) return false;
+    return state->info_raw.colortype == LCT_RGBA && state->info_raw.bitdepth == 8;
+}
+
+
 /* Similar to getPixelColorRGBA8, but with all the for loops inside of the color
    mode test cases, optimized to convert the colors much faster, when converting
    to the common case of RGBA with 8 bit per channel. buffer must be RGBA with
@@ -1948,7 +2161,7 @@ static void getPixelColorRGBA16(unsigned short* r, unsigned short* g, unsigned s
   For 16-bit per channel colors, uses big endian format like PNG does.
   Return value is LodePNG error code
 */
-static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, const LodePNGColorMode* mode_out, const LodePNGColorMode* mode_in, unsigned w, unsigned h)
+static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, const LodePNGColorMode* mode_out, const LodePNGColorMode* mode_in, unsigned w, unsigned h, const LodePNGDecoderSettings* finish)
 {
     size_t i;
     ColorTree tree;
@@ -2001,7 +2214,17 @@ static unsigned lodepng_convert(unsigned char* out, const unsigned char* in, con
                 rgba16ToPixel(out, i, mode_out, r, g, b, a);
             }
         } else if (mode_out->bitdepth == 8 && mode_out->colortype == LCT_RGBA) {
-            getPixelColorsRGBA8(out, numpixels, in, mode_in);
+            if (finish) {
+                /* finish the converted pixels by chunks while they are in the cache,
+                   the chunk size keeps the input of the smaller bitdepths byte aligned */
+                const size_t chunk = 2048;
+                size_t bpp = lodepng_get_bpp_lct(mode_in->colortype, mode_in->bitdepth);
+                for (i = 0; i < numpixels; i += chunk) {
+                    size_t num = (numpixels - i < chunk) ? (numpixels - i) : chunk;
+                    getPixelColorsRGBA8(out + i * 4, num, in + i * bpp / 8, mode_in);
+                    lodepng_finish(out + i * 4, num, finish);
+                }
+            } else getPixelColorsRGBA8(out, numpixels, in, mode_in);
         } else if(mode_out->bitdepth == 8 && mode_out->colortype == LCT_RGB) {
             getPixelColorsRGB8(out, numpixels, in, mode_in);
         } else {
@@ -2095,6 +2318,12 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
        the incoming scanlines do NOT include the filtertype byte, that one is given in the parameter filterType instead
        recon and scanline MAY be the same memory address! precon must be disjoint. */
 
+#if defined(THORVG_AVX_VECTOR_SUPPORT)
+    if (avxUnfilterScanline(recon, scanline, precon, bytewidth, filterType, length)) return 0;
+#elif defined(THORVG_NEON_VECTOR_SUPPORT)
+    if (neonUnfilterScanline(recon, scanline, precon, bytewidth, filterType, length)) return 0;
+#endif
+
     size_t i;
     switch (filterType) {
         case 0:
@@ -2182,13 +2411,15 @@ static unsigned unfilterScanline(unsigned char* recon, const unsigned char* scan
 }
 
 
-static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w, unsigned h, unsigned bpp)
+static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w, unsigned h, unsigned bpp, const LodePNGDecoderSettings* finish = nullptr)
 {
     /* For PNG filter method 0
        this function unfilters a single image (e.g. without interlacing this is called once, with Adam7 seven times)
        out must have enough bytes allocated already, in must have the scanlines + 1 filtertype byte per scanline
        w and h are image dimensions or dimensions of reduced image, bpp is bits per pixel
-       in and out are allowed to be the same memory address (but aren't the same size since in has the extra filter bytes) */
+       in and out are allowed to be the same memory address (but aren't the same size since in has the extra filter bytes)
+       if finish is given, out is the RGBA 8 bits final image and each scanline is finished once the next one
+       doesn't need it for the prediction anymore */
 
     unsigned y;
     unsigned char* prevline = 0;
@@ -2203,8 +2434,10 @@ static unsigned unfilter(unsigned char* out, const unsigned char* in, unsigned w
         size_t inindex = (1 + linebytes) * y; /* the extra filterbyte added to each row */
         unsigned char filterType = in[inindex];
         CERROR_TRY_RETURN(unfilterScanline(&out[outindex], &in[inindex + 1], prevline, bytewidth, filterType, linebytes));
+        if (finish && prevline) lodepng_finish(prevline, w, finish);
         prevline = &out[outindex];
     }
+    if (finish && prevline) lodepng_finish(prevline, w, finish);
 
     return 0;
 }
@@ -2285,7 +2518,7 @@ static void removePaddingBits(unsigned char* out, const unsigned char* in, size_
 /* out must be buffer big enough to contain full image, and in must contain the full decompressed data from
    the IDAT chunks (with filter index bytes and possible padding bits)
    return value is error */
-static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsigned w, unsigned h, const LodePNGInfo* info_png)
+static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsigned w, unsigned h, const LodePNGInfo* info_png, const LodePNGDecoderSettings* finish)
 {
     /* This function converts the filtered-padded-interlaced data into pure 2D image buffer with the PNG's colortype.
        Steps:
@@ -2301,7 +2534,7 @@ static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsi
             removePaddingBits(out, in, w * bpp, ((w * bpp + 7u) / 8u) * 8u, h);
         }
         /* we can immediately filter into the out buffer, no other steps needed */
-        else CERROR_TRY_RETURN(unfilter(out, in, w, h, bpp));
+        else CERROR_TRY_RETURN(unfilter(out, in, w, h, bpp, finish));
     } else /* interlace_method is 1 (Adam7) */ {
         unsigned passw[7], passh[7]; size_t filter_passstart[8], padded_passstart[8], passstart[8];
         unsigned i;
@@ -2319,6 +2552,7 @@ static unsigned postProcessScanlines(unsigned char* out, unsigned char* in, unsi
             }
         }
         Adam7_deinterlace(out, in, w, h, bpp);
+        if (finish) lodepng_finish(out, (size_t)w * h, finish);
     }
     return 0;
 }
@@ -2412,31 +2646,19 @@ static unsigned readChunk_iCCP(LodePNGInfo* info, const LodePNGDecompressSetting
     return error;
 }
 
-/* read a PNG, the result will be in the same color type as the PNG (hence "generic") */
-static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNGState* state, const unsigned char* in, size_t insize)
+/* collect the compressed data of the IDAT chunks, the other chunks are read into the state. returns null on error */
+static unsigned char* readChunks(LodePNGState* state, const unsigned char* in, size_t insize, size_t* idatsize)
 {
     unsigned char IEND = 0;
     const unsigned char* chunk;
     unsigned char* idat; /*the data from idat chunks, zlib compressed*/
-    size_t idatsize = 0;
-    unsigned char* scanlines = 0;
-    size_t scanlines_size = 0, expected_size = 0;
-    size_t outsize = 0;
-
-    /* safe output values in case error happens */
-    *out = 0;
-    *w = *h = 0;
-
-    state->error = lodepng_inspect(w, h, state, in, insize); /*reads header and resets other parameters in state->info_png*/
-    if (state->error) return;
-
-    if (lodepng_pixel_overflow(*w, *h, &state->info_png.color, &state->info_raw)) {
-        CERROR_RETURN(state->error, 92); /*overflow possible due to amount of pixels*/
-    }
 
     /*the input filesize is a safe upper bound for the sum of idat chunks size*/
     idat = tvg::malloc<unsigned char>(insize);
-    if (!idat) CERROR_RETURN(state->error, 83); /*alloc fail*/
+    if (!idat) {
+        state->error = 83; /*alloc fail*/
+        return nullptr;
+    }
 
     chunk = &in[33]; /*first byte of the first chunk after the header*/
 
@@ -2472,10 +2694,10 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNG
         /*IDAT chunk, containing compressed image data*/
         if (lodepng_chunk_type_equals(chunk, "IDAT")) {
             size_t newsize;
-            if (lodepng_addofl(idatsize, chunkLength, &newsize)) CERROR_BREAK(state->error, 95);
+            if (lodepng_addofl(*idatsize, chunkLength, &newsize)) CERROR_BREAK(state->error, 95);
             if (newsize > insize) CERROR_BREAK(state->error, 95);
-            lodepng_memcpy(idat + idatsize, data, chunkLength);
-            idatsize += chunkLength;
+            lodepng_memcpy(idat + *idatsize, data, chunkLength);
+            *idatsize += chunkLength;
         } else if (lodepng_chunk_type_equals(chunk, "IEND")) {
             /*IEND chunk*/
             IEND = 1;
@@ -2512,6 +2734,37 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNG
         state->error = 106; /* error: PNG file must have PLTE chunk if color type is palette */
     }
 
+    if (state->error) {
+        tvg::free(idat);
+        return nullptr;
+    }
+    return idat;
+}
+
+
+/* read a PNG, the result will be in the same color type as the PNG (hence "generic") */
+static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNGState* state, const unsigned char* in, size_t insize)
+{
+    unsigned char* idat; /*the data from idat chunks, zlib compressed*/
+    size_t idatsize = 0;
+    unsigned char* scanlines = 0;
+    size_t scanlines_size = 0, expected_size = 0;
+    size_t outsize = 0;
+
+    /* safe output values in case error happens */
+    *out = 0;
+    *w = *h = 0;
+
+    state->error = lodepng_inspect(w, h, state, in, insize); /*reads header and resets other parameters in state->info_png*/
+    if (state->error) return;
+
+    if (lodepng_pixel_overflow(*w, *h, &state->info_png.color, &state->info_raw)) {
+        CERROR_RETURN(state->error, 92); /*overflow possible due to amount of pixels*/
+    }
+
+    idat = readChunks(state, in, insize, &idatsize);
+    if (!idat) return;
+
     if (!state->error) {
         /*predict output size, to allocate exact size for output buffer to avoid more dynamic allocation.
         If the decompressed size does not match the prediction, the image must be corrupt.*/
@@ -2542,19 +2795,150 @@ static void decodeGeneric(unsigned char** out, unsigned* w, unsigned* h, LodePNG
         if (!*out) state->error = 83; /*alloc fail*/
     }
     if (!state->error) {
-        lodepng_memset(*out, 0, outsize);
-        state->error = postProcessScanlines(*out, scanlines, *w, *h, &state->info_png);
+        /* the final pixels are emitted here if no color conversion follows, see lodepng_decode() */
+        const LodePNGDecoderSettings* finish = nullptr;
+        if (lodepng_finishing(state) && lodepng_color_mode_equal(&state->info_raw, &state->info_png.color)) finish = &state->decoder;
+        /* only the smaller bitdepths rely on the zero filled output */
+        if (lodepng_get_bpp_lct(state->info_png.color.colortype, state->info_png.color.bitdepth) < 8) lodepng_memset(*out, 0, outsize);
+        state->error = postProcessScanlines(*out, scanlines, *w, *h, &state->info_png, finish);
     }
     tvg::free(scanlines);
 }
 
 
+/* the rows of the inflated stream are unfiltered one by one, only the requested area is converted and kept */
+struct AreaSink
+{
+    InflateSink sink;
+    const LodePNGState* state;
+    const LodePNGDecoderSettings* finish;
+    unsigned char* out;       /*the area pixels in the raw color mode*/
+    unsigned char* line;      /*the filtered line being assembled, the filter type byte first*/
+    unsigned char* recon[2];  /*the current and the previous unfiltered lines*/
+    unsigned char* pixels;    /*the whole line in the raw color mode, for the packed pixels of the smaller bitdepths*/
+    size_t filled, linebytes, bytewidth;
+    unsigned w, x, y, aw, ah, bpp;
+    unsigned row;             /*the index of the line being assembled*/
+};
+
+
+static unsigned consumeArea(InflateSink* sink, const unsigned char* data, size_t size)
+{
+    auto area = (AreaSink*)sink;
+    auto state = area->state;
+    auto outbytes = lodepng_get_bpp_lct(state->info_raw.colortype, state->info_raw.bitdepth) / 8u;
+
+    while (size > 0) {
+        auto n = area->linebytes + 1 - area->filled;
+        if (n > size) n = size;
+        lodepng_memcpy(area->line + area->filled, data, n);
+        area->filled += n;
+        data += n;
+        size -= n;
+        if (area->filled <= area->linebytes) break;
+        area->filled = 0;
+
+        auto recon = area->recon[area->row & 1];
+        auto precon = area->row > 0 ? area->recon[(area->row - 1) & 1] : nullptr;
+        CERROR_TRY_RETURN(unfilterScanline(recon, area->line + 1, precon, area->bytewidth, area->line[0], area->linebytes));
+
+        /*the lines above the area are needed only for the prediction*/
+        if (area->row >= area->y) {
+            auto dst = area->out + (size_t)(area->row - area->y) * area->aw * outbytes;
+            if (area->bpp >= 8) {
+                CERROR_TRY_RETURN(lodepng_convert(dst, recon + (size_t)area->x * area->bytewidth, &state->info_raw, &state->info_png.color, area->aw, 1, area->finish));
+            } else {
+                CERROR_TRY_RETURN(lodepng_convert(area->pixels, recon, &state->info_raw, &state->info_png.color, area->w, 1, area->finish));
+                lodepng_memcpy(dst, area->pixels + (size_t)area->x * outbytes, (size_t)area->aw * outbytes);
+            }
+            /*the same color modes are copied as they are*/
+            if (area->finish && lodepng_color_mode_equal(&state->info_raw, &state->info_png.color)) lodepng_finish(dst, area->aw, area->finish);
+        }
+        if (++area->row == area->y + area->ah) return INFLATE_SINK_DONE;
+    }
+    return 0;
+}
+
+
+/* decode only the given area of the non-interlaced image, the rows below it are never inflated. */
+static void decodeArea(unsigned char** out, unsigned x, unsigned y, unsigned w, unsigned h, LodePNGState* state, const unsigned char* in, size_t insize)
+{
+    unsigned width, height;
+    size_t idatsize = 0;
+
+    *out = 0;
+
+    state->error = lodepng_inspect(&width, &height, state, in, insize);
+    if (state->error) return;
+
+    if (state->info_png.interlace_method != 0) CERROR_RETURN(state->error, 120); /*the interlaced rows can't be streamed*/
+    if (w == 0 || h == 0 || x + w > width || y + h > height) CERROR_RETURN(state->error, 121); /*invalid area*/
+    if (lodepng_pixel_overflow(w, h, &state->info_png.color, &state->info_raw)) CERROR_RETURN(state->error, 92);
+
+    auto idat = readChunks(state, in, insize, &idatsize);
+    if (!idat) return;
+
+    AreaSink area;
+    area.state = state;
+    area.finish = lodepng_finishing(state) ? &state->decoder : nullptr;
+    area.bpp = lodepng_get_bpp_lct(state->info_png.color.colortype, state->info_png.color.bitdepth);
+    area.bytewidth = (area.bpp + 7u) / 8u;
+    area.linebytes = lodepng_get_raw_size_idat(width, 1, area.bpp) - 1u;
+    area.filled = 0;
+    area.w = width;
+    area.x = x;
+    area.y = y;
+    area.aw = w;
+    area.ah = h;
+    area.row = 0;
+
+    /*the filtered line, two unfiltered lines and the whole converted line for the packed pixels*/
+    auto linesize = area.linebytes + 1;
+    auto pixelsize = area.bpp < 8 ? lodepng_get_raw_size(width, 1, &state->info_raw) : 0;
+    auto lines = tvg::malloc<unsigned char>(linesize * 3 + pixelsize);
+    *out = tvg::malloc<unsigned char>(lodepng_get_raw_size(w, h, &state->info_raw));
+
+    if (!lines || !*out) state->error = 83; /*alloc fail*/
+    else {
+        area.out = *out;
+        area.line = lines;
+        area.recon[0] = lines + linesize;
+        area.recon[1] = lines + linesize * 2;
+        area.pixels = lines + linesize * 3;
+
+        area.sink.consume = consumeArea;
+        area.sink.threshold = INFLATE_WINDOW * 8;
+        area.sink.adler = 1u;
+        area.sink.done = 0;
+
+        /*the output keeps the 32K window only and the fast path margin*/
+        ucvector v = ucvector_init(nullptr, 0);
+        if (!ucvector_resize(&v, area.sink.threshold + INFLATE_FAST_OUTPUT_MARGIN * 2)) state->error = 83; /*alloc fail*/
+        else {
+            v.size = 0;
+            state->error = lodepng_zlib_decompressv(&v, idat, idatsize, &state->decoder.zlibsettings, &area.sink);
+            if (!state->error && !area.sink.done) state->error = 91; /*decompressed size doesn't match prediction*/
+        }
+        tvg::free(v.data);
+    }
+
+    tvg::free(lines);
+    tvg::free(idat);
+    if (state->error) {
+        tvg::free(*out);
+        *out = 0;
+    }
+}
+
+
 static void lodepng_decoder_settings_init(LodePNGDecoderSettings* settings)
 {
     settings->color_convert = 1;
     settings->ignore_crc = 0;
     settings->ignore_critical = 0;
     settings->ignore_end = 0;
+    settings->premultiply = 0;
+    settings->swap_rb = 0;
     lodepng_decompress_settings_init(&settings->zlibsettings);
 }
 
@@ -2657,13 +3041,44 @@ unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h, LodePNGSt
         if (!(*out)) {
             state->error = 83; /*alloc fail*/
         }
-        else state->error = lodepng_convert(*out, data, &state->info_raw, &state->info_png.color, *w, *h);
+        else state->error = lodepng_convert(*out, data, &state->info_raw, &state->info_png.color, *w, *h, lodepng_finishing(state) ? &state->decoder : nullptr);
         tvg::free(data);
     }
     return state->error;
 }
 
 
+unsigned lodepng_decode_area(unsigned char** out, unsigned x, unsigned y, unsigned w, unsigned h, LodePNGState* state, const unsigned char* in, size_t insize)
+{
+    if (!state->decoder.color_convert || !(state->info_raw.colortype == LCT_RGB || state->info_raw.colortype == LCT_RGBA) || state->info_raw.bitdepth != 8) {
+        return 56; /*unsupported color mode conversion*/
+    }
+    decodeArea(out, x, y, w, h, state, in, insize);
+    return state->error;
+}
+
+
+/* swap the red/blue channels and/or premultiply the RGBA 8 bits pixels in place as the settings request.
+   the same math with the renderer's premultiplication: the truncated product and the opaque pixels untouched. */
+void lodepng_finish(unsigned char* buffer, size_t numpixels, const LodePNGDecoderSettings* settings)
+{
+    auto swap = settings->swap_rb;
+    auto premultiply = settings->premultiply;
+
+    for (size_t i = 0; i != numpixels; ++i, buffer += 4) {
+        unsigned r = buffer[0], g = buffer[1], b = buffer[2], a = buffer[3];
+        if (premultiply && a != 255) {
+            r = (r * a) >> 8;
+            g = (g * a) >> 8;
+            b = (b * a) >> 8;
+        }
+        buffer[0] = swap ? b : r;
+        buffer[1] = g;
+        buffer[2] = swap ? r : b;
+    }
+}
+
+
 void lodepng_state_init(LodePNGState* state)
 {
     lodepng_decoder_settings_init(&state->decoder);
@@ -197,6 +197,11 @@ struct LodePNGDecoderSettings
        in string keys, etc... */
 
     unsigned color_convert; /*whether to convert the PNG to the color type you want. Default: yes*/
+
+    /* the final pixel format of the RGBA 8 bits output, applied while decoding. Ignored for the other color types
+       and skipped if an ICC profile is defined, see lodepng_finish(). Default: no */
+    unsigned premultiply; /*premultiply the color channels by the alpha*/
+    unsigned swap_rb; /*swap the red and blue channels (BGRA)*/
 };
 
 /*The settings, state and information for extended encoding and decoding.*/
@@ -211,7 +216,10 @@ struct LodePNGState
 void lodepng_state_init(LodePNGState* state);
 void lodepng_state_cleanup(LodePNGState* state);
 unsigned lodepng_decode(unsigned char** out, unsigned* w, unsigned* h, LodePNGState* state, const unsigned char* in, size_t insize);
+/*decodes only the area (x, y, w, h) of the non-interlaced image, the rows below the area are not inflated. info_raw must be 8 bits RGB(A)*/
+unsigned lodepng_decode_area(unsigned char** out, unsigned x, unsigned y, unsigned w, unsigned h, LodePNGState* state, const unsigned char* in, size_t insize);
 unsigned lodepng_inspect(unsigned* w, unsigned* h, LodePNGState* state, const unsigned char* in, size_t insize);
+void lodepng_finish(unsigned char* buffer, size_t numpixels, const LodePNGDecoderSettings* settings);
 unsigned lodepng_toSrgb(unsigned char* out, const unsigned char* in, unsigned w, unsigned h, const LodePNGState* state);
 
 #endif //_TVG_LODEPNG_H_
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef THORVG_AVX_VECTOR_SUPPORT
+
+#include <immintrin.h>
+
+/* The pixels are loaded/stored one by one through the integer registers since the rows are tightly packed.
+   Each pixel is read before the previous one is written back, so recon and scanline may alias as in unfilterScanline() */
+
+static inline __m128i _avxLoad(const unsigned char* p, size_t bytewidth)
+{
+    int32_t v = 0;
+    //a 3 bytes copy through the memory stalls the store forwarding, assemble it in the register instead
+    if (bytewidth == 4) memcpy(&v, p, 4);
+    else {
+        uint16_t lo;
+        memcpy(&lo, p, 2);
+        v = lo | (p[2] << 16);
+    }
+    return _mm_cvtsi32_si128(v);
+}
+
+
+static inline void _avxStore(unsigned char* p, __m128i v, size_t bytewidth)
+{
+    auto t = _mm_cvtsi128_si32(v);
+    if (bytewidth == 4) memcpy(p, &t, 4);
+    else {
+        auto lo = (uint16_t)t;
+        memcpy(p, &lo, 2);
+        p[2] = (unsigned char)(t >> 16);
+    }
+}
+
+
+static void avxUnfilterSub(unsigned char* recon, const unsigned char* scanline, size_t bytewidth, size_t length)
+{
+    auto a = _mm_setzero_si128();
+    for (size_t i = 0; i < length; i += bytewidth) {
+        a = _mm_add_epi8(a, _avxLoad(scanline + i, bytewidth));
+        _avxStore(recon + i, a, bytewidth);
+    }
+}
+
+
+static void avxUnfilterUp(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        auto x = _mm_loadu_si128((const __m128i*)(scanline + i));
+        auto b = _mm_loadu_si128((const __m128i*)(precon + i));
+        _mm_storeu_si128((__m128i*)(recon + i), _mm_add_epi8(x, b));
+    }
+    for (; i < length; ++i) recon[i] = scanline[i] + precon[i];
+}
+
+
+static void avxUnfilterAvg(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, size_t length)
+{
+    auto one = _mm_set1_epi8(1);
+    auto a = _mm_setzero_si128();
+    for (size_t i = 0; i < length; i += bytewidth) {
+        auto b = _avxLoad(precon + i, bytewidth);
+        //(a + b) >> 1: the rounding up of _mm_avg_epu8() is removed by the lowest bit of (a ^ b)
+        auto avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+        a = _mm_add_epi8(_avxLoad(scanline + i, bytewidth), avg);
+        _avxStore(recon + i, a, bytewidth);
+    }
+}
+
+
+static void avxUnfilterPaeth(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, size_t length)
+{
+    auto zero = _mm_setzero_si128();
+    auto mask = _mm_set1_epi16(0x00ff);
+    auto a = zero;
+    auto c = zero;
+    for (size_t i = 0; i < length; i += bytewidth) {
+        //16 bits lanes for the signed differences
+        auto b = _mm_unpacklo_epi8(_avxLoad(precon + i, bytewidth), zero);
+        auto x = _mm_unpacklo_epi8(_avxLoad(scanline + i, bytewidth), zero);
+        auto pa = _mm_sub_epi16(b, c);
+        auto pb = _mm_sub_epi16(a, c);
+        auto pc = _mm_abs_epi16(_mm_add_epi16(pa, pb));
+        pa = _mm_abs_epi16(pa);
+        pb = _mm_abs_epi16(pb);
+        auto smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+        //a has the priority over b, b over c
+        auto p = _mm_blendv_epi8(c, b, _mm_cmpeq_epi16(smallest, pb));
+        p = _mm_blendv_epi8(p, a, _mm_cmpeq_epi16(smallest, pa));
+        a = _mm_and_si128(_mm_add_epi16(x, p), mask);
+        _avxStore(recon + i, _mm_packus_epi16(a, a), bytewidth);
+        c = b;
+    }
+}
+
+
+static bool avxUnfilterScanline(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, unsigned char filterType, size_t length)
+{
+    if (bytewidth != 3 && bytewidth != 4) return false;
+
+    switch (filterType) {
+        case 1: avxUnfilterSub(recon, scanline, bytewidth, length); return true;
+        case 2: if (!precon) return false; avxUnfilterUp(recon, scanline, precon, length); return true;
+        case 3: if (!precon) return false; avxUnfilterAvg(recon, scanline, precon, bytewidth, length); return true;
+        case 4: if (!precon) return false; avxUnfilterPaeth(recon, scanline, precon, bytewidth, length); return true;
+        default: return false;
+    }
+}
+
+#endif
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifdef THORVG_NEON_VECTOR_SUPPORT
+
+#include <arm_neon.h>
+
+/* The pixels are loaded/stored one by one through the integer registers since the rows are tightly packed.
+   Each pixel is read before the previous one is written back, so recon and scanline may alias as in unfilterScanline() */
+
+static inline uint8x8_t _neonLoad(const unsigned char* p, size_t bytewidth)
+{
+    uint32_t v = 0;
+    //a 3 bytes copy through the memory stalls the store forwarding, assemble it in the register instead
+    if (bytewidth == 4) memcpy(&v, p, 4);
+    else {
+        uint16_t lo;
+        memcpy(&lo, p, 2);
+        v = lo | (p[2] << 16);
+    }
+    return vreinterpret_u8_u32(vdup_n_u32(v));
+}
+
+
+static inline void _neonStore(unsigned char* p, uint8x8_t v, size_t bytewidth)
+{
+    auto t = vget_lane_u32(vreinterpret_u32_u8(v), 0);
+    if (bytewidth == 4) memcpy(p, &t, 4);
+    else {
+        auto lo = (uint16_t)t;
+        memcpy(p, &lo, 2);
+        p[2] = (unsigned char)(t >> 16);
+    }
+}
+
+
+static void neonUnfilterSub(unsigned char* recon, const unsigned char* scanline, size_t bytewidth, size_t length)
+{
+    auto a = vdup_n_u8(0);
+    for (size_t i = 0; i < length; i += bytewidth) {
+        a = vadd_u8(a, _neonLoad(scanline + i, bytewidth));
+        _neonStore(recon + i, a, bytewidth);
+    }
+}
+
+
+static void neonUnfilterUp(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t length)
+{
+    size_t i = 0;
+    for (; i + 16 <= length; i += 16) {
+        vst1q_u8(recon + i, vaddq_u8(vld1q_u8(scanline + i), vld1q_u8(precon + i)));
+    }
+    for (; i < length; ++i) recon[i] = scanline[i] + precon[i];
+}
+
+
+static void neonUnfilterAvg(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, size_t length)
+{
+    auto a = vdup_n_u8(0);
+    for (size_t i = 0; i < length; i += bytewidth) {
+        //truncating halving add, (a + b) >> 1
+        auto avg = vhadd_u8(a, _neonLoad(precon + i, bytewidth));
+        a = vadd_u8(_neonLoad(scanline + i, bytewidth), avg);
+        _neonStore(recon + i, a, bytewidth);
+    }
+}
+
+
+static void neonUnfilterPaeth(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, size_t length)
+{
+    auto a = vdup_n_u8(0);
+    auto c = vdup_n_u8(0);
+    for (size_t i = 0; i < length; i += bytewidth) {
+        auto b = _neonLoad(precon + i, bytewidth);
+        auto pa = vabdl_u8(b, c);
+        auto pb = vabdl_u8(a, c);
+        auto pc = vabdq_u16(vaddl_u8(a, b), vaddl_u8(c, c));
+        //a has the priority over b, b over c
+        auto selA = vmovn_u16(vandq_u16(vcleq_u16(pa, pb), vcleq_u16(pa, pc)));
+        auto selB = vmovn_u16(vcleq_u16(pb, pc));
+        auto p = vbsl_u8(selA, a, vbsl_u8(selB, b, c));
+        a = vadd_u8(_neonLoad(scanline + i, bytewidth), p);
+        _neonStore(recon + i, a, bytewidth);
+        c = b;
+    }
+}
+
+
+static bool neonUnfilterScanline(unsigned char* recon, const unsigned char* scanline, const unsigned char* precon, size_t bytewidth, unsigned char filterType, size_t length)
+{
+    if (bytewidth != 3 && bytewidth != 4) return false;
+
+    switch (filterType) {
+        case 1: neonUnfilterSub(recon, scanline, bytewidth, length); return true;
+        case 2: if (!precon) return false; neonUnfilterUp(recon, scanline, precon, length); return true;
+        case 3: if (!precon) return false; neonUnfilterAvg(recon, scanline, precon, bytewidth, length); return true;
+        case 4: if (!precon) return false; neonUnfilterPaeth(recon, scanline, precon, bytewidth, length); return true;
+        default: return false;
+    }
+}
+
+#endif
@@ -34,12 +34,29 @@ void PngLoader::run(unsigned tid)
     auto width = static_cast<unsigned>(w);
     auto height = static_cast<unsigned>(h);
 
-    state.info_raw.colortype = LCT_RGBA;   //request this image format
+    //decode into the desired colorspace directly, the renderer won't need to convert it.
+    auto cs = surface.cs;
+    if (cs != ColorSpace::ABGR8888 && cs != ColorSpace::ARGB8888 && cs != ColorSpace::ARGB8888S) cs = ColorSpace::ABGR8888S;
 
-    if (lodepng_decode(&surface.buf8, &width, &height, &state, data, size)) TVGERR("PNG", "Failed to decode image");
-    else if (state.info_png.iccp_defined && lodepng_toSrgb(surface.buf8, surface.buf8, width, height, &state)) TVGERR("PNG", "Unsupported ICC color profile");
+    state.info_raw.colortype = LCT_RGBA;   //request this image format
+    state.decoder.premultiply = (cs == ColorSpace::ABGR8888 || cs == ColorSpace::ARGB8888);
+    state.decoder.swap_rb = (cs == ColorSpace::ARGB8888 || cs == ColorSpace::ARGB8888S);
+
+    unsigned error;
+    if (striped) {
+        width = area.w();
+        height = area.h();
+        error = lodepng_decode_area(&surface.buf8, area.x(), area.y(), width, height, &state, data, size);
+    } else error = lodepng_decode(&surface.buf8, &width, &height, &state, data, size);
+
+    if (error) TVGERR("PNG", "Failed to decode image");
+    else if (state.info_png.iccp_defined) {
+        //the profile is applied to the straight colors, the decoder left them unfinished.
+        if (lodepng_toSrgb(surface.buf8, surface.buf8, width, height, &state)) TVGERR("PNG", "Unsupported ICC color profile");
+        lodepng_finish(surface.buf8, (size_t)width * height, &state.decoder);
+    }
 
-    surface.setup(surface.buf32, width, width, height, sizeof(uint32_t), ColorSpace::ABGR8888S);
+    surface.setup(surface.buf32, width, width, height, sizeof(uint32_t), cs);
 }
 
 
@@ -73,6 +90,7 @@ Result PngLoader::open(const char* path, const LoaderOps& ops)
     if (lodepng_inspect(&width, &height, &state, data, size) > 0) return Result::InvalidArguments;
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    striped = huge(w, h) && state.info_png.interlace_method == 0;
     return Result::Success;
 #else
     return Result::NonSupport;
@@ -93,6 +111,7 @@ Result PngLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     owner = ops.owner;
     w = static_cast<float>(width);
     h = static_cast<float>(height);
+    striped = huge(w, h) && state.info_png.interlace_method == 0;
     this->size = size;
 
     return Result::Success;
@@ -105,6 +124,11 @@ bool PngLoader::read()
 
     if (!Loader::read()) return true;
 
+    surface.cs = BitmapLoader::cs;
+
+    //the visible area is not known yet, see BitmapLoader::stripe()
+    if (striped && area.invalid()) return true;
+
     TaskScheduler::request(this);
 
     return true;
@@ -116,3 +140,18 @@ RenderSurface* PngLoader::bitmap()
     this->done();
     return BitmapLoader::bitmap();
 }
+
+
+bool PngLoader::evictable()
+{
+    return data != nullptr;
+}
+
+
+void PngLoader::evict()
+{
+    this->done();
+    tvg::free(surface.buf8);
+    surface.data = nullptr;
+    readied = false;
+}
@@ -36,6 +36,8 @@ struct PngLoader : BitmapLoader, Task
     bool read() override;
 
     RenderSurface* bitmap() override;
+    bool evictable() override;
+    void evict() override;
 
 private:
     LodePNGState state;
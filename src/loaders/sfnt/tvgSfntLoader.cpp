@@ -188,8 +188,13 @@ static size_t _codepoints(const char** utf8, const char* end)
     return 0;
 }
 
-static void _build(const RenderPath& in, const Point& cursor, const Point& offset, RenderPath& out)
+static void _build(const SfntGlyphMetrics& glyph, const Point& cursor, const Point& offset, RenderPath& out, RenderGlyphs& rglyphs)
 {
+    auto& in = glyph.path;
+
+    //the origin keeps the first glyph point until the lines are aligned, see SfntLoader::get()
+    if (in.pts.count > 0) rglyphs.data.push({glyph.idx, out.cmds.count, in.cmds.count, out.pts.count, in.pts.count, in.pts.first()});
+
     out.cmds.push(in.cmds);
     out.pts.grow(in.pts.count);
     ARRAY_FOREACH(p, in.pts) {
@@ -273,9 +278,9 @@ SfntGlyphMetrics* SfntLoader::request(uint32_t code)
     return nullptr;
 }
 
-void SfntLoader::wrapNone(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out)
+void SfntLoader::wrapNone(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs)
 {
-    SfntGlyphMetrics* ltgm = nullptr;  // left side glyph between the two adjacent glyphs
+    auto ltidx = INVALID_GLYPH;  // left side glyph index between the two adjacent glyphs
     Point cursor = {};
     uint32_t line = 0;  //the begin pos of the last line among path
 
@@ -289,25 +294,25 @@ void SfntLoader::wrapNone(FontMetrics& fm, const Point& box, const char* utf8, c
         if (!rtgm) continue;
 
         Point offset{};
-        if (ltgm) reader->positioning(ltgm->idx, rtgm->idx, offset);
+        if (ltidx != INVALID_GLYPH) reader->positioning(ltidx, rtgm->idx, offset);
 
-        _build(rtgm->path, cursor, offset, out);
+        _build(*rtgm, cursor, offset, out, rglyphs);
         cursor.x += (rtgm->advance + offset.x) * fm.spacing.x;
 
         if (cursor.x > fm.size.x) fm.size.x = cursor.x;  //text horizontal size
 
         //store the base glyph width for italic transform
-        if (!ltgm) static_cast<SfntMetrics*>(fm.engine)->baseGlyph = rtgm;
-        ltgm = rtgm;
+        if (ltidx == INVALID_GLYPH) static_cast<SfntMetrics*>(fm.engine)->baseWidth = rtgm->bbox.w();
+        ltidx = rtgm->idx;
     }
     fm.size.y = height(fm.lines, fm.spacing.y);
     _alignY(fm.align.y, box.y, fm.size.y, 0, line, out); //before the last line
     _align(fm.align, box, {cursor.x, fm.size.y}, line, out.pts.count, out);  //last line
 }
 
-void SfntLoader::wrapChar(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out)
+void SfntLoader::wrapChar(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs)
 {
-    SfntGlyphMetrics* ltgm = nullptr;  // left side glyph between the two adjacent glyphs
+    auto ltidx = INVALID_GLYPH;  // left side glyph index between the two adjacent glyphs
     uint32_t line = 0;  //the begin pos of the last line among path
     Point cursor = {};
 
@@ -321,7 +326,7 @@ void SfntLoader::wrapChar(FontMetrics& fm, const Point& box, const char* utf8, c
         if (!rtgm) continue;
 
         Point offset{};
-        if (ltgm) reader->positioning(ltgm->idx, rtgm->idx, offset);
+        if (ltidx != INVALID_GLYPH) reader->positioning(ltidx, rtgm->idx, offset);
 
         auto xadv = (rtgm->advance + offset.x) * fm.spacing.x;
 
@@ -330,28 +335,28 @@ void SfntLoader::wrapChar(FontMetrics& fm, const Point& box, const char* utf8, c
             if (cursor.x + xadv > box.x) {
                 line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
             }
-            _build(rtgm->path, cursor, offset, out);
+            _build(*rtgm, cursor, offset, out, rglyphs);
             cursor.x += xadv;
         //not enough layout space, force pushing
         } else {
-            _build(rtgm->path, cursor, offset, out);
+            _build(*rtgm, cursor, offset, out, rglyphs);
             line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
         }
 
         if (cursor.x > fm.size.x) fm.size.x = cursor.x;  //text horizontal size
 
         //store the base glyph width for italic transform
-        if (!ltgm) static_cast<SfntMetrics*>(fm.engine)->baseGlyph = rtgm;
-        ltgm = rtgm;
+        if (ltidx == INVALID_GLYPH) static_cast<SfntMetrics*>(fm.engine)->baseWidth = rtgm->bbox.w();
+        ltidx = rtgm->idx;
     }
     fm.size.y = height(fm.lines, fm.spacing.y);
     _alignY(fm.align.y, box.y, fm.size.y, 0, line, out); //before the last line
     _align(fm.align, box, {cursor.x, fm.size.y}, line, out.pts.count, out);  //last line
 }
 
-void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, bool smart)
+void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs, bool smart)
 {
-    SfntGlyphMetrics* ltgm = nullptr;  // left side glyph between the two adjacent glyphs
+    auto ltidx = INVALID_GLYPH;  // left side glyph index between the two adjacent glyphs
     auto line = 0;  //the begin pos of the last line among path
     auto word = 0;  //the begin pos of the last word among path
     auto wadv = 0.0f;  //word advance size
@@ -368,7 +373,7 @@ void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, c
         if (!rtgm) continue;
 
         Point offset{};
-        if (ltgm) reader->positioning(ltgm->idx, rtgm->idx, offset);
+        if (ltidx != INVALID_GLYPH) reader->positioning(ltidx, rtgm->idx, offset);
 
         auto xadv = (rtgm->advance + offset.x) * fm.spacing.x;
 
@@ -392,7 +397,7 @@ void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, c
                 line = feedLine(fm, box.x, cursor.x, line, out.pts.count, cursor, out);
             }
         }
-        _build(rtgm->path, cursor, offset, out);
+        _build(*rtgm, cursor, offset, out, rglyphs);
         cursor.x += xadv;
 
         //capture the word start
@@ -404,17 +409,17 @@ void SfntLoader::wrapWord(FontMetrics& fm, const Point& box, const char* utf8, c
         if (cursor.x > fm.size.x) fm.size.x = cursor.x;  //text horizontal size
 
         //store the base glyph width for italic transform
-        if (!ltgm) static_cast<SfntMetrics*>(fm.engine)->baseGlyph = rtgm;
-        ltgm = rtgm;
+        if (ltidx == INVALID_GLYPH) static_cast<SfntMetrics*>(fm.engine)->baseWidth = rtgm->bbox.w();
+        ltidx = rtgm->idx;
     }
     fm.size.y = height(fm.lines, fm.spacing.y);
     _alignY(fm.align.y, box.y, fm.size.y, 0, line, out); //before the last line
     _align(fm.align, box, {cursor.x, fm.size.y}, line, out.pts.count, out);  //last line
 }
 
-void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out)
+void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs)
 {
-    SfntGlyphMetrics* ltgm = nullptr;  // left side glyph between the two adjacent glyphs
+    auto ltidx = INVALID_GLYPH;  // left side glyph index between the two adjacent glyphs
     auto line = 0;  //the begin pos of the last line among path
     Point cursor = {};
     struct {
@@ -434,14 +439,14 @@ void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf
         if (!rtgm) continue;
 
         Point offset{};
-        if (ltgm) reader->positioning(ltgm->idx, rtgm->idx, offset);
+        if (ltidx != INVALID_GLYPH) reader->positioning(ltidx, rtgm->idx, offset);
 
         auto xadv = (rtgm->advance + offset.x) * fm.spacing.x;
 
         //normal case
         if (cursor.x + xadv < box.x) {
             capture = {out.pts.count, out.cmds.count, xadv};
-            _build(rtgm->path, cursor, offset, out);
+            _build(*rtgm, cursor, offset, out, rglyphs);
             cursor.x += xadv;
         //ellipsis
         } else {
@@ -456,12 +461,13 @@ void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf
             if (cursor.x + (rtgm->advance + offset.x) * 3 > box.x) {
                 out.pts.count = capture.pts;
                 out.cmds.count = capture.cmds;
+                while (!rglyphs.data.empty() && rglyphs.data.last().pt >= capture.pts) rglyphs.data.pop();
                 cursor.x -= capture.xadv;
             }
             //append ...
             auto tmp = (rtgm->advance + offset.x) * fm.spacing.x;
             for (int i = 0; i < 3; ++i) {
-                _build(rtgm->path, cursor, offset, out);
+                _build(*rtgm, cursor, offset, out, rglyphs);
                 cursor.x += tmp;
             }
             stop = true;
@@ -470,11 +476,11 @@ void SfntLoader::wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf
         if (cursor.x > fm.size.x) fm.size.x = cursor.x;  //text horizontal size
 
         //store the base glyph width for italic transform
-        if (!ltgm) static_cast<SfntMetrics*>(fm.engine)->baseGlyph = rtgm;
+        if (ltidx == INVALID_GLYPH) static_cast<SfntMetrics*>(fm.engine)->baseWidth = rtgm->bbox.w();
 
         if (stop) break;  //stop the process if the ellipsis is applied
 
-        ltgm = rtgm;
+        ltidx = rtgm->idx;
     }
     fm.size.y = height(fm.lines, fm.spacing.y);
     _alignY(fm.align.y, box.y, fm.size.y, 0, line, out); //before the last line
@@ -512,14 +518,15 @@ void SfntLoader::transform(Paint* paint, FontMetrics& fm, float italicShear)
 {
     auto engine = static_cast<SfntMetrics*>(fm.engine);
     auto scale = 1.0f / fm.scale;
-    auto baseWidth = (engine->baseGlyph) ? engine->baseGlyph->bbox.w() : 0.0f;
-    Matrix m = {scale, -italicShear * scale, italicShear * baseWidth * scale, 0, scale, reader->metrics.hhea.ascent * scale, 0, 0, 1};
+    Matrix m = {scale, -italicShear * scale, italicShear * engine->baseWidth * scale, 0, scale, reader->metrics.hhea.ascent * scale, 0, 0, 1};
     paint->transform(m);
 }
 
 SfntLoader::SfntLoader() :
     FontLoader(FileType::Sfnt)
 {
+    static atomic<uint32_t> fonts{0};
+    id = ++fonts;
 }
 
 SfntLoader::~SfntLoader()
@@ -556,9 +563,12 @@ Result SfntLoader::open(const char* data, uint32_t size, TVG_UNUSED const Loader
     return reader->header() ? Result::Success : Result::InvalidArguments;
 }
 
-bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out)
+bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphs& rglyphs)
 {
     out.clear();
+    rglyphs.data.clear();
+    rglyphs.font = id;
+    rglyphs.em = reader->metrics.unitsPerEm;
 
     fm.lines = 1;
 
@@ -571,13 +581,18 @@ bool SfntLoader::get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out)
     auto box = fm.box * fm.scale;
     auto end = text + len;
 
-    if (fm.wrap == TextWrap::None || fm.box.x == 0.0f) wrapNone(fm, box, text, end, out);
-    else if (fm.wrap == TextWrap::Character) wrapChar(fm, box, text, end, out);
-    else if (fm.wrap == TextWrap::Word) wrapWord(fm, box, text, end, out, false);
-    else if (fm.wrap == TextWrap::Smart) wrapWord(fm, box, text, end, out, true);
-    else if (fm.wrap == TextWrap::Ellipsis) wrapEllipsis(fm, box, text, end, out);
+    if (fm.wrap == TextWrap::None || fm.box.x == 0.0f) wrapNone(fm, box, text, end, out, rglyphs);
+    else if (fm.wrap == TextWrap::Character) wrapChar(fm, box, text, end, out, rglyphs);
+    else if (fm.wrap == TextWrap::Word) wrapWord(fm, box, text, end, out, rglyphs, false);
+    else if (fm.wrap == TextWrap::Smart) wrapWord(fm, box, text, end, out, rglyphs, true);
+    else if (fm.wrap == TextWrap::Ellipsis) wrapEllipsis(fm, box, text, end, out, rglyphs);
     else return false;
 
+    //the glyphs are aligned along with the path, now resolve their origins
+    ARRAY_FOREACH(p, rglyphs.data) {
+        p->origin = out.pts[p->pt] - p->origin;
+    }
+
     return true;
 }
 
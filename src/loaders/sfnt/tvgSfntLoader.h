@@ -31,7 +31,7 @@ using namespace std;
 
 struct SfntMetrics : FontMetrics
 {
-    SfntGlyphMetrics* baseGlyph;  // Use as the reference glyph width for italic transform
+    float baseWidth;  // Use as the reference glyph width for italic transform
 };
 
 struct SfntLoader : public FontLoader
@@ -39,9 +39,10 @@ struct SfntLoader : public FontLoader
 #if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
     void* mapping = nullptr;
 #endif
-    Map<uint32_t, SfntGlyphMetrics> glyphs;  // glyph cache. key: codepoint
+    Map<uint32_t, SfntGlyphMetrics> glyphs;  // glyph cache. key: codepoint, the entries move on growing
     SfntReader* reader = nullptr;
     char* text = nullptr;
+    uint32_t id;  //unique font id for the glyph caches of the engines
     bool nomap = false;
 
     SfntLoader();
@@ -53,7 +54,7 @@ struct SfntLoader : public FontLoader
     Result open(const char* path, const LoaderOps& ops) override;
     Result open(const char* data, uint32_t size, const LoaderOps& ops) override;
     void transform(Paint* paint, FontMetrics& fm, float italicShear) override;
-    bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out) override;
+    bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphs& rglyphs) override;
     void copy(const FontMetrics& in, FontMetrics& out) override;
     void release(FontMetrics& fm) override;
     void metrics(const FontMetrics& fm, TextMetrics& out) override;
@@ -68,10 +69,10 @@ private:
     }
 
     uint32_t feedLine(FontMetrics& fm, float box, float x, uint32_t begin, uint32_t end, Point& cursor, RenderPath& out);
-    void wrapNone(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out);
-    void wrapChar(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out);
-    void wrapWord(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, bool smart);
-    void wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out);
+    void wrapNone(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs);
+    void wrapChar(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs);
+    void wrapWord(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs, bool smart);
+    void wrapEllipsis(FontMetrics& fm, const Point& box, const char* utf8, const char* end, RenderPath& out, RenderGlyphs& rglyphs);
     SfntGlyphMetrics* request(uint32_t code);
     void clear();
 };
@@ -55,14 +55,21 @@ uint32_t SfntReader::cmap_12_13(uint32_t table, uint32_t codepoint, int fmt) con
     if (!validate(table, len)) return -1;
 
     auto entryCnt = u32(table + 12);
-
-    for (uint32_t i = 0; i < entryCnt; ++i) {
-        auto firstCode = u32(table + (i * 12) + 16);
-        auto lastCode = u32(table + (i * 12) + 16 + 4);
-        if (codepoint < firstCode || codepoint > lastCode) continue;
-        auto glyphOffset = u32(table + (i * 12) + 16 + 8);
-        if (fmt == 12) return (codepoint - firstCode) + glyphOffset;
-        else return glyphOffset;
+    if ((len - 16) / 12 < entryCnt) return -1;
+
+    // binary search over the groups sorted by the start codes.
+    uint32_t low = 0;
+    auto high = entryCnt;
+    while (low < high) {
+        auto mid = low + (high - low) / 2;
+        auto group = table + (mid * 12) + 16;
+        if (codepoint < u32(group)) high = mid;
+        else if (codepoint > u32(group + 4)) low = mid + 1;
+        else {
+            auto glyphOffset = u32(group + 8);
+            if (fmt == 12) return (codepoint - u32(group)) + glyphOffset;
+            else return glyphOffset;
+        }
     }
     return -1;
 }
@@ -164,7 +171,7 @@ bool SfntReader::glyphMetrics(SfntGlyph& glyph)
     return true;
 }
 
-uint32_t SfntReader::glyph(uint32_t codepoint)
+uint32_t SfntReader::lookup(uint32_t codepoint)
 {
     auto entryCnt = u16(cmap + 2);
     if (!validate(cmap, 4 + entryCnt * 8)) return -1;
@@ -208,6 +215,31 @@ uint32_t SfntReader::glyph(uint32_t codepoint)
 /* External Class Implementation                                        */
 /************************************************************************/
 
+SfntReader::~SfntReader()
+{
+    for (int i = 0; i < 256; ++i) {
+        tvg::free(bmp[i]);
+    }
+}
+
+uint32_t SfntReader::glyph(uint32_t codepoint)
+{
+    if (codepoint > 0xffff) return lookup(codepoint);
+
+    // decode the whole page of the BMP at once, 0xffff is never a valid glyph index.
+    auto& page = bmp[codepoint >> 8];
+    if (!page) {
+        page = tvg::malloc<uint16_t>(sizeof(uint16_t) * 256);
+        auto base = codepoint & 0xff00;
+        for (uint32_t i = 0; i < 256; ++i) {
+            auto idx = lookup(base + i);
+            page[i] = (idx < 0xffff) ? uint16_t(idx) : 0xffff;
+        }
+    }
+    auto idx = page[codepoint & 0xff];
+    return (idx == 0xffff) ? INVALID_GLYPH : idx;
+}
+
 bool SfntReader::header()
 {
     if (!validate(0, 12)) return false;
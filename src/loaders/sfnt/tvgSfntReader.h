@@ -60,7 +60,7 @@ struct SfntReader
 
     SfntReader(uint8_t* data, uint32_t size) :
         data(data), size(size) {}
-    virtual ~SfntReader() {}
+    virtual ~SfntReader();
 
     virtual bool header();
     virtual bool positioning(uint32_t lglyph, uint32_t rglyph, Point& out) = 0;
@@ -70,12 +70,14 @@ protected:
     uint32_t cmap = 0;  // character map
     uint32_t hmtx = 0;  // horizontal metrics
     uint32_t maxp = 0;  // maximum profile
+    uint16_t* bmp[256] = {};  // lazily decoded character map of the BMP, 256 codepoints per page
 
     uint32_t table(const char* tag) const;
     bool validate(uint32_t offset, uint32_t margin) const;
     uint32_t cmap_12_13(uint32_t table, uint32_t codepoint, int which) const;
     uint32_t cmap_4(uint32_t table, uint32_t codepoint) const;
     uint32_t cmap_6(uint32_t table, uint32_t codepoint) const;
+    uint32_t lookup(uint32_t codepoint);
     uint32_t glyph(uint32_t codepoint);
     bool glyphMetrics(SfntGlyph& glyph);
 
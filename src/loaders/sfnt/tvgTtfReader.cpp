@@ -272,6 +272,53 @@ bool TtfReader::convert(RenderPath& path, SfntGlyph& glyph, uint32_t glyphOffset
     return ret;
 }
 
+//decode the horizontal kerning pairs of the format 0 subtables at once
+void TtfReader::kerning()
+{
+    #define HORIZONTAL_KERNING 0x01
+    #define MINIMUM_KERNING 0x02
+    #define CROSS_STREAM_KERNING 0x04
+
+    kerned = true;
+
+    auto kern = this->kern;
+
+    // kern tables
+    auto tableCnt = u16(kern + 2);
+    kern += 4;
+
+    while (tableCnt > 0) {
+        // read subtable header.
+        if (!validate(kern, 6)) return;
+        auto length = u16(kern + 2);
+        auto format = u8(kern + 4);
+        auto flags = u8(kern + 5);
+
+        if (format == 0) {
+            // read format 0 header.
+            if (!validate(kern + 6, 8)) return;
+            auto pairCnt = u16(kern + 6);
+            auto pair = kern + 14;
+            if (!validate(pair, pairCnt * 6)) return;
+
+            if ((flags & HORIZONTAL_KERNING) && !(flags & MINIMUM_KERNING)) {
+                pairs.reserve(pairs.count + pairCnt);
+                for (uint32_t i = 0; i < pairCnt; ++i) {
+                    auto& offset = pairs[u32(pair + i * 6)];
+                    auto value = i16(pair + i * 6 + 4);
+                    if (flags & CROSS_STREAM_KERNING) offset.y += value;
+                    else offset.x += value;
+                }
+            }
+            // the length field overflows with a large number of pairs.
+            kern = pair + pairCnt * 6;
+        } else {
+            kern += length;
+        }
+        --tableCnt;
+    }
+}
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -296,49 +343,10 @@ bool TtfReader::header()
 
 bool TtfReader::positioning(uint32_t lglyph, uint32_t rglyph, Point& out)
 {
-    #define HORIZONTAL_KERNING 0x01
-    #define MINIMUM_KERNING 0x02
-    #define CROSS_STREAM_KERNING 0x04
-
-    auto kern = this->kern;
     if (!kern) return false;
+    if (!kerned) kerning();
 
-    // kern tables
-    auto tableCnt = u16(kern + 2);
-    kern += 4;
-
-    while (tableCnt > 0) {
-        // read subtable header.
-        if (!validate(kern, 6)) return false;
-        auto length = u16(kern + 2);
-        auto format = u8(kern + 4);
-        auto flags = u8(kern + 5);
-        kern += 6;
-
-        if (format == 0 && (flags & HORIZONTAL_KERNING) && !(flags & MINIMUM_KERNING)) {
-            // read format 0 header.
-            if (!validate(kern, 8)) return false;
-            auto pairCnt = u16(kern);
-            kern += 8;
-
-            // look up character code pair via binary search.
-            uint8_t key[4];
-            key[0] = (lglyph >> 8) & 0xff;
-            key[1] = lglyph & 0xff;
-            key[2] = (rglyph >> 8) & 0xff;
-            key[3] = rglyph & 0xff;
-
-            auto match = bsearch(key, data + kern, pairCnt, 6, cmpu32);
-
-            if (match) {
-                auto value = i16((uint32_t)((uint8_t*)match - data + 4));
-                if (flags & CROSS_STREAM_KERNING) out.y += value;
-                else out.x += value;
-            }
-        }
-        kern += length;
-        --tableCnt;
-    }
+    if (auto pair = pairs.find((lglyph & 0xffff) << 16 | (rglyph & 0xffff))) out += pair->val;
 
     return true;
 }
@@ -23,6 +23,7 @@
 #ifndef _TVG_TTF_READER_H_
 #define _TVG_TTF_READER_H_
 
+#include "tvgMap.h"
 #include "tvgSfntReader.h"
 
 struct TtfReader : SfntReader
@@ -38,7 +39,10 @@ private:
     uint32_t loca = 0;  // index to location
     uint32_t glyf = 0;  // glyph outline
     uint32_t kern = 0;  // kerning
+    Map<uint32_t, Point> pairs;  // decoded kerning pairs. key: left << 16 | right
+    bool kerned = false;  // kerning pairs are decoded
 
+    void kerning();
     uint32_t outlineOffset(uint32_t glyph);
     bool convert(RenderPath& path, SfntGlyph& glyph, uint32_t glyphOffset, const Point& offset, uint16_t depth);
     bool composite(RenderPath& path, SfntGlyph& glyph, uint32_t glyphOffset, const Point& offset, uint16_t depth);
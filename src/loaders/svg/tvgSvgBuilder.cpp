@@ -25,6 +25,7 @@
 #include "tvgCompressor.h"
 #include "tvgFill.h"
 #include "tvgStr.h"
+#include "tvgTrace.h"
 #include "tvgShape.h"
 #include "tvgSvgCommon.h"
 #include "tvgSvgBuilder.h"
@@ -1214,6 +1215,170 @@ static Paint* _textBuildHelper(SvgParserContext& ctx, const SvgNode* node, const
     return _applyBlend(p, node);
 }
 
+static Paint* _childBuildHelper(SvgParserContext& ctx, const SvgNode* node, SvgNode* child, const Box& vBox, const string& svgPath, int depth)
+{
+    Paint* paint = nullptr;
+    if (child->type == SvgNodeType::ClipPath || child->type == SvgNodeType::Filter || child->type == SvgNodeType::Pattern) return nullptr;
+    if (_isGroupType(child->type)) {
+        if (child->type == SvgNodeType::Use) paint = _useBuildHelper(ctx, child, vBox, svgPath, depth + 1);
+        else if (!(child->type == SvgNodeType::Symbol && node->type != SvgNodeType::Use)) paint = _sceneBuildHelper(ctx, child, vBox, svgPath, false, depth + 1);
+    } else {
+        if (child->type == SvgNodeType::Image) paint = _imageBuildHelper(ctx, child, vBox, svgPath);
+        else if (child->type == SvgNodeType::Text) paint = _textBuildHelper(ctx, child, vBox, svgPath);
+        else if (child->type != SvgNodeType::Mask) paint = _shapeBuildHelper(ctx, child, vBox, svgPath);
+    }
+    if (paint) {
+        // TODO: enable this only when accessible is enabled at thorvg v2 (for backward compat)
+        if (child->id) {
+            paint->id = djb2Encode(child->id);
+            if (ctx.accessible) ctx.access.push({paint->id, paint, tvg::duplicate(child->id)});
+        }
+    }
+    return paint;
+}
+
+#ifdef THORVG_THREAD_SUPPORT
+
+//the minimum number of independent children worth distributing over the task workers
+#define PARALLEL_BUILD_MIN 64
+
+//A subtree is independent if building it touches no node shared with the others.
+//Clip, mask and pattern nodes are shared and carry recursion guards, so they stay on the caller.
+//Texts query the glyphs of the shared font loaders, which are not guarded either.
+static bool _independent(const SvgNode* node, int depth)
+{
+    if (depth > 2192 || node->type == SvgNodeType::Text) return false;
+
+    auto style = node->style;
+    if (style->clipPath.node || style->mask.node || style->fill.paint.pattern || style->stroke.paint.pattern) return false;
+
+    ARRAY_FOREACH(p, node->child) {
+        if (!_independent(*p, depth + 1)) return false;
+    }
+    return true;
+}
+
+struct SvgBuildSlot
+{
+    Paint* paint;
+    uint32_t access;    //the accessor count of the builder context right after this child was built
+    bool independent;
+};
+
+struct SvgBuildTask : Task
+{
+    SvgParserContext ctx;
+    const SvgNode* node;
+    SvgBuildSlot* slots;
+    const Box* vBox;
+    const string* svgPath;
+    uint32_t begin, end;
+    uint32_t cursor = 0;   //accessor entries already merged back to the main context
+    int depth;
+    atomic<bool> claimed{false};
+
+    void build(uint32_t i)
+    {
+        slots[i].paint = _childBuildHelper(ctx, node, node->child[i], *vBox, *svgPath, depth);
+        slots[i].access = ctx.access.count;
+    }
+
+    void build()
+    {
+        for (auto i = begin; i < end; ++i) {
+            if (slots[i].independent) build(i);
+        }
+    }
+
+    void run(unsigned tid) override
+    {
+        //the requester may have built this range on its own already, then nothing else is valid to touch
+        if (claimed.exchange(true)) return;
+        build();
+    }
+};
+
+//Build the children of the node on the task workers while keeping the paint order and the accessor order of the sequential build.
+static bool _parallelBuildHelper(SvgParserContext& ctx, const SvgNode* node, Scene* scene, const Box& vBox, const string& svgPath, int depth)
+{
+    if (!ctx.parallel || TaskScheduler::threads() == 0 || node->child.count < PARALLEL_BUILD_MIN) return false;
+
+    auto cnt = node->child.count;
+    auto slots = tvg::malloc<SvgBuildSlot>(sizeof(SvgBuildSlot) * cnt);
+    auto independents = 0U;
+    for (uint32_t i = 0; i < cnt; ++i) {
+        slots[i] = {nullptr, 0, _independent(node->child[i], depth + 1)};
+        if (slots[i].independent) ++independents;
+    }
+
+    if (independents < PARALLEL_BUILD_MIN) {
+        tvg::free(slots);
+        return false;
+    }
+
+    //one range per worker, the last range is built on this thread together with the dependent children
+    auto workers = TaskScheduler::threads();
+    auto range = (cnt + workers) / (workers + 1);
+    auto tasks = tvg::malloc<SvgBuildTask*>(sizeof(SvgBuildTask*) * (workers + 1));
+
+    for (uint32_t i = 0; i <= workers; ++i) {
+        auto task = tasks[i] = new SvgBuildTask;
+        task->ctx.parser = ctx.parser;
+        task->ctx.accessible = ctx.accessible;
+        task->ctx.parallel = false;
+        task->node = node;
+        task->slots = slots;
+        task->vBox = &vBox;
+        task->svgPath = &svgPath;
+        task->begin = std::min(i * range, cnt);
+        task->end = std::min(task->begin + range, cnt);
+        task->depth = depth;
+    }
+    for (uint32_t i = 0; i < workers; ++i) TaskScheduler::request(tasks[i]);
+
+    //the local range comes last, so its accessor entries remain in the document order
+    auto local = tasks[workers];
+    for (uint32_t i = 0; i < cnt; ++i) {
+        if (!slots[i].independent || i >= local->begin) local->build(i);
+    }
+
+    //Never wait for a range no worker has picked up yet: the workers might be blocked as well. Build it here instead.
+    //Such a task is still queued, so the loader keeps it until the end.
+    for (uint32_t i = 0; i < workers; ++i) {
+        if (tasks[i]->claimed.exchange(true)) tasks[i]->done();
+        else tasks[i]->build();
+    }
+
+    //stitch the results back in the document order
+    for (uint32_t i = 0; i < cnt; ++i) {
+        auto task = slots[i].independent ? tasks[i / range] : local;
+        while (task->cursor < slots[i].access) ctx.access.push(task->ctx.access[task->cursor++]);
+        if (slots[i].paint) scene->add(slots[i].paint);
+    }
+
+    for (uint32_t i = 0; i <= workers; ++i) {
+        ctx.images.push(tasks[i]->ctx.images);
+        tasks[i]->ctx.images.clear();
+        tasks[i]->ctx.access.clear();
+        if (i < workers) ctx.builders.push(tasks[i]);
+    }
+    delete(local);
+
+    tvg::free(tasks);
+    tvg::free(slots);
+
+    return true;
+}
+
+#else
+
+static bool _parallelBuildHelper(TVG_UNUSED SvgParserContext& ctx, TVG_UNUSED const SvgNode* node, TVG_UNUSED Scene* scene, TVG_UNUSED const Box& vBox, TVG_UNUSED const string& svgPath, TVG_UNUSED int depth)
+{
+    return false;
+}
+
+#endif
+
 static Scene* _sceneBuildHelper(SvgParserContext& ctx, const SvgNode* node, const Box& vBox, const string& svgPath, bool mask, int depth)
 {
     /* Exception handling: Prevent invalid SVG data input.
@@ -1236,25 +1401,9 @@ static Scene* _sceneBuildHelper(SvgParserContext& ctx, const SvgNode* node, cons
     }
     if (!node->style->display || node->style->opacity == 0) return scene;
 
-    ARRAY_FOREACH(p, node->child) {
-        auto child = *p;
-        Paint* paint = nullptr;
-        if (child->type == SvgNodeType::ClipPath || child->type == SvgNodeType::Filter || child->type == SvgNodeType::Pattern) continue;
-        if (_isGroupType(child->type)) {
-            if (child->type == SvgNodeType::Use) paint = _useBuildHelper(ctx, child, vBox, svgPath, depth + 1);
-            else if (!(child->type == SvgNodeType::Symbol && node->type != SvgNodeType::Use)) paint = _sceneBuildHelper(ctx, child, vBox, svgPath, false, depth + 1);
-        } else {
-            if (child->type == SvgNodeType::Image) paint = _imageBuildHelper(ctx, child, vBox, svgPath);
-            else if (child->type == SvgNodeType::Text) paint = _textBuildHelper(ctx, child, vBox, svgPath);
-            else if (child->type != SvgNodeType::Mask) paint = _shapeBuildHelper(ctx, child, vBox, svgPath);
-        }
-        if (paint) {
-            // TODO: enable this only when accessible is enabled at thorvg v2 (for backward compat)
-            if (child->id) {
-                paint->id = djb2Encode(child->id);
-                if (ctx.accessible) ctx.access.push({paint->id, paint, tvg::duplicate(child->id)});
-            }
-            scene->add(paint);
+    if (!_parallelBuildHelper(ctx, node, scene, vBox, svgPath, depth)) {
+        ARRAY_FOREACH(p, node->child) {
+            if (auto paint = _childBuildHelper(ctx, node, *p, vBox, svgPath, depth)) scene->add(paint);
         }
     }
     scene->opacity(node->style->opacity);
@@ -1472,6 +1621,8 @@ static bool _hasUserSpaceGradients(SvgParserContext& ctx)
 
 Scene* svgSceneBuild(SvgParserContext& ctx, Box vBox, float w, float h, AspectRatioAlign align, AspectRatioMeetOrSlice meetOrSlice, const string& svgPath, SvgViewFlag viewFlag)
 {
+    TVGTRACE("svgSceneBuild");
+
     //TODO: aspect ratio is valid only if viewBox was set
 
     if (!ctx.doc || (ctx.doc->type != SvgNodeType::Doc)) return nullptr;
@@ -28,6 +28,7 @@
 #include "tvgInlist.h"
 #include "tvgColor.h"
 #include "tvgAccessor.h"
+#include "tvgTaskScheduler.h"
 
 using SvgColor = tvg::RGB;
 
@@ -483,6 +484,8 @@ struct SvgDash
     float offset;
 };
 
+struct SvgParserContext;
+
 struct SvgStyleGradient
 {
     char* id;
@@ -498,13 +501,7 @@ struct SvgStyleGradient
     FillSpread spread;
     bool userSpace;
 
-    void clear()
-    {
-        stops.reset();
-        tvg::free(transform);
-        tvg::free(ref);
-        tvg::free(id);
-    }
+    void clear(const SvgParserContext* ctx);
 };
 
 struct SvgStyleFill
@@ -679,9 +676,26 @@ struct SvgParserContext
     // TODO: We can remove map and directly use the name instead of id in ThorVG v2
     // TODO: Maybe we can replace this with std::map. Currently, ArrayList seems fast enough.
     Array<AccessorEntity> access;
+    Array<Task*> builders;      //subtree builders that may still be queued on the task workers
+
+    //Writable document buffer which is tokenized in place.
+    //Ids, classes, hrefs and path data may point into this range instead of owning a copy.
+    const char* content = nullptr;
+    uint32_t size = 0;
 
     OpenedTagType openedTag = OpenedTagType::Other;
     bool accessible;  // allow the Accessor to retain the SVG node names
+    bool parallel = true;  // allow the builder to distribute independent subtrees over the task workers
+
+    bool borrowed(const char* str) const
+    {
+        return str >= content && str < content + size;
+    }
+
+    void release(char* str) const
+    {
+        if (!borrowed(str)) tvg::free(str);
+    }
 
     void clear(bool all);
 };
@@ -21,6 +21,7 @@
  */
 
 #include "tvgStr.h"
+#include "tvgTrace.h"
 #include "tvgMath.h"
 #include "tvgColor.h"
 #include "tvgLoader.h"
@@ -30,6 +31,13 @@
 #include "tvgSvgCssStyle.h"
 #include "tvgSvgUtil.h"
 
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+#endif
+
 /************************************************************************/
 /* Internal Class Implementation                                        */
 /************************************************************************/
@@ -76,6 +84,22 @@ static void _copyId(char** to, const char* from)
 }
 
 
+//Refer to the in-place tokenized document instead of duplicating the string when possible
+static void _refId(const SvgParserContext* ctx, char** to, const char* from)
+{
+    ctx->release(*to);
+    if (from && *from != '\0') *to = ctx->borrowed(from) ? const_cast<char*>(from) : duplicate(from);
+    else *to = nullptr;
+}
+
+
+//Attribute values of the writable document can be terminated in place instead of being copied
+static bool _parseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data)
+{
+    return xmlParseAttributes(buf, bufLength, func, data, ((const SvgParserContext*)data)->borrowed(buf));
+}
+
+
 static bool _parseNumber(const char** content, const char** end, float* number)
 {
     auto _end = end ? *end : nullptr;
@@ -1109,7 +1133,7 @@ static void _handleDisplayAttr(TVG_UNUSED SvgParserContext* ctx, SvgNode* node,
 }
 
 
-static bool _cssApplyClass(SvgNode* node, const char* classString, SvgNode* styleRoot);
+static bool _cssApplyClass(const SvgParserContext* ctx, SvgNode* node, const char* classString, SvgNode* styleRoot);
 
 static void _handlePaintOrderAttr(TVG_UNUSED SvgParserContext* ctx, SvgNode* node, const char* value)
 {
@@ -1206,9 +1230,9 @@ static void _handleCssClassAttr(SvgParserContext* ctx, SvgNode* node, const char
 {
     auto cssClass = &node->style->cssClass;
 
-    _copyId(cssClass, value);
+    _refId(ctx, cssClass, value);
 
-    if (!_cssApplyClass(node, *cssClass, ctx->cssStyle)) {
+    if (!_cssApplyClass(ctx, node, *cssClass, ctx->cssStyle)) {
         ctx->nodesToStyle.push({node, *cssClass});
     }
 }
@@ -1346,7 +1370,7 @@ static bool _attrParseGNode(void* data, const char* key, const char* value)
 
     if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "transform")) node->transform = _parseTransformationMatrix(value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
     else if (STR_AS(key, "mask")) _handleMaskAttr(ctx, node, value);
@@ -1371,7 +1395,7 @@ static bool _attrParseClipPathNode(void* data, const char* key, const char* valu
     } else if (STR_AS(key, "transform")) {
         node->transform = _parseTransformationMatrix(value);
     } else if (STR_AS(key, "id")) {
-        _copyId(&node->id, value);
+        _refId(ctx, &node->id, value);
     } else if (STR_AS(key, "class")) {
         _handleCssClassAttr(ctx, node, value);
     } else if (STR_AS(key, "clipPathUnits")) {
@@ -1415,7 +1439,7 @@ static bool _attrParseMaskNode(void* data, const char* key, const char* value)
 
     if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "transform")) node->transform = _parseTransformationMatrix(value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "maskUnits")) { if (STR_AS(value, "userSpaceOnUse")) mask->userSpace = true; }
     else if (STR_AS(key, "maskContentUnits")) { if (STR_AS(value, "objectBoundingBox")) mask->maskContentUserSpace = false; }
@@ -1431,7 +1455,7 @@ static bool _attrParseCssStyleNode(void* data, const char* key, const char* valu
     auto ctx = (SvgParserContext*)data;
     auto node = ctx->parser->node;
 
-    if (STR_AS(key, "id")) _copyId(&node->id, value);
+    if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else return _parseStyleAttr(ctx, key, value, false);
     return true;
 }
@@ -1472,7 +1496,7 @@ static bool _attrParseFilterNode(void* data, const char* key, const char* value)
     _parseBox(key, value, &filter->box, filter->isPercentage);
 
     if (STR_AS(key, "id")) {
-        _copyId(&node->id, value);
+        _refId(ctx, &node->id, value);
     } else if (STR_AS(key, "primitiveUnits")) {
         if (STR_AS(value, "objectBoundingBox")) filter->primitiveUserSpace = false;
     } else if (STR_AS(key, "filterUnits")) {
@@ -1511,7 +1535,7 @@ static bool _attrParseGaussianBlurNode(void* data, const char* key, const char*
     if (_parseBox(key, value, &gaussianBlur->box, gaussianBlur->isPercentage)) gaussianBlur->hasBox = true;
 
     if (STR_AS(key, "id")) {
-        _copyId(&node->id, value);
+        _refId(ctx, &node->id, value);
     } else if (STR_AS(key, "stdDeviation")) {
         _parseGaussianBlurStdDeviation(&value, &gaussianBlur->stdDevX, &gaussianBlur->stdDevY);
     } else if (STR_AS(key, "edgeMode")) {
@@ -1679,7 +1703,7 @@ static bool _attrParsePatternNode(void* data, const char* key, const char* value
 
     if (_parseBox(key, value, &pattern->box, pattern->isPercentage)) return true;
 
-    if (STR_AS(key, "id")) _copyId(&node->id, value);
+    if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "patternUnits")) {
         if (STR_AS(value, "userSpaceOnUse")) pattern->patternUserSpace = true;
     } else if (STR_AS(key, "patternContentUnits")) {
@@ -1717,12 +1741,12 @@ static bool _attrParsePathNode(void* data, const char* key, const char* value)
     auto node = ctx->parser->node;
     auto path = &node->node.path;
 
-    if (STR_AS(key, "d")) _copyId(&path->path, value);  // Temporary: need to copy
+    if (STR_AS(key, "d")) _refId(ctx, &path->path, value);
     else if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
     else if (STR_AS(key, "mask")) _handleMaskAttr(ctx, node, value);
     else if (STR_AS(key, "filter")) _handleFilterAttr(ctx, node, value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else return _parseStyleAttr(ctx, key, value, false);
     return true;
@@ -1776,7 +1800,7 @@ static bool _attrParseCircleNode(void* data, const char* key, const char* value)
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
     else if (STR_AS(key, "mask")) _handleMaskAttr(ctx, node, value);
     else if (STR_AS(key, "filter")) _handleFilterAttr(ctx, node, value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else return _parseStyleAttr(ctx, key, value, false);
     return true;
@@ -1826,7 +1850,7 @@ static bool _attrParseEllipseNode(void* data, const char* key, const char* value
         }
     }
 
-    if (STR_AS(key, "id")) _copyId(&node->id, value);
+    if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
@@ -1875,7 +1899,7 @@ static bool _attrParsePolygonNode(void* data, const char* key, const char* value
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
     else if (STR_AS(key, "mask")) _handleMaskAttr(ctx, node, value);
     else if (STR_AS(key, "filter")) _handleFilterAttr(ctx, node, value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else return _parseStyleAttr(ctx, key, value, false);
     return true;
@@ -1944,7 +1968,7 @@ static bool _attrParseRectNode(void* data, const char* key, const char* value)
         }
     }
 
-    if (STR_AS(key, "id")) _copyId(&node->id, value);
+    if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "style")) ret = xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
@@ -1999,7 +2023,7 @@ static bool _attrParseLineNode(void* data, const char* key, const char* value)
         }
     }
 
-    if (STR_AS(key, "id")) _copyId(&node->id, value);
+    if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
@@ -2021,10 +2045,11 @@ static SvgNode* _createLineNode(SvgParserContext* ctx, SvgNode* parent, const ch
 }
 
 
-static char* _idFromHref(const char* href)
+static char* _idFromHref(const SvgParserContext* ctx, const char* href)
 {
     href = svgUtilSkipWhiteSpace(href, nullptr);
     if ((*href) == '#') href++;
+    if (ctx->borrowed(href)) return const_cast<char*>(href);
     return duplicate(href);
 }
 
@@ -2063,9 +2088,9 @@ static bool _attrParseImageNode(void* data, const char* key, const char* value)
     }
 
     if (STR_AS(key, "href") || STR_AS(key, "xlink:href")) {
-        if (value) tvg::free(image->href);
-        image->href = _idFromHref(value);
-    } else if (STR_AS(key, "id")) _copyId(&node->id, value);
+        if (value) ctx->release(image->href);
+        image->href = _idFromHref(ctx, value);
+    } else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else if (STR_AS(key, "style")) return xmlParseW3CAttribute(value, strlen(value), _parseStyleAttr, ctx);
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
@@ -2219,7 +2244,7 @@ static bool _attrParseUseNode(void* data, const char* key, const char* value)
     }
 
     if (STR_AS(key, "href") || STR_AS(key, "xlink:href")) {
-        id = _idFromHref(value);
+        id = _idFromHref(ctx, value);
         defs = _getDefsNode(node);
         nodeFrom = _findNodeById(defs, id);
         if (nodeFrom) {
@@ -2237,11 +2262,11 @@ static bool _attrParseUseNode(void* data, const char* key, const char* value)
                 if (!postpone) {
                     _cloneNode(nodeFrom, node, 0);
                     if (nodeFrom->type == SvgNodeType::Symbol) use->symbol = nodeFrom;
-                    tvg::free(id);
+                    ctx->release(id);
                 }
             } else {
                 TVGLOG("SVG", "%s is ancestor element. This reference is invalid.", id);
-                tvg::free(id);
+                ctx->release(id);
             }
         } else {
             //some svg export software include <defs> element at the end of the file
@@ -2309,7 +2334,7 @@ static bool _attrParseTextNode(void* data, const char* key, const char* value)
     else if (STR_AS(key, "clip-path")) _handleClipPathAttr(ctx, node, value);
     else if (STR_AS(key, "mask")) _handleMaskAttr(ctx, node, value);
     else if (STR_AS(key, "filter")) _handleFilterAttr(ctx, node, value);
-    else if (STR_AS(key, "id")) _copyId(&node->id, value);
+    else if (STR_AS(key, "id")) _refId(ctx, &node->id, value);
     else if (STR_AS(key, "class")) _handleCssClassAttr(ctx, node, value);
     else return _parseStyleAttr(ctx, key, value, false);
 
@@ -2621,13 +2646,13 @@ static bool _attrParseRadialGradientNode(void* data, const char* key, const char
     }
 
     if (STR_AS(key, "id")) {
-        _copyId(&grad->id, value);
+        _refId(ctx, &grad->id, value);
     } else if (STR_AS(key, "spreadMethod")) {
         grad->spread = _parseSpreadValue(value);
         grad->flags = (grad->flags | SvgGradientFlags::SpreadMethod);
     } else if (STR_AS(key, "href") || STR_AS(key, "xlink:href")) {
-        if (value) tvg::free(grad->ref);
-        grad->ref = _idFromHref(value);
+        if (value) ctx->release(grad->ref);
+        grad->ref = _idFromHref(ctx, value);
     } else if (STR_AS(key, "gradientUnits")) {
         if (STR_AS(value, "userSpaceOnUse")) grad->userSpace = true;
         grad->flags = (grad->flags | SvgGradientFlags::GradientUnits);
@@ -2663,7 +2688,7 @@ static SvgStyleGradient* _createRadialGradient(SvgParserContext* ctx, const char
 
     ctx->parser->gradient.parsedFx = false;
     ctx->parser->gradient.parsedFy = false;
-    xmlParseAttributes(buf, bufLength, _attrParseRadialGradientNode, ctx);
+    _parseAttributes(buf, bufLength, _attrParseRadialGradientNode, ctx);
 
     for (unsigned int i = 0; i < sizeof(radialTags) / sizeof(radialTags[0]); i++) {
         radialTags[i].tagRecalc(ctx, &grad->radial, grad->userSpace);
@@ -2886,13 +2911,13 @@ static bool _attrParseLinearGradientNode(void* data, const char* key, const char
     }
 
     if (STR_AS(key, "id")) {
-        _copyId(&grad->id, value);
+        _refId(ctx, &grad->id, value);
     } else if (STR_AS(key, "spreadMethod")) {
         grad->spread = _parseSpreadValue(value);
         grad->flags = (grad->flags | SvgGradientFlags::SpreadMethod);
     } else if (STR_AS(key, "href") || STR_AS(key, "xlink:href")) {
-        if (value) tvg::free(grad->ref);
-        grad->ref = _idFromHref(value);
+        if (value) ctx->release(grad->ref);
+        grad->ref = _idFromHref(ctx, value);
     } else if (STR_AS(key, "gradientUnits")) {
         if (STR_AS(value, "userSpaceOnUse")) grad->userSpace = true;
         grad->flags = (grad->flags | SvgGradientFlags::GradientUnits);
@@ -2917,7 +2942,7 @@ static SvgStyleGradient* _createLinearGradient(SvgParserContext* ctx, const char
     grad->linear.x2 = 1.0f;
     grad->linear.isX2Percentage = true;
 
-    xmlParseAttributes(buf, bufLength, _attrParseLinearGradientNode, ctx);
+    _parseAttributes(buf, bufLength, _attrParseLinearGradientNode, ctx);
 
     for (unsigned int i = 0; i < sizeof(linear_tags) / sizeof(linear_tags[0]); i++) {
         linear_tags[i].tagRecalc(ctx, &grad->linear, grad->userSpace);
@@ -3284,8 +3309,10 @@ static void _cloneNode(SvgNode* from, SvgNode* parent, int depth)
 }
 
 
-static void _clonePostponedNodes(Inlist<SvgNodeIdPair>* cloneNodes, SvgNode* doc)
+static void _clonePostponedNodes(SvgParserContext* ctx)
 {
+    auto cloneNodes = &ctx->cloneNodes;
+    auto doc = ctx->doc;
     uint32_t cloneNodesCount = cloneNodes->count;
     uint32_t postponeCount = 0;
     auto nodeIdPair = cloneNodes->front();
@@ -3293,7 +3320,7 @@ static void _clonePostponedNodes(Inlist<SvgNodeIdPair>* cloneNodes, SvgNode* doc
         if (postponeCount >= cloneNodesCount) {
             do {
                 TVGERR("SVG", "Circular use reference detected, discarding '%s'.", nodeIdPair->id ? nodeIdPair->id : "");
-                tvg::free(nodeIdPair->id);
+                ctx->release(nodeIdPair->id);
                 tvg::free(nodeIdPair);
             } while ((nodeIdPair = cloneNodes->front()));
             break;
@@ -3318,7 +3345,7 @@ static void _clonePostponedNodes(Inlist<SvgNodeIdPair>* cloneNodes, SvgNode* doc
                 if (nodeFrom && nodeFrom->type == SvgNodeType::Symbol && nodeIdPair->node->type == SvgNodeType::Use) {
                     nodeIdPair->node->node.use.symbol = nodeFrom;
                 }
-                tvg::free(nodeIdPair->id);
+                ctx->release(nodeIdPair->id);
                 tvg::free(nodeIdPair);
                 postponeCount = 0;
                 --cloneNodesCount;
@@ -3327,7 +3354,7 @@ static void _clonePostponedNodes(Inlist<SvgNodeIdPair>* cloneNodes, SvgNode* doc
             }
         } else {
             TVGLOG("SVG", "%s is ancestor element. This reference is invalid.", nodeIdPair->id);
-            tvg::free(nodeIdPair->id);
+            ctx->release(nodeIdPair->id);
             tvg::free(nodeIdPair);
             postponeCount = 0;
             --cloneNodesCount;
@@ -3453,7 +3480,7 @@ static void _svgLoaderParserXmlOpen(SvgParserContext* ctx, const char* content,
         }
         ctx->parser->gradStop = {0.0f, 0, 0, 0, 255};
         ctx->parser->flags = SvgStopStyleFlags::StopDefault;
-        xmlParseAttributes(attrs, attrsLength, _attrParseStops, ctx);
+        _parseAttributes(attrs, attrsLength, _attrParseStops, ctx);
         ctx->gradientStack.last()->stops.push(ctx->parser->gradStop);
         if (!empty) ctx->gradientStack.push(nullptr);
         return;
@@ -3470,7 +3497,7 @@ static void _svgLoaderParserXmlOpen(SvgParserContext* ctx, const char* content,
         if (empty) return;
         if (!ctx->doc) {
             if (!STR_AS(tagName, "svg")) return; //Not a valid svg document
-            node = method(ctx, nullptr, attrs, attrsLength, xmlParseAttributes);
+            node = method(ctx, nullptr, attrs, attrsLength, _parseAttributes);
             ctx->doc = node;
         } else {
             if (STR_AS(tagName, "svg")) {
@@ -3483,13 +3510,13 @@ static void _svgLoaderParserXmlOpen(SvgParserContext* ctx, const char* content,
                 // TODO: For now only the first style node is saved. After the css id selector
                 // is introduced this if condition shouldn't be necessary any more
                 if (!ctx->cssStyle) {
-                    node = method(ctx, nullptr, attrs, attrsLength, xmlParseAttributes);
+                    node = method(ctx, nullptr, attrs, attrsLength, _parseAttributes);
                     ctx->cssStyle = node;
                     ctx->doc->node.doc.style = node;
                     ctx->openedTag = OpenedTagType::Style;
                 }
             } else {
-                node = method(ctx, parent, attrs, attrsLength, xmlParseAttributes);
+                node = method(ctx, parent, attrs, attrsLength, _parseAttributes);
             }
         }
 
@@ -3499,12 +3526,12 @@ static void _svgLoaderParserXmlOpen(SvgParserContext* ctx, const char* content,
         }
     } else if (ctx->openedTag == OpenedTagType::Text && STR_AS(tagName, "tspan")) {
         parent = ctx->parser->node;
-        node = _createTspanNode(ctx, parent, attrs, attrsLength, xmlParseAttributes);
+        node = _createTspanNode(ctx, parent, attrs, attrsLength, _parseAttributes);
         if (empty) ctx->parser->node = parent;
     } else if ((method = _findGraphicsFactory(tagName))) {
         if (ctx->stack.count > 0) parent = ctx->stack.last();
         else parent = ctx->doc;
-        node = method(ctx, parent, attrs, attrsLength, xmlParseAttributes);
+        node = method(ctx, parent, attrs, attrsLength, _parseAttributes);
         if (node && !empty) {
             if (STR_AS(tagName, "text")) ctx->openedTag = OpenedTagType::Text;
             auto defs = _createDefsNode(ctx, nullptr, nullptr, 0, nullptr);
@@ -3579,7 +3606,7 @@ static char* _parseName(char* str, const char* delims, char** saveptr)
 
 
 
-static void _free(SvgStyleProperty* style)
+static void _free(const SvgParserContext* ctx, SvgStyleProperty* style)
 {
     if (!style) return;
 
@@ -3587,14 +3614,14 @@ static void _free(SvgStyleProperty* style)
     tvg::free(style->clipPath.url);
     tvg::free(style->mask.url);
     tvg::free(style->filter.url);
-    tvg::free(style->cssClass);
+    ctx->release(style->cssClass);
 
     if (style->fill.paint.gradient) {
-        style->fill.paint.gradient->clear();
+        style->fill.paint.gradient->clear(ctx);
         tvg::free(style->fill.paint.gradient);
     }
     if (style->stroke.paint.gradient) {
-        style->stroke.paint.gradient->clear();
+        style->stroke.paint.gradient->clear(ctx);
         tvg::free(style->stroke.paint.gradient);
     }
     tvg::free(style->fill.paint.url);
@@ -3604,19 +3631,19 @@ static void _free(SvgStyleProperty* style)
 }
 
 
-static void _free(SvgNode* node)
+static void _free(const SvgParserContext* ctx, SvgNode* node)
 {
     if (!node) return;
 
-    ARRAY_FOREACH(p, node->child) _free(*p);
+    ARRAY_FOREACH(p, node->child) _free(ctx, *p);
     node->child.reset();
 
-    tvg::free(node->id);
+    ctx->release(node->id);
     tvg::free(node->transform);
-    _free(node->style);
+    _free(ctx, node->style);
     switch (node->type) {
          case SvgNodeType::Path: {
-             tvg::free(node->node.path.path);
+             ctx->release(node->node.path.path);
              break;
          }
          case SvgNodeType::Polygon: {
@@ -3628,20 +3655,20 @@ static void _free(SvgNode* node)
              break;
          }
          case SvgNodeType::Doc: {
-             _free(node->node.doc.defs);
-             _free(node->node.doc.style);
+             _free(ctx, node->node.doc.defs);
+             _free(ctx, node->node.doc.style);
              break;
          }
          case SvgNodeType::Defs: {
             ARRAY_FOREACH(p, node->node.defs.gradients) {
-                 (*p)->clear();
+                 (*p)->clear(ctx);
                  tvg::free(*p);
              }
              node->node.defs.gradients.reset();
              break;
          }
          case SvgNodeType::Image: {
-             tvg::free(node->node.image.href);
+             ctx->release(node->node.image.href);
              break;
          }
          case SvgNodeType::Tspan:
@@ -3662,7 +3689,7 @@ static void _free(SvgNode* node)
 }
 
 
-static bool _cssApplyClass(SvgNode* node, const char* classString, SvgNode* styleRoot)
+static bool _cssApplyClass(const SvgParserContext* ctx, SvgNode* node, const char* classString, SvgNode* styleRoot)
 {
     if (!classString || !styleRoot) return false;
 
@@ -3712,17 +3739,17 @@ static bool _cssApplyClass(SvgNode* node, const char* classString, SvgNode* styl
 
     //Apply the merged style to the node (without overwriting existing styles)
     cssCopyStyleAttr(node, tempNode);
-    _free(tempNode);
+    _free(ctx, tempNode);
 
     return allFound;
 }
 
 
-static void _cssApplyStyleToPostponeds(Array<SvgNodeIdPair>& postponeds, SvgNode* style)
+static void _cssApplyStyleToPostponeds(const SvgParserContext* ctx, Array<SvgNodeIdPair>& postponeds, SvgNode* style)
 {
     ARRAY_FOREACH(p, postponeds) {
         auto node = p->node;
-        _cssApplyClass(node, node->style->cssClass, style);
+        _cssApplyClass(ctx, node, node->style->cssClass, style);
     }
 }
 
@@ -3866,7 +3893,7 @@ static void _updateGradient(SvgParserContext* ctx, SvgNode* node, Array<SvgStyle
             auto newGrad = duplicate(ctx, gradients, node->style->fill.paint.url);
             if (newGrad) {
                 if (node->style->fill.paint.gradient) {
-                    node->style->fill.paint.gradient->clear();
+                    node->style->fill.paint.gradient->clear(ctx);
                     tvg::free(node->style->fill.paint.gradient);
                 }
                 node->style->fill.paint.gradient = newGrad;
@@ -3876,7 +3903,7 @@ static void _updateGradient(SvgParserContext* ctx, SvgNode* node, Array<SvgStyle
             auto newGrad = duplicate(ctx, gradients, node->style->stroke.paint.url);
             if (newGrad) {
                 if (node->style->stroke.paint.gradient) {
-                    node->style->stroke.paint.gradient->clear();
+                    node->style->stroke.paint.gradient->clear(ctx);
                     tvg::free(node->style->stroke.paint.gradient);
                 }
                 node->style->stroke.paint.gradient = newGrad;
@@ -3952,7 +3979,7 @@ static bool _svgLoaderParserForValidCheckXmlOpen(SvgParserContext* ctx, const ch
     if ((method = _findGroupFactory(tagName))) {
         if (!ctx->doc) {
             if (!STR_AS(tagName, "svg")) return true; //Not a valid svg document
-            node = method(ctx, nullptr, attrs, attrsLength, xmlParseAttributes);
+            node = method(ctx, nullptr, attrs, attrsLength, _parseAttributes);
             ctx->doc = node;
             ctx->stack.push(node);
             return false;
@@ -3975,13 +4002,109 @@ static bool _svgLoaderParserForValidCheck(void* data, XMLType type, const char*
 }
 
 
+#ifdef THORVG_FILE_IO_SUPPORT
+
+/* The document is mapped privately with copy-on-write pages, so the parser can tokenize it in place.
+   The zero-filled tail of the last page terminates the text, thus a file which fills up
+   its last page entirely is read in the ordinary way. */
+
+#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+
+static char* _map(SvgLoader* loader, const char* path, uint32_t& size)
+{
+    auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, 0, NULL);
+    if (file == INVALID_HANDLE_VALUE) return nullptr;
+
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+
+    DWORD high;
+    auto low = GetFileSize(file, &high);
+    if (low == INVALID_FILE_SIZE || high > 0 || low == 0 || low % info.dwPageSize == 0) {
+        CloseHandle(file);
+        return nullptr;
+    }
+
+    loader->mapping = CreateFileMapping(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+
+    CloseHandle(file);
+
+    if (!loader->mapping) return nullptr;
+
+    auto data = (char*)MapViewOfFile(loader->mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (!data) {
+        CloseHandle(loader->mapping);
+        loader->mapping = nullptr;
+        return nullptr;
+    }
+    size = low;
+    return data;
+}
+
+static void _unmap(SvgLoader* loader)
+{
+    UnmapViewOfFile(loader->content);
+    CloseHandle(loader->mapping);
+    loader->mapping = nullptr;
+}
+
+#elif defined(__linux__)
+
+static char* _map(TVG_UNUSED SvgLoader* loader, const char* path, uint32_t& size)
+{
+    auto fd = open(path, O_RDONLY);
+    if (fd < 0) return nullptr;
+
+    struct stat info;
+    if (fstat(fd, &info) < 0 || info.st_size == 0 || info.st_size > UINT32_MAX || info.st_size % sysconf(_SC_PAGESIZE) == 0) {
+        close(fd);
+        return nullptr;
+    }
+
+    auto data = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if (data == MAP_FAILED) return nullptr;
+    size = (uint32_t)info.st_size;
+
+    return (char*)data;
+}
+
+static void _unmap(SvgLoader* loader)
+{
+    munmap(loader->content, loader->size);
+}
+
+#else
+
+static char* _map(TVG_UNUSED SvgLoader* loader, TVG_UNUSED const char* path, TVG_UNUSED uint32_t& size)
+{
+    return nullptr;
+}
+
+static void _unmap(TVG_UNUSED SvgLoader* loader)
+{
+}
+
+#endif
+
+#endif //THORVG_FILE_IO_SUPPORT
+
+
 void SvgLoader::clear(bool all)
 {
     ctx.clear(all);
+    ctx.content = nullptr;
+    ctx.size = 0;
 
     if (!all) return;
 
-    if (owner != Ownership::Borrow) tvg::free((char*)content);
+    if (mapped) {
+#ifdef THORVG_FILE_IO_SUPPORT
+        _unmap(this);
+#endif
+        mapped = false;
+    } else if (owner != Ownership::Borrow) tvg::free((char*)content);
 
     if (root) {
         root->unref();
@@ -3998,19 +4121,26 @@ void SvgLoader::run(unsigned tid)
 {
     if (!ctx.parser) return;
 
+    TVGTRACE("SvgLoader::run");
+
     //According to the SVG standard the value of the width/height of the viewbox set to 0 disables rendering
     if ((viewFlag & SvgViewFlag::Viewbox) && (fabsf(vbox.w) <= FLOAT_EPSILON || fabsf(vbox.h) <= FLOAT_EPSILON)) {
         TVGLOG("SVG", "The <viewBox> width and/or height set to 0 - rendering disabled.");
         root = Scene::gen();
     } else {
+        //the loader owns a writable copy of the document, tokenize it in place
+        if (owner != Ownership::Borrow) {
+            ctx.content = content;
+            ctx.size = size;
+        }
         if (xmlParse(content, size, true, _svgLoaderParser, &(ctx))) {
             if (ctx.doc) {
                 auto defs = ctx.doc->node.doc.defs;
 
-                if (ctx.nodesToStyle.count > 0) _cssApplyStyleToPostponeds(ctx.nodesToStyle, ctx.cssStyle);
+                if (ctx.nodesToStyle.count > 0) _cssApplyStyleToPostponeds(&ctx, ctx.nodesToStyle, ctx.cssStyle);
                 if (ctx.cssStyle) cssUpdateStyle(ctx.doc, ctx.cssStyle);
 
-                if (!ctx.cloneNodes.empty()) _clonePostponedNodes(&ctx.cloneNodes, ctx.doc);
+                if (!ctx.cloneNodes.empty()) _clonePostponedNodes(&ctx);
 
                 _updateComposite(ctx.doc, ctx.doc);
                 if (defs) _updateComposite(ctx.doc, defs);
@@ -4053,24 +4183,37 @@ void SvgLoader::run(unsigned tid)
 /* External Class Implementation                                        */
 /************************************************************************/
 
+void SvgStyleGradient::clear(const SvgParserContext* ctx)
+{
+    stops.reset();
+    tvg::free(transform);
+    ctx->release(ref);
+    ctx->release(id);
+}
+
+
 void SvgParserContext::clear(bool all)
 {
     tvg::free(parser);
     parser = nullptr;
 
     ARRAY_FOREACH(p, gradients) {
-        (*p)->clear();
+        (*p)->clear(this);
         tvg::free(*p);
     }
     gradients.reset();
     gradientStack.reset();
 
-    _free(doc);
+    _free(this, doc);
     doc = nullptr;
     stack.reset();
 
     if (!all) return;
 
+    ARRAY_FOREACH(p, builders) {
+        (*p)->done();
+        delete(*p);
+    }
     ARRAY_FOREACH(p, images) {
         tvg::free(*p);
     }
@@ -4093,6 +4236,8 @@ SvgLoader::~SvgLoader()
 
 Result SvgLoader::header()
 {
+    TVGTRACE("SvgLoader::header");
+
     //For valid check, only <svg> tag is parsed first.
     //If the <svg> tag is found, the loaded file is valid and stores viewbox information.
     //After that, the remaining content data is parsed in order with async.
@@ -4182,7 +4327,10 @@ Result SvgLoader::open(const char* path, const LoaderOps& ops)
 #ifdef THORVG_FILE_IO_SUPPORT
     if (ops.caller != tvg::Type::Picture) return Result::InvalidArguments;
 
-    if ((content = Loader::open(path, size, true))) {
+    if ((content = _map(this, path, size))) mapped = true;
+    else content = Loader::open(path, size, true);
+
+    if (content) {
         ctx.accessible = static_cast<const PictureOps*>(&ops)->accessible;
         owner = Ownership::Transfer;
         return header();
@@ -28,11 +28,15 @@
 
 struct SvgLoader : ImageLoader, Task
 {
+#if defined(_WIN32) && (WINAPI_FAMILY == WINAPI_FAMILY_DESKTOP_APP)
+    void* mapping = nullptr;
+#endif
     SvgParserContext ctx;
     string svgPath = "";
     char* content = nullptr;
     uint32_t size = 0;
     Scene* root = nullptr;
+    bool mapped = false;  // content is a memory-mapped file
 
     SvgLoader() : ImageLoader(FileType::Svg) {}
     ~SvgLoader();
@@ -22,6 +22,7 @@
 
 #include <ctype.h>
 #include "tvgStr.h"
+#include "tvgTrace.h"
 #include "tvgXmlParser.h"
 #include "tvgSvgUtil.h"
 
@@ -110,6 +111,15 @@ static unsigned _xmlDecodeEntities(const char* itr, const char* itrEnd, char* de
     return dst - decoded;
 }
 
+//The closing quote might have been replaced by the terminator of an in-place tokenized value.
+static const char* _xmlFindQuote(const char* itr, const char* itrEnd, char quote)
+{
+    for (; itr < itrEnd; itr++) {
+        if (*itr == quote || *itr == '\0') return itr;
+    }
+    return nullptr;
+}
+
 static const char* _xmlFindStartTag(const char* itr, const char* itrEnd)
 {
     return (const char*)memchr(itr, '<', itrEnd - itr);
@@ -244,7 +254,7 @@ bool isIgnoreUnsupportedLogElements(TVG_UNUSED const char* tagName)
 }
 
 
-bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data)
+bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data, bool inplace)
 {
     if (!buf || !func) return false;
 
@@ -255,7 +265,7 @@ bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func
 
     while (itr < itrEnd) {
         const char* p = svgUtilSkipWhiteSpace(itr, itrEnd);
-        const char *key, *keyEnd, *value, *valueEnd;
+        const char *key, *keyEnd, *value, *valueEnd, *quote = nullptr;
         char* tval;
 
         if (p == itrEnd) goto success;
@@ -280,7 +290,7 @@ bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func
         if (value == itrEnd) goto error;
 
         if ((*value == '"') || (*value == '\'')) {
-            valueEnd = (const char*)memchr(value + 1, *value, itrEnd - value - 1);
+            valueEnd = quote = _xmlFindQuote(value + 1, itrEnd, *value);
             if (!valueEnd) goto error;
             value++;
         } else {
@@ -295,12 +305,18 @@ bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func
         memcpy(tmpBuf, key, keyEnd - key);
         tmpBuf[keyEnd - key] = '\0';
 
-        tval = tmpBuf + (keyEnd - key) + 1;
-        auto decodedLength = _xmlDecodeEntities(value, valueEnd, tval);
-        if (decodedLength) {
-            auto decodedEnd = svgUtilUnskipWhiteSpace(tval + decodedLength, tval);
-            *const_cast<char*>(decodedEnd) = '\0';
-            tval = const_cast<char*>(svgUtilSkipWhiteSpace(tval, decodedEnd));
+        //zero-copy: in a writable buffer, a quoted value without entities is terminated at its closing quote
+        if (inplace && valueEnd == quote && !memchr(value, '&', valueEnd - value)) {
+            tval = const_cast<char*>(value);
+            *const_cast<char*>(valueEnd) = '\0';
+        } else {
+            tval = tmpBuf + (keyEnd - key) + 1;
+            auto decodedLength = _xmlDecodeEntities(value, valueEnd, tval);
+            if (decodedLength) {
+                auto decodedEnd = svgUtilUnskipWhiteSpace(tval + decodedLength, tval);
+                *const_cast<char*>(decodedEnd) = '\0';
+                tval = const_cast<char*>(svgUtilSkipWhiteSpace(tval, decodedEnd));
+            }
         }
 
         if (!func((void*)data, tmpBuf, tval)) {
@@ -322,6 +338,8 @@ error:
 
 bool xmlParse(const char* buf, unsigned bufLength, bool strip, xmlCb func, const void* data)
 {
+    TVGTRACE("xmlParse");
+
     const char *itr = buf, *itrEnd = buf + bufLength;
 
     while (itr < itrEnd) {
@@ -43,7 +43,7 @@ enum class XMLType
 typedef bool (*xmlCb)(void* data, XMLType type, const char* content, unsigned int length);
 typedef bool (*xmlAttributeCb)(void* data, const char* key, const char* value);
 
-bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data);
+bool xmlParseAttributes(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data, bool inplace);
 bool xmlParse(const char* buf, unsigned bufLength, bool strip, xmlCb func, const void* data);
 bool xmlParseW3CAttribute(const char* buf, unsigned bufLength, xmlAttributeCb func, const void* data);
 const char* xmlParseCSSAttribute(const char* buf, unsigned bufLength, char** tag, char** name, const char** attrs, unsigned* attrsLength);
@@ -536,13 +536,15 @@ static VP8StatusCode DecodeInto(const uint8_t* const data, size_t data_size,
 
 static uint8_t* Decode(WEBP_CSP_MODE mode, const uint8_t* const data,
                        size_t data_size, int* const width, int* const height,
-                       WebPDecBuffer* const keep_info) {
+                       WebPDecBuffer* const keep_info,
+                       const WebPDecoderOptions* const options = NULL) {
   WebPDecParams params;
   WebPDecBuffer output;
 
   WebPInitDecBuffer(&output);
   memset(&params, 0, sizeof(params));
   params.output = &output;
+  params.options = options;
   output.colorspace = mode;
 
   // Retrieve (and report back) the required dimensions from bitstream.
@@ -644,6 +646,18 @@ uint8_t* WebPDecodeRGBA(const uint8_t* data, size_t data_size,
   return Decode(MODE_rgbA, data, data_size, width, height, NULL);
 }
 
+uint8_t* WebPDecodeArea(const uint8_t* data, size_t data_size, int bgra,
+                        int left, int top, int width, int height) {
+  WebPDecoderOptions options;
+  memset(&options, 0, sizeof(options));
+  options.use_cropping = 1;
+  options.crop_left = left;
+  options.crop_top = top;
+  options.crop_width = width;
+  options.crop_height = height;
+  return Decode(bgra ? MODE_bgrA : MODE_rgbA, data, data_size, NULL, NULL, NULL, &options);
+}
+
 int WebPGetInfo(const uint8_t* data, size_t data_size,
                 int* width, int* height) {
   WebPBitstreamFeatures features;
@@ -18,6 +18,7 @@
  */
 
 #include "webp/decode.h"
+#include "tvgLoaderMgr.h"
 #include "tvgWebpLoader.h"
 
 
@@ -39,15 +40,20 @@ void WebpLoader::run(unsigned tid)
     uint8_t* buf8;
 
     // static loader WebPDecodeRGBA/WebPDecodeBGRA returns a premultiplied version.
-    if (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S) {
-        buf8 = WebPDecodeBGRA(data, size, nullptr, nullptr);
-        cs = ColorSpace::ARGB8888;
-    } else  {
-        buf8 = WebPDecodeRGBA(data, size, nullptr, nullptr);
-        cs = ColorSpace::ABGR8888;
+    auto bgra = (surface.cs == ColorSpace::ARGB8888 || surface.cs == ColorSpace::ARGB8888S);
+    cs = bgra ? ColorSpace::ARGB8888 : ColorSpace::ABGR8888;
+
+    if (striped) {
+        buf8 = WebPDecodeArea(data, size, bgra, area.sx(), area.sy(), area.sw(), area.sh());
+        surface.setup((pixel_t*)buf8, area.w(), area.w(), area.h(), sizeof(uint32_t), cs);
+        return;
     }
+
+    buf8 = bgra ? WebPDecodeBGRA(data, size, nullptr, nullptr) : WebPDecodeRGBA(data, size, nullptr, nullptr);
     surface.setup((pixel_t*)buf8, static_cast<uint32_t>(w), static_cast<uint32_t>(w), static_cast<uint32_t>(h), sizeof(uint32_t), cs);
-    clear();
+
+    //keep the source data to decode the evicted pixels again, see evict()
+    if (!LoaderMgr::budgeted()) clear();
 }
 
 
@@ -72,6 +78,7 @@ Result WebpLoader::open(const char* path, const LoaderOps& ops)
     if (WebPGetFeatures(data, size, &features)) return Result::InvalidArguments;
     w = static_cast<float>(features.width);
     h = static_cast<float>(features.height);
+    striped = huge(w, h);
     surface.alphaIgnored = !features.has_alpha;
     return Result::Success;
 #else
@@ -93,6 +100,7 @@ Result WebpLoader::open(const char* data, uint32_t size, const LoaderOps& ops)
     if (WebPGetFeatures(this->data, size, &features)) return Result::InvalidArguments;
     w = static_cast<float>(features.width);
     h = static_cast<float>(features.height);
+    striped = huge(w, h);
     surface.alphaIgnored = !features.has_alpha;
     this->size = size;
 
@@ -108,6 +116,9 @@ bool WebpLoader::read()
 
     surface.cs = BitmapLoader::cs;
 
+    //the visible area is not known yet, see BitmapLoader::stripe()
+    if (striped && area.invalid()) return true;
+
     TaskScheduler::request(this);
 
     return true;
@@ -127,3 +138,18 @@ RenderSurface* WebpLoader::bitmap()
     this->done();
     return BitmapLoader::bitmap();
 }
+
+
+bool WebpLoader::evictable()
+{
+    return data != nullptr;
+}
+
+
+void WebpLoader::evict()
+{
+    this->done();
+    tvg::free(surface.buf8);
+    surface.data = nullptr;
+    readied = false;
+}
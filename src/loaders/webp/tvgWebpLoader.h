@@ -34,6 +34,8 @@ struct WebpLoader : BitmapLoader, Task
     bool close() override;
 
     RenderSurface* bitmap() override;
+    bool evictable() override;
+    void evict() override;
 
 private:
     uint8_t* data = nullptr;
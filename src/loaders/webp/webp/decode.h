@@ -57,6 +57,11 @@ WEBP_EXTERN(uint8_t*) WebPDecodeRGBA(const uint8_t* data, size_t data_size,
 WEBP_EXTERN(uint8_t*) WebPDecodeBGRA(const uint8_t* data, size_t data_size,
                                      int* width, int* height);
 
+// Same as WebPDecodeRGBA (or WebPDecodeBGRA if 'bgra' is set), but decodes only
+// the given area of the image. 'left' and 'top' must be even. (thorvg)
+WEBP_EXTERN(uint8_t*) WebPDecodeArea(const uint8_t* data, size_t data_size, int bgra,
+                                     int left, int top, int width, int height);
+
 
 //------------------------------------------------------------------------------
 // Output colorspaces and buffer
@@ -28,10 +28,12 @@
 #include "tvgMath.h"
 #include "tvgColor.h"
 #include "tvgRender.h"
+#include "tvgMap.h"
 
 #define SW_CURVE_TYPE_POINT 0
 #define SW_CURVE_TYPE_CUBIC 1
 #define SW_COLOR_TABLE 1024
+#define SW_SPAN_COMPACT_SIZE 4096   //the rle capacity in spans kept regardless of its usage
 
 struct SwCompositor;
 struct SwSurface;
@@ -253,6 +255,7 @@ struct SwImage
 {
     SwOutline*   outline = nullptr;
     SwRle*   rle = nullptr;
+    RenderMipmap::Level mipmap = {};  //the nearest downscaled level of the source, drawn instead if lod > 0
     union {
         pixel_t*  data;      //system based data pointer
         uint32_t* buf32;     //for explicit 32bits channels
@@ -264,10 +267,17 @@ struct SwImage
     float        scale;
 
     uint8_t      channelSize;
+    uint8_t      lod = 0;        //the level of the mipmap, 1/2^lod of the image size
     FilterMethod filter;
     bool direct = false;  // draw image directly (with offset)
     bool scaled = false;  // draw uniform scaled image
     bool alphaIgnored = false;  // If true, the alpha channel can be ignored.
+
+    //buffer offset of the pixel at (x, y) of the target
+    size_t offset(int32_t x, int32_t y) const
+    {
+        return size_t(y + oy) * stride + (x + ox);
+    }
 };
 
 typedef uint8_t (*SwMask)(uint8_t s, uint8_t d, uint8_t a);                       // src, dst, alpha
@@ -283,6 +293,7 @@ struct SwSurface : RenderSurface
     SwBlender blender = nullptr;          //blender (optional)
     SwCompositor* compositor = nullptr;   //compositor (optional)
     BlendMethod blendMethod = BlendMethod::Normal;
+    RenderRegion region;                  //pixel area backed by the buffer memory
 
     SwAlpha alpha(MaskMethod method)
     {
@@ -295,6 +306,12 @@ struct SwSurface : RenderSurface
         return alphas[2]((uint8_t*)&c);
     }
 
+    //buffer offset of the pixel at (x, y) in the canvas coordinates
+    size_t offset(int32_t x, int32_t y) const
+    {
+        return size_t(y - region.min.y) * stride + (x - region.min.x);
+    }
+
     SwSurface() = default;
 
     SwSurface(const SwSurface* rhs) : RenderSurface(rhs)
@@ -304,6 +321,7 @@ struct SwSurface : RenderSurface
         blender = rhs->blender;
         compositor = rhs->compositor;
         blendMethod = rhs->blendMethod;
+        region = rhs->region;
     }
 };
 
@@ -313,18 +331,68 @@ struct SwCompositor : RenderCompositor
     SwCompositor* recoverCmp;               //Recover compositor when composition is done
     SwImage image;
     RenderRegion bbox;
+    pixel_t* buffer = nullptr;              //pooled storage of a region-sized target
+    uint32_t capacity = 0;                  //pooled storage size in pixels, 0 for a canvas-sized square target
     bool valid;
 };
 
 struct SwCellPool
 {
     #define DEFAULT_POOL_SIZE 16368
+    #define SW_CELL_POOL_LIMIT (1 << 20)    //the larger shapes are rasterized in bands
 
     uint32_t size;
     SwCell* buffer;
+    uint32_t margin = 0;    //extra demand in percent, raised by the overflows
+    uint32_t retries = 0;   //the band splits of the current task
 
     SwCellPool() : size(DEFAULT_POOL_SIZE), buffer(tvg::malloc<SwCell>(DEFAULT_POOL_SIZE)) {}
     ~SwCellPool() { tvg::free(buffer); }
+
+    void grow(size_t reqSize)
+    {
+        if (reqSize <= size || size >= SW_CELL_POOL_LIMIT) return;
+        //grow by 1.25x up to the limit and align to multiple of sizeof(SwCell)
+        auto grown = std::min(reqSize + (reqSize >> 2), size_t(SW_CELL_POOL_LIMIT));
+        size = uint32_t((grown / sizeof(SwCell)) * sizeof(SwCell));
+        tvg::free(buffer);
+        buffer = tvg::malloc<SwCell>(size);
+    }
+
+    void overflow()
+    {
+        if (margin < 200) margin += 25;
+    }
+};
+
+//A glyph coverage rasterized at a subpixel position, spans are relative to the integer glyph origin
+struct SwGlyph
+{
+    uint32_t font, idx;
+    float sx, sy;           //glyph scale
+    uint8_t subpixel;       //quantized fraction of the glyph origin, x in the lower 4 bits
+    SwRle* rle;
+    RenderRegion bbox;
+};
+
+struct SwGlyphCache
+{
+    #define SW_GLYPH_CACHE_SIZE 1024
+
+    Array<SwGlyph> glyphs;
+    Map<uint64_t, uint32_t> index{SW_GLYPH_CACHE_SIZE};   //key hash to the glyph
+
+    ~SwGlyphCache()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        ARRAY_FOREACH(p, glyphs) delete(p->rle);
+        glyphs.clear();
+        index.clear();
+    }
 };
 
 struct SwMpool
@@ -333,6 +401,10 @@ struct SwMpool
     SwStrokeBorder* lBorders;
     SwStrokeBorder* rBorders;
     SwCellPool* cellPools;
+    SwGlyphCache* glyphCaches;
+    RenderPath* paths;          //scratch for the trimmed paths
+    Array<uint8_t>* covers;     //scratch for the glyph coverages
+    Array<SwSpan>* spanSlabs;   //scratch for the rle generation
 
     SwMpool(uint32_t threads)
     {
@@ -341,6 +413,10 @@ struct SwMpool
         lBorders = new SwStrokeBorder[allocSize];
         rBorders = new SwStrokeBorder[allocSize];
         cellPools = new SwCellPool[allocSize];
+        glyphCaches = new SwGlyphCache[allocSize];
+        paths = new RenderPath[allocSize];
+        covers = new Array<uint8_t>[allocSize];
+        spanSlabs = new Array<SwSpan>[allocSize];
     }
 
     ~SwMpool()
@@ -349,6 +425,29 @@ struct SwMpool
         delete[] (lBorders);
         delete[] (rBorders);
         delete[] (cellPools);
+        delete[] (glyphCaches);
+        delete[] (paths);
+        delete[] (covers);
+        delete[] (spanSlabs);
+    }
+
+    RenderPath* path(unsigned idx)
+    {
+        paths[idx].clear();
+        return &paths[idx];
+    }
+
+    Array<SwSpan>* spans(unsigned idx)
+    {
+        spanSlabs[idx].clear();
+        return &spanSlabs[idx];
+    }
+
+    uint8_t* cover(unsigned idx, uint32_t size)
+    {
+        covers[idx].reserve(size);
+        memset(covers[idx].data, 0, size);
+        return covers[idx].data;
     }
 
     SwCellPool* cell(unsigned idx)
@@ -356,6 +455,11 @@ struct SwMpool
         return &cellPools[idx];
     }
 
+    SwGlyphCache* glyphs(unsigned idx)
+    {
+        return &glyphCaches[idx];
+    }
+
     SwOutline* outline(unsigned idx)
     {
         outlines[idx].in.clear();
@@ -478,6 +582,7 @@ bool imagePrepare(SwImage& image, const Matrix& transform, const RenderRegion& c
 bool imageGenRle(SwImage& image, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias);
 void imageReset(SwImage& image);
 void imageFree(SwImage& image);
+void imageMipmap(SwImage& image, RenderSurface* source);
 
 bool fillGenColorTable(SwFill* fill, const Fill* fdata, const Matrix& transform, SwSurface* surface, uint8_t opacity, bool ctable);
 const Fill::ColorStop* fillFetchSolid(const SwFill* fill, const Fill* fdata);
@@ -501,8 +606,9 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
 SwRle* rleRender(const RenderRegion* bbox);
 void rleFree(SwRle* rle);
 void rleReset(SwRle* rle);
+void rleTranslate(SwRle* rle, int32_t x, int32_t y);
 void rleMerge(SwRle* rle, SwRle* clip1, SwRle* clip2);
-bool rleClip(SwRle* rle, const SwRle* clip);
+bool rleClip(SwRle* rle, const SwRle* clip, SwMpool* mpool, unsigned tid);
 bool rleClip(SwRle* rle, const RenderRegion* clip);
 bool rleIntersect(const SwRle* rle, const RenderRegion& region);
 
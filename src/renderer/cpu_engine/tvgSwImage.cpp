@@ -57,6 +57,25 @@ static SwOutline* _genOutline(SwImage& image, SwMpool* mpool, unsigned tid)
     return outline;
 }
 
+
+//2x2 box filter, the odd edges are clamped
+static void _halve(const uint32_t* src, uint32_t sw, uint32_t sh, uint32_t sstride, uint32_t* dst, uint32_t dw, uint32_t dh)
+{
+    for (uint32_t y = 0; y < dh; ++y, dst += dw) {
+        auto row1 = src + (y * 2) * sstride;
+        auto row2 = (y * 2 + 1 < sh) ? row1 + sstride : row1;
+        for (uint32_t x = 0; x < dw; ++x) {
+            auto x1 = x * 2;
+            auto x2 = (x1 + 1 < sw) ? x1 + 1 : x1;
+            auto p1 = row1[x1], p2 = row1[x2], p3 = row2[x1], p4 = row2[x2];
+            //two channels per lane, the 4 samples sum fits in 10 bits
+            auto rb = (p1 & 0x00ff00ff) + (p2 & 0x00ff00ff) + (p3 & 0x00ff00ff) + (p4 & 0x00ff00ff) + 0x00020002;
+            auto ag = ((p1 >> 8) & 0x00ff00ff) + ((p2 >> 8) & 0x00ff00ff) + ((p3 >> 8) & 0x00ff00ff) + ((p4 >> 8) & 0x00ff00ff) + 0x00020002;
+            dst[x] = ((rb >> 2) & 0x00ff00ff) | (((ag >> 2) & 0x00ff00ff) << 8);
+        }
+    }
+}
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -99,3 +118,43 @@ void imageFree(SwImage& image)
     rleFree(image.rle);
     image.rle = nullptr;
 }
+
+
+void imageMipmap(SwImage& image, RenderSurface* source)
+{
+    image.lod = 0;
+
+    //only the minified bilinear sampling takes the levels
+    if (!image.scaled || image.filter != FilterMethod::Bilinear || image.channelSize != sizeof(uint32_t) || image.scale >= 0.5f) return;
+
+    //the nearest level keeping the remaining scale in [0.5, 1)
+    uint32_t count = 0;
+    for (auto scale = image.scale; scale * 2.0f <= 1.0f; scale *= 2.0f) ++count;
+
+    //the pictures sharing the source share its levels, lazily build the missing ones downward from the last one
+    ScopedLock lock(source->key);
+    if (!source->mipmap) source->mipmap = new RenderMipmap;
+    auto& levels = source->mipmap->levels;
+
+    while (levels.count < count) {
+        auto src = image.buf32;
+        auto sw = image.w, sh = image.h, sstride = image.stride;
+        if (!levels.empty()) {
+            auto& last = levels.last();
+            src = last.data;
+            sw = sstride = last.w;
+            sh = last.h;
+        }
+        if (sw == 1 && sh == 1) break;
+        RenderMipmap::Level level;
+        level.w = (sw + 1) / 2;
+        level.h = (sh + 1) / 2;
+        level.data = tvg::malloc<uint32_t>(sizeof(uint32_t) * level.w * level.h);
+        _halve(src, sw, sh, sstride, level.data, level.w, level.h);
+        levels.push(level);
+    }
+
+    //keep the level itself, the other pictures may grow the levels while this one is drawn
+    image.lod = std::min(count, levels.count);
+    if (image.lod > 0) image.mipmap = levels[image.lod - 1];
+}
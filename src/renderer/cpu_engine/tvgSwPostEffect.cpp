@@ -290,11 +290,9 @@ static void _shift(uint32_t** dst, uint32_t** src, int dstride, int sstride, int
 }
 
 
+//dst and src point to the top-left corner of the bbox
 static void _dropShadowNoFilter(uint32_t* dst, uint32_t* src, int dstride, int sstride, int dw, int dh, const RenderRegion& bbox, const SwPoint& offset, uint32_t color, uint8_t opacity, bool direct)
 {
-    src += (bbox.min.y * sstride + bbox.min.x);
-    dst += (bbox.min.y * dstride + bbox.min.x);
-
     SwSize size;
     _shift(&dst, &src, dstride, sstride, dw, dh, bbox, offset, size);
 
@@ -317,12 +315,13 @@ static void _dropShadowNoFilter(SwImage* dimg, SwImage* simg, const RenderRegion
     int dstride = dimg->stride;
     int sstride = simg->stride;
 
+    auto src = simg->buf32 + simg->offset(bbox.min.x, bbox.min.y);
+    auto dst = dimg->buf32 + dimg->offset(bbox.min.x, bbox.min.y);
+
     //shadow image
-    _dropShadowNoFilter(dimg->buf32, simg->buf32, dstride, sstride, dimg->w, dimg->h, bbox, offset, color, 255, false);
+    _dropShadowNoFilter(dst, src, dstride, sstride, dimg->w, dimg->h, bbox, offset, color, 255, false);
 
     //original image
-    auto src = simg->buf32 + (bbox.min.y * sstride + bbox.min.x);
-    auto dst = dimg->buf32 + (bbox.min.y * dstride + bbox.min.x);
 
     for (auto y = 0; y < (bbox.max.y - bbox.min.y); ++y) {
         auto s = src;
@@ -336,11 +335,9 @@ static void _dropShadowNoFilter(SwImage* dimg, SwImage* simg, const RenderRegion
 }
 
 
+//dst and src point to the top-left corner of the bbox
 static void _dropShadowShift(uint32_t* dst, uint32_t* src, int dstride, int sstride, int dw, int dh, const RenderRegion& bbox, const SwPoint& offset, uint8_t opacity, bool direct)
 {
-    src += (bbox.min.y * sstride + bbox.min.x);
-    dst += (bbox.min.y * dstride + bbox.min.x);
-
     SwSize size;
     _shift(&dst, &src, dstride, sstride, dw, dh, bbox, offset, size);
 
@@ -424,7 +421,7 @@ bool effectDropShadow(SwCompositor* cmp, SwSurface* surface[2], const RenderEffe
     //no filter required
     if (data->extends == 0)  {
         if (direct) {
-            _dropShadowNoFilter(cmp->recoverSfc->buf32, cmp->image.buf32, cmp->recoverSfc->stride, cmp->image.stride, cmp->recoverSfc->w, cmp->recoverSfc->h, bbox, data->offset, color, opacity, direct);
+            _dropShadowNoFilter(cmp->recoverSfc->buf32 + cmp->recoverSfc->offset(bbox.min.x, bbox.min.y), cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y), cmp->recoverSfc->stride, cmp->image.stride, cmp->recoverSfc->w, cmp->recoverSfc->h, bbox, data->offset, color, opacity, direct);
         } else {
             _dropShadowNoFilter(buffer[1], &cmp->image, bbox, data->offset, color);
             std::swap(cmp->image.buf32, buffer[1]->buf32);
@@ -457,19 +454,19 @@ bool effectDropShadow(SwCompositor* cmp, SwSurface* surface[2], const RenderEffe
 
     //draw to the main surface directly
     if (direct) {
-        _dropShadowShift(cmp->recoverSfc->buf32, cmp->image.buf32, cmp->recoverSfc->stride, cmp->image.stride, cmp->recoverSfc->w, cmp->recoverSfc->h, bbox, data->offset, opacity, direct);
+        _dropShadowShift(cmp->recoverSfc->buf32 + cmp->recoverSfc->offset(bbox.min.x, bbox.min.y), cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y), cmp->recoverSfc->stride, cmp->image.stride, cmp->recoverSfc->w, cmp->recoverSfc->h, bbox, data->offset, opacity, direct);
         std::swap(cmp->image.buf32, buffer[0]->buf32);
         return true;
     }
 
     //draw to the intermediate surface
     rasterClear(surface[1], bbox.min.x, bbox.min.y, w, h);
-    _dropShadowShift(buffer[1]->buf32, cmp->image.buf32, buffer[1]->stride, cmp->image.stride, buffer[1]->w, buffer[1]->h, bbox, data->offset, opacity, direct);
+    _dropShadowShift(buffer[1]->buf32 + buffer[1]->offset(bbox.min.x, bbox.min.y), cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y), buffer[1]->stride, cmp->image.stride, buffer[1]->w, buffer[1]->h, bbox, data->offset, opacity, direct);
     std::swap(cmp->image.buf32, buffer[1]->buf32);
 
     //compositing shadow and body
-    auto s = buffer[0]->buf32 + (bbox.min.y * buffer[0]->stride + bbox.min.x);
-    auto d = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+    auto s = buffer[0]->buf32 + buffer[0]->offset(bbox.min.x, bbox.min.y);
+    auto d = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
 
     for (auto y = 0; y < h; ++y) {
         rasterTranslucentPixel32(d, s, w, 255);
@@ -503,8 +500,8 @@ bool effectFill(SwCompositor* cmp, const RenderEffectFill* params, bool direct)
     TVGLOG("SW_ENGINE", "Fill region(%d, %d, %d, %d), param(%d %d %d %d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->color[0], params->color[1], params->color[2], params->color[3]);
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->recoverSfc->buf32 + cmp->recoverSfc->offset(bbox.min.x, bbox.min.y);
+        auto sbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             auto src = sbuffer;
@@ -518,7 +515,7 @@ bool effectFill(SwCompositor* cmp, const RenderEffectFill* params, bool direct)
         }
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             for (size_t x = 0; x < w; ++x, ++dst) {
@@ -554,8 +551,8 @@ bool effectTint(SwCompositor* cmp, const RenderEffectTint* params, bool direct)
     TVGLOG("SW_ENGINE", "Tint region(%d, %d, %d, %d), param(%d %d %d, %d %d %d, %d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->black[0], params->black[1], params->black[2], params->white[0], params->white[1], params->white[2], params->intensity);
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->recoverSfc->buf32 + cmp->recoverSfc->offset(bbox.min.x, bbox.min.y);
+        auto sbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             auto src = sbuffer;
@@ -569,7 +566,7 @@ bool effectTint(SwCompositor* cmp, const RenderEffectTint* params, bool direct)
         }
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             for (size_t x = 0; x < w; ++x, ++dst) {
@@ -621,8 +618,8 @@ bool effectTritone(SwCompositor* cmp, const RenderEffectTritone* params, bool di
     TVGLOG("SW_ENGINE", "Tritone region(%d, %d, %d, %d), param(%d %d %d, %d %d %d, %d %d %d, %d)", bbox.min.x, bbox.min.y, bbox.max.x, bbox.max.y, params->shadow[0], params->shadow[1], params->shadow[2], params->midtone[0], params->midtone[1], params->midtone[2], params->highlight[0], params->highlight[1], params->highlight[2], params->blender);
 
     if (direct) {
-        auto dbuffer = cmp->recoverSfc->buf32 + (bbox.min.y * cmp->recoverSfc->stride + bbox.min.x);
-        auto sbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->recoverSfc->buf32 + cmp->recoverSfc->offset(bbox.min.x, bbox.min.y);
+        auto sbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             auto src = sbuffer;
@@ -640,7 +637,7 @@ bool effectTritone(SwCompositor* cmp, const RenderEffectTritone* params, bool di
         }
         cmp->valid = true;  //no need the subsequent composition
     } else {
-        auto dbuffer = cmp->image.buf32 + (bbox.min.y * cmp->image.stride + bbox.min.x);
+        auto dbuffer = cmp->image.buf32 + cmp->image.offset(bbox.min.x, bbox.min.y);
         for (size_t y = 0; y < h; ++y) {
             auto dst = dbuffer;
             if (params->blender == 0) {
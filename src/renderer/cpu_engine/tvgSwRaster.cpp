@@ -23,6 +23,7 @@
 #include "tvgMath.h"
 #include "tvgRender.h"
 #include "tvgSwCommon.h"
+#include "tvgTrace.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -222,8 +223,8 @@ static inline SwMask _getMaskOp(MaskMethod method)
 
 static bool _compositeMaskImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox)
 {
-    auto dbuffer = &surface->buf8[bbox.min.y * surface->stride + bbox.min.x];
-    auto sbuffer = image.buf8 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
+    auto dbuffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
+    auto sbuffer = image.buf8 + image.offset(bbox.min.x, bbox.min.y);
 
     for (auto y = bbox.min.y; y < bbox.max.y; ++y) {
         auto dst = dbuffer;
@@ -330,6 +331,31 @@ static ImageScaleFilter _scaleMethod(const SwImage& image)
 }
 
 
+//Replace the minified image with its nearest mipmap level
+static const SwImage& _mipmap(const SwImage& image, SwImage& level, Matrix& itransform)
+{
+    if (image.lod == 0) return image;
+
+    level = image;
+    level.buf32 = image.mipmap.data;
+    level.w = level.stride = image.mipmap.w;
+    level.h = image.mipmap.h;
+    level.scale = image.scale * float(1 << image.lod);
+    level.lod = 0;
+
+    //map the source coordinates down to the level
+    auto f = 1.0f / float(1 << image.lod);
+    itransform.e11 *= f;
+    itransform.e12 *= f;
+    itransform.e13 *= f;
+    itransform.e21 *= f;
+    itransform.e22 *= f;
+    itransform.e23 *= f;
+
+    return level;
+}
+
+
 /************************************************************************/
 /* Rect                                                                 */
 /************************************************************************/
@@ -337,7 +363,7 @@ static ImageScaleFilter _scaleMethod(const SwImage& image)
 static bool _rasterCompositeMaskedRect(SwSurface* surface, const RenderRegion& bbox, SwMask maskOp, uint8_t a)
 {
     auto cstride = surface->compositor->image.stride;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * cstride + bbox.min.x);   //compositor buffer
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y);   //compositor buffer
     auto ialpha = 255 - a;
 
     for (uint32_t y = 0; y < bbox.h(); ++y) {
@@ -353,8 +379,8 @@ static bool _rasterCompositeMaskedRect(SwSurface* surface, const RenderRegion& b
 
 static bool _rasterDirectMaskedRect(SwSurface* surface, const RenderRegion& bbox, SwMask maskOp, uint8_t a)
 {
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x);   //compositor buffer
-    auto dbuffer = surface->buf8 + (bbox.min.y * surface->stride + bbox.min.x);   //destination buffer
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y);   //compositor buffer
+    auto dbuffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);   //destination buffer
 
     for (uint32_t y = 0; y < bbox.h(); ++y) {
         auto cmp = cbuffer;
@@ -387,7 +413,7 @@ static bool _rasterMaskedRect(SwSurface* surface, const RenderRegion& bbox, cons
 static bool _rasterMattedRect(SwSurface* surface, const RenderRegion& bbox, const RenderColor& c)
 {
     auto csize = surface->compositor->image.channelSize;
-    auto cbuffer = surface->compositor->image.buf8 + ((bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize);   //compositor buffer
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y) * csize;   //compositor buffer
     auto alpha = surface->alpha(surface->compositor->method);
 
     TVGLOG("SW_ENGINE", "Matted(%d) Rect [Region: %u %u %u %u]", (int)surface->compositor->method, bbox.x(), bbox.y(), bbox.w(), bbox.h());
@@ -395,7 +421,7 @@ static bool _rasterMattedRect(SwSurface* surface, const RenderRegion& bbox, cons
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
         auto color = surface->join(c.r, c.g, c.b, c.a);
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             auto dst = &buffer[y * surface->stride];
             auto cmp = &cbuffer[y * surface->compositor->image.stride * csize];
@@ -406,7 +432,7 @@ static bool _rasterMattedRect(SwSurface* surface, const RenderRegion& bbox, cons
         }
     //8bits grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             auto dst = &buffer[y * surface->stride];
             auto cmp = &cbuffer[y * surface->compositor->image.stride * csize];
@@ -424,7 +450,7 @@ static bool _rasterBlendingRect(SwSurface* surface, const RenderRegion& bbox, co
     if (surface->channelSize != sizeof(uint32_t)) return false;
 
     auto color = surface->join(c.r, c.g, c.b, c.a);
-    auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+    auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
 
     for (uint32_t y = 0; y < bbox.h(); ++y) {
         auto dst = &buffer[y * surface->stride];
@@ -453,16 +479,16 @@ static bool _rasterSolidRect(SwSurface* surface, const RenderRegion& bbox, const
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
         auto color = surface->join(c.r, c.g, c.b, 255);
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride);
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
-            rasterPixel32(buffer + y * surface->stride, color, bbox.min.x, bbox.w());
+            rasterPixel32(buffer + y * surface->stride, color, 0, bbox.w());
         }
         return true;
     }
     //8bits grayscale
     if (surface->channelSize == sizeof(uint8_t)) {
         for (uint32_t y = 0; y < bbox.h(); ++y) {
-            rasterGrayscale8(surface->buf8, 255, (y + bbox.min.y) * surface->stride + bbox.min.x, bbox.w());
+            rasterGrayscale8(surface->buf8, 255, surface->offset(bbox.min.x, bbox.min.y + y), bbox.w());
         }
         return true;
     }
@@ -492,14 +518,13 @@ static bool _rasterRect(SwSurface* surface, const RenderRegion& bbox, const Rend
 static bool _rasterCompositeMaskedRle(SwSurface* surface, SwRle* rle, const RenderRegion& bbox, SwMask maskOp, uint8_t a)
 {
     auto cbuffer = surface->compositor->image.buf8;
-    auto cstride = surface->compositor->image.stride;
     const SwSpan* end;
     int32_t x, len;
     uint8_t src;
 
     for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto cmp = &cbuffer[span->y * cstride + x];
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y)];
         if (span->coverage == 255) src = a;
         else src = MULTIPLY(a, span->coverage);
         auto ialpha = 255 - src;
@@ -514,15 +539,14 @@ static bool _rasterCompositeMaskedRle(SwSurface* surface, SwRle* rle, const Rend
 static bool _rasterDirectMaskedRle(SwSurface* surface, SwRle* rle, const RenderRegion& bbox, SwMask maskOp, uint8_t a)
 {
     auto cbuffer = surface->compositor->image.buf8;
-    auto cstride = surface->compositor->image.stride;
     const SwSpan* end;
     int32_t x, len;
     uint8_t src;
 
     for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto cmp = &cbuffer[span->y * cstride + x];
-        auto dst = &surface->buf8[span->y * surface->stride + x];
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y)];
+        auto dst = &surface->buf8[surface->offset(x, span->y)];
         if (span->coverage == 255) src = a;
         else src = MULTIPLY(a, span->coverage);
         for (auto x = 0; x < len; ++x, ++cmp, ++dst) {
@@ -564,8 +588,8 @@ static bool _rasterMattedRle(SwSurface* surface, SwRle* rle, const RenderRegion&
         auto color = surface->join(c.r, c.g, c.b, c.a);
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf32[span->y * surface->stride + x];
-            auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
+            auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y) * csize];
             if (span->coverage == 255) src = color;
             else src = ALPHA_BLEND(color, span->coverage);
             for (auto x = 0; x < len; ++x, ++dst, cmp += csize) {
@@ -578,8 +602,8 @@ static bool _rasterMattedRle(SwSurface* surface, SwRle* rle, const RenderRegion&
         uint8_t src;
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf8[span->y * surface->stride + x];
-            auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
+            auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y) * csize];
             if (span->coverage == 255) src = c.a;
             else src = MULTIPLY(c.a, span->coverage);
             for (auto x = 0; x < len; ++x, ++dst, cmp += csize) {
@@ -601,7 +625,7 @@ static bool _rasterBlendingRle(SwSurface* surface, const SwRle* rle, const Rende
 
     for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto dst = &surface->buf32[span->y * surface->stride + x];
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
         if (span->coverage == 255) {
             for (auto x = 0; x < len; ++x, ++dst) {
                 *dst = surface->blender(surface, color, *dst);
@@ -638,9 +662,9 @@ static bool _rasterSolidRle(SwSurface* surface, const SwRle* rle, const RenderRe
         auto color = surface->join(c.r, c.g, c.b, 255);
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            if (span->coverage == 255) rasterPixel32(surface->buf32 + span->y * surface->stride, color, x, len);
+            if (span->coverage == 255) rasterPixel32(surface->buf32, color, surface->offset(x, span->y), len);
             else {
-                auto dst = &surface->buf32[span->y * surface->stride + x];
+                auto dst = &surface->buf32[surface->offset(x, span->y)];
                 auto src = ALPHA_BLEND(color, span->coverage);
                 auto ialpha = 255 - span->coverage;
                 for (auto x = 0; x < len; ++x, ++dst) {
@@ -652,9 +676,9 @@ static bool _rasterSolidRle(SwSurface* surface, const SwRle* rle, const RenderRe
     } else if (surface->channelSize == sizeof(uint8_t)) {
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            if (span->coverage == 255) rasterGrayscale8(surface->buf8, span->coverage, span->y * surface->stride + x, len);
+            if (span->coverage == 255) rasterGrayscale8(surface->buf8, span->coverage, surface->offset(x, span->y), len);
             else {
-                auto dst = &surface->buf8[span->y * surface->stride + x];
+                auto dst = &surface->buf8[surface->offset(x, span->y)];
                 auto ialpha = 255 - span->coverage;
                 for (auto x = 0; x < len; ++x, ++dst) {
                     *dst = span->coverage + MULTIPLY(*dst, ialpha);
@@ -723,13 +747,16 @@ static bool _rasterScaledMattedRleImage(SwSurface* surface, const SwImage& image
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    const SwSpan* end;
+    int32_t x, len;
 
-    ARRAY_FOREACH(span, image.rle->spans) {
+    for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &surface->compositor->image.buf8[(span->y * surface->compositor->image.stride + span->x) * csize];
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        auto cmp = &surface->compositor->image.buf8[surface->compositor->image.offset(x, span->y) * csize];
         auto a = MULTIPLY(span->coverage, opacity);
-        for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst, cmp += csize) {
+        for (auto xmax = x + len; x < xmax; ++x, ++dst, cmp += csize) {
             SCALED_IMAGE_RANGE_X
             auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
             src = ALPHA_BLEND(src, (a == 255) ? alpha(cmp) : MULTIPLY(alpha(cmp), a));
@@ -750,19 +777,22 @@ static bool _rasterScaledBlendingRleImage(SwSurface* surface, const SwImage& ima
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    const SwSpan* end;
+    int32_t x, len;
 
-    ARRAY_FOREACH(span, image.rle->spans) {
+    for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
         SCALED_IMAGE_RANGE_Y(span->y)
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
         auto alpha = MULTIPLY(span->coverage, opacity);
         if (alpha == 255) {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto xmax = x + len; x < xmax; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(src), *dst), *dst, A(src));
             }
         } else {
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto xmax = x + len; x < xmax; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 *dst = INTERPOLATE(surface->blender(surface, rasterUnpremultiply(src), *dst), *dst, MULTIPLY(alpha, A(src)));
@@ -778,13 +808,16 @@ static bool _rasterScaledRleImage(SwSurface* surface, const SwImage& image, cons
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
+    const SwSpan* end;
+    int32_t x, len;
 
     if (surface->channelSize == sizeof(uint32_t)) {
-        ARRAY_FOREACH(span, image.rle->spans) {
+        for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
             SCALED_IMAGE_RANGE_Y(span->y)
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
             auto alpha = MULTIPLY(span->coverage, opacity);
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto xmax = x + len; x < xmax; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 if (alpha < 255) src = ALPHA_BLEND(src, alpha);
@@ -792,11 +825,12 @@ static bool _rasterScaledRleImage(SwSurface* surface, const SwImage& image, cons
             }
         }
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        ARRAY_FOREACH(span, image.rle->spans) {
+        for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
             SCALED_IMAGE_RANGE_Y(span->y)
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
             auto alpha = MULTIPLY(span->coverage, opacity);
-            for (uint32_t x = static_cast<uint32_t>(span->x); x < static_cast<uint32_t>(span->x) + span->len; ++x, ++dst) {
+            for (auto xmax = x + len; x < xmax; ++x, ++dst) {
                 SCALED_IMAGE_RANGE_X
                 auto src = scaleMethod(image.buf32, image.stride, image.w, image.h, sx, sy, miny, maxy, sampleSize);
                 *dst = MULTIPLY(A(src), alpha);
@@ -823,9 +857,9 @@ static bool _rasterDirectMattedRleImage(SwSurface* surface, const SwImage& image
 
     for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto dst = &surface->buf32[span->y * surface->stride + x];
-        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + x) * csize];
-        auto img = image.buf32 + (span->y + image.oy) * image.stride + (x + image.ox);
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y) * csize];
+        auto img = image.buf32 + image.offset(x, span->y);
         auto a = MULTIPLY(span->coverage, opacity);
         if (a == 255) {
             for (auto x = 0; x < len; ++x, ++dst, ++img, cmp += csize) {
@@ -850,8 +884,8 @@ static bool _rasterDirectBlendingRleImage(SwSurface* surface, const SwImage& ima
 
     for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto dst = &surface->buf32[span->y * surface->stride + x];
-        auto src = image.buf32 + (span->y + image.oy) * image.stride + (x + image.ox);
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        auto src = image.buf32 + image.offset(x, span->y);
         auto alpha = MULTIPLY(span->coverage, opacity);
         if (alpha == 255) {
             for (auto x = 0; x < len; ++x, ++dst, ++src) {
@@ -874,8 +908,8 @@ static bool _rasterDirectRleImage(SwSurface* surface, const SwImage& image, cons
 
     for (auto span = image.rle->fetch(bbox, &end); span < end; ++span) {
         if (!span->fetch(bbox, x, len)) continue;
-        auto dst = &surface->buf32[span->y * surface->stride + x];
-        auto img = image.buf32 + (span->y + image.oy) * image.stride + (x + image.ox);
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        auto img = image.buf32 + image.offset(x, span->y);
         auto alpha = MULTIPLY(span->coverage, opacity);
         rasterTranslucentPixel32(dst, img, len, alpha);
     }
@@ -908,9 +942,9 @@ static bool _rasterScaledMattedImage(SwSurface* surface, const SwImage& image, c
         return false;
     }
 
-    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+    auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
     auto csize = surface->compositor->image.channelSize;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize;
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y) * csize;
     auto alpha = surface->alpha(surface->compositor->method);
 
     TVGLOG("SW_ENGINE", "Scaled Matted(%d) Image [Region: %d %d %d %d]", (int)surface->compositor->method, bbox.min.x, bbox.min.y, bbox.max.x - bbox.min.x, bbox.max.y - bbox.min.y);
@@ -943,7 +977,7 @@ static bool _rasterScaledBlendingImage(SwSurface* surface, const SwImage& image,
         return false;
     }
 
-    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+    auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
     auto scaleMethod = _scaleMethod(image);
     auto sampleSize = _sampleSize(image.scale);
     int32_t miny = 0, maxy = 0;
@@ -969,7 +1003,7 @@ static bool _rasterScaledImage(SwSurface* surface, const SwImage& image, const M
 
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride + bbox.min.x);
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = bbox.min.y; y < bbox.max.y; ++y, buffer += surface->stride) {
             SCALED_IMAGE_RANGE_Y(y)
             auto dst = buffer;
@@ -994,7 +1028,7 @@ static bool _rasterScaledImage(SwSurface* surface, const SwImage& image, const M
             }
         }
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride + bbox.min.x);
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = bbox.min.y; y < bbox.max.y; ++y, buffer += surface->stride) {
             SCALED_IMAGE_RANGE_Y(y)
             auto dst = buffer;
@@ -1023,14 +1057,14 @@ static bool _rasterDirectMattedImage(SwSurface* surface, const SwImage& image, c
 {
     auto csize = surface->compositor->image.channelSize;
     auto alpha = surface->alpha(surface->compositor->method);
-    auto sbuffer = image.buf32 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize; //compositor buffer
+    auto sbuffer = image.buf32 + image.offset(bbox.min.x, bbox.min.y);
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y) * csize; //compositor buffer
 
     TVGLOG("SW_ENGINE", "Direct Matted(%d) Image  [Region: %u %u %u %u]", (int)surface->compositor->method, bbox.x(), bbox.y(), bbox.w(), bbox.h());
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
             auto cmp = cbuffer;
             auto src = sbuffer;
@@ -1049,7 +1083,7 @@ static bool _rasterDirectMattedImage(SwSurface* surface, const SwImage& image, c
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto dbuffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto dbuffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
             auto cmp = cbuffer;
             auto src = sbuffer;
@@ -1072,11 +1106,11 @@ static bool _rasterDirectMattedImage(SwSurface* surface, const SwImage& image, c
 
 static bool _rasterDirectImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox, int32_t w, int32_t h, uint8_t opacity)
 {
-    auto sbuffer = image.buf32 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
+    auto sbuffer = image.buf32 + image.offset(bbox.min.x, bbox.min.y);
 
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto dbuffer = &surface->buf32[bbox.min.y * surface->stride + bbox.min.x];
+        auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
             if (image.alphaIgnored) rasterPixel32(dbuffer, sbuffer, w, opacity);
             else rasterTranslucentPixel32(dbuffer, sbuffer, w, opacity);
@@ -1084,7 +1118,7 @@ static bool _rasterDirectImage(SwSurface* surface, const SwImage& image, const R
     //8bits grayscale
     //32 -> 8 direct converting seems an avoidable stage. maybe draw to a masking image after an intermediate scene. Can get rid of this?
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto dbuffer = &surface->buf8[bbox.min.y * surface->stride + bbox.min.x];
+        auto dbuffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
             auto src = sbuffer;
             if (opacity == 255) {
@@ -1110,9 +1144,9 @@ static bool _rasterDirectMattedBlendingImage(SwSurface* surface, const SwImage&
 
     auto csize = compositor->image.channelSize;
     auto alpha = surface->alpha(compositor->method);
-    auto sbuffer = image.buf32 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
-    auto cbuffer = compositor->image.buf8 + (bbox.min.y * compositor->image.stride + bbox.min.x) * csize;  // compositor buffer
-    auto dbuffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+    auto sbuffer = image.buf32 + image.offset(bbox.min.x, bbox.min.y);
+    auto cbuffer = compositor->image.buf8 + compositor->image.offset(bbox.min.x, bbox.min.y) * csize;  // compositor buffer
+    auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
 
     for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
         auto cmp = cbuffer;
@@ -1145,8 +1179,8 @@ static bool _rasterDirectBlendingImage(SwSurface* surface, const SwImage& image,
 
     if (injecting(surface->compositor)) return _rasterDirectMattedBlendingImage(surface, image, surface->compositor->recoverCmp, bbox, w, h, opacity);
 
-    auto dbuffer = &surface->buf32[bbox.min.y * surface->stride + bbox.min.x];
-    auto sbuffer = image.buf32 + (bbox.min.y + image.oy) * image.stride + (bbox.min.x + image.ox);
+    auto dbuffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
+    auto sbuffer = image.buf32 + image.offset(bbox.min.x, bbox.min.y);
 
     for (auto y = 0; y < h; ++y, dbuffer += surface->stride, sbuffer += image.stride) {
         auto src = sbuffer;
@@ -1172,11 +1206,11 @@ template<typename fillMethod>
 static bool _rasterCompositeGradientMaskedRect(SwSurface* surface, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
     auto cstride = surface->compositor->image.stride;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * cstride + bbox.min.x);
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y);
 
     for (uint32_t y = 0; y < bbox.h(); ++y) {
         fillMethod()(fill, cbuffer, bbox.min.y + y, bbox.min.x, bbox.w(), maskOp, 255);
-        cbuffer += surface->stride;
+        cbuffer += cstride;
     }
     return _compositeMaskImage(surface, surface->compositor->image, surface->compositor->bbox);
 }
@@ -1186,8 +1220,8 @@ template<typename fillMethod>
 static bool _rasterDirectGradientMaskedRect(SwSurface* surface, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
     auto cstride = surface->compositor->image.stride;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * cstride + bbox.min.x);
-    auto dbuffer = surface->buf8 + (bbox.min.y * surface->stride + bbox.min.x);
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y);
+    auto dbuffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
 
     for (uint32_t y = 0; y < bbox.h(); ++y) {
         fillMethod()(fill, dbuffer, bbox.min.y + y, bbox.min.x, bbox.w(), cbuffer, maskOp, 255);
@@ -1217,9 +1251,9 @@ static bool _rasterGradientMaskedRect(SwSurface* surface, const RenderRegion& bb
 template<typename fillMethod>
 static bool _rasterGradientMattedRect(SwSurface* surface, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+    auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
     auto csize = surface->compositor->image.channelSize;
-    auto cbuffer = surface->compositor->image.buf8 + (bbox.min.y * surface->compositor->image.stride + bbox.min.x) * csize;
+    auto cbuffer = surface->compositor->image.buf8 + surface->compositor->image.offset(bbox.min.x, bbox.min.y) * csize;
     auto alpha = surface->alpha(surface->compositor->method);
 
     TVGLOG("SW_ENGINE", "Matted(%d) Gradient [Region: %u %u %u %u]", (int)surface->compositor->method, bbox.x(), bbox.y(), bbox.w(), bbox.h());
@@ -1227,7 +1261,7 @@ static bool _rasterGradientMattedRect(SwSurface* surface, const RenderRegion& bb
     for (uint32_t y = 0; y < bbox.h(); ++y) {
         fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), cbuffer, alpha, csize, 255);
         buffer += surface->stride;
-        cbuffer += surface->stride * csize;
+        cbuffer += surface->compositor->image.stride * csize;
     }
     return true;
 }
@@ -1236,7 +1270,7 @@ static bool _rasterGradientMattedRect(SwSurface* surface, const RenderRegion& bb
 template<typename fillMethod>
 static bool _rasterBlendingGradientRect(SwSurface* surface, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+    auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
 
     if (fill->translucent) {
         for (uint32_t y = 0; y < bbox.h(); ++y) {
@@ -1255,14 +1289,14 @@ static bool _rasterTranslucentGradientRect(SwSurface* surface, const RenderRegio
 {
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), opBlendPreNormal, 255);
             buffer += surface->stride;
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), _opMaskAdd, 255);
             buffer += surface->stride;
@@ -1277,14 +1311,14 @@ static bool _rasterSolidGradientRect(SwSurface* surface, const RenderRegion& bbo
 {
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), opBlendSrcOver, 255);
             buffer += surface->stride;
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             fillMethod()(fill, buffer, bbox.min.y + y, bbox.min.x, bbox.w(), _opMaskNone, 255);
             buffer += surface->stride;
@@ -1329,39 +1363,41 @@ static bool _rasterRadialGradientRect(SwSurface* surface, const RenderRegion& bb
 /************************************************************************/
 
 template<typename fillMethod>
-static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterCompositeGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
-    auto cstride = surface->compositor->image.stride;
+    const SwSpan* end;
+    int32_t x, len;
     auto cbuffer = surface->compositor->image.buf8;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        fillMethod()(fill, cmp, span->y, span->x, span->len, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y)];
+        fillMethod()(fill, cmp, span->y, x, len, maskOp, span->coverage);
     }
     return _compositeMaskImage(surface, surface->compositor->image, surface->compositor->bbox);
 }
 
 
 template<typename fillMethod>
-static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill, SwMask maskOp)
+static bool _rasterDirectGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill, SwMask maskOp)
 {
-    auto span = rle->data();
-    auto cstride = surface->compositor->image.stride;
+    const SwSpan* end;
+    int32_t x, len;
     auto cbuffer = surface->compositor->image.buf8;
     auto dbuffer = surface->buf8;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto cmp = &cbuffer[span->y * cstride + span->x];
-        auto dst = &dbuffer[span->y * surface->stride + span->x];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, maskOp, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y)];
+        auto dst = &dbuffer[surface->offset(x, span->y)];
+        fillMethod()(fill, dst, span->y, x, len, cmp, maskOp, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     auto method = surface->compositor->method;
 
@@ -1369,61 +1405,68 @@ static bool _rasterGradientMaskedRle(SwSurface* surface, const SwRle* rle, const
 
     auto maskOp = _getMaskOp(method);
 
-    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
-    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, fill, maskOp);
+    if (_direct(method)) return _rasterDirectGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
+    else return _rasterCompositeGradientMaskedRle<fillMethod>(surface, rle, bbox, fill, maskOp);
     return false;
 }
 
 
 template<typename fillMethod>
-static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterGradientMattedRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     TVGLOG("SW_ENGINE", "Matted(%d) Rle Linear Gradient", (int)surface->compositor->method);
 
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
     auto csize = surface->compositor->image.channelSize;
     auto cbuffer = surface->compositor->image.buf8;
     auto alpha = surface->alpha(surface->compositor->method);
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        auto cmp = &cbuffer[(span->y * surface->compositor->image.stride + span->x) * csize];
-        fillMethod()(fill, dst, span->y, span->x, span->len, cmp, alpha, csize, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        auto cmp = &cbuffer[surface->compositor->image.offset(x, span->y) * csize];
+        fillMethod()(fill, dst, span->y, x, len, cmp, alpha, csize, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterBlendingGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
-    for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-        auto dst = &surface->buf32[span->y * surface->stride + span->x];
-        fillMethod()(surface, fill, dst, span->y, span->x, span->len, opBlendPreNormal, surface->blender, span->coverage);
+    for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+        if (!span->fetch(bbox, x, len)) continue;
+        auto dst = &surface->buf32[surface->offset(x, span->y)];
+        fillMethod()(surface, fill, dst, span->y, x, len, opBlendPreNormal, surface->blender, span->coverage);
     }
     return true;
 }
 
 
 template<typename fillMethod>
-static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendPreNormal, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendNormal, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, opBlendPreNormal, 255);
+            else fillMethod()(fill, dst, span->y, x, len, opBlendNormal, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
+            fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
     return true;
@@ -1431,23 +1474,26 @@ static bool _rasterTranslucentGradientRle(SwSurface* surface, const SwRle* rle,
 
 
 template<typename fillMethod>
-static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
-    auto span = rle->data();
+    const SwSpan* end;
+    int32_t x, len;
 
     //32 bits
     if (surface->channelSize == sizeof(uint32_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf32[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, opBlendSrcOver, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, opBlendInterp, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, opBlendSrcOver, 255);
+            else fillMethod()(fill, dst, span->y, x, len, opBlendInterp, span->coverage);
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        for (uint32_t i = 0; i < rle->size(); ++i, ++span) {
-            auto dst = &surface->buf8[span->y * surface->stride + span->x];
-            if (span->coverage == 255) fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskNone, 255);
-            else fillMethod()(fill, dst, span->y, span->x, span->len, _opMaskAdd, span->coverage);
+        for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
+            if (!span->fetch(bbox, x, len)) continue;
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
+            if (span->coverage == 255) fillMethod()(fill, dst, span->y, x, len, _opMaskNone, 255);
+            else fillMethod()(fill, dst, span->y, x, len, _opMaskAdd, span->coverage);
         }
     }
 
@@ -1455,31 +1501,31 @@ static bool _rasterSolidGradientRle(SwSurface* surface, const SwRle* rle, const
 }
 
 
-static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterLinearGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillLinear>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillLinear>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillLinear>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillLinear>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillLinear>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillLinear>(surface, rle, bbox, fill);
     }
     return false;
 }
 
 
-static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const SwFill* fill)
+static bool _rasterRadialGradientRle(SwSurface* surface, const SwRle* rle, const RenderRegion& bbox, const SwFill* fill)
 {
     if (_compositing(surface)) {
-        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, fill);
-        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, fill);
+        if (_matting(surface)) return _rasterGradientMattedRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterGradientMaskedRle<FillRadial>(surface, rle, bbox, fill);
     } else if (_blending(surface)) {
-        return _rasterBlendingGradientRle<FillRadial>(surface, rle, fill);
+        return _rasterBlendingGradientRle<FillRadial>(surface, rle, bbox, fill);
     } else {
-        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, fill);
-        else return _rasterSolidGradientRle<FillRadial>(surface, rle, fill);
+        if (fill->translucent) return _rasterTranslucentGradientRle<FillRadial>(surface, rle, bbox, fill);
+        else return _rasterSolidGradientRle<FillRadial>(surface, rle, bbox, fill);
     }
     return false;
 }
@@ -1549,6 +1595,8 @@ Result rasterCompositor(SwSurface* surface)
 
 bool rasterClear(SwSurface* surface, uint32_t x, uint32_t y, uint32_t w, uint32_t h)
 {
+    TVGTRACE("rasterClear");
+
     if (!surface || !surface->buf32 || surface->stride == 0 || surface->w == 0 || surface->h == 0) return false;
 
     //32 bits
@@ -1556,22 +1604,22 @@ bool rasterClear(SwSurface* surface, uint32_t x, uint32_t y, uint32_t w, uint32_
         uint32_t val = 0;
         //full clear
         if (w == surface->stride) {
-            rasterPixel32(surface->buf32, val, surface->stride * y, w * h);
+            rasterPixel32(surface->buf32, val, surface->offset(x, y), w * h);
         //partial clear
         } else {
             for (uint32_t i = 0; i < h; i++) {
-                rasterPixel32(surface->buf32, val, (surface->stride * y + x) + (surface->stride * i), w);
+                rasterPixel32(surface->buf32, val, surface->offset(x, y) + (surface->stride * i), w);
             }
         }
     //8 bits
     } else if (surface->channelSize == sizeof(uint8_t)) {
         //full clear
         if (w == surface->stride) {
-            rasterGrayscale8(surface->buf8, 0x00, surface->stride * y, w * h);
+            rasterGrayscale8(surface->buf8, 0x00, surface->offset(x, y), w * h);
         //partial clear
         } else {
             for (uint32_t i = 0; i < h; i++) {
-                rasterGrayscale8(surface->buf8, 0x00, (surface->stride * y + x) + (surface->stride * i), w);
+                rasterGrayscale8(surface->buf8, 0x00, surface->offset(x, y) + (surface->stride * i), w);
             }
         }
     }
@@ -1596,6 +1644,8 @@ void rasterUnpremultiply(RenderSurface* surface)
 {
     if (surface->channelSize != sizeof(uint32_t)) return;
 
+    TVGTRACE("rasterUnpremultiply");
+
     TVGLOG("SW_ENGINE", "Unpremultiply [Size: %d x %d]", surface->w, surface->h);
 
     //OPTIMIZE_ME: +SIMD
@@ -1615,6 +1665,8 @@ void rasterPremultiply(RenderSurface* surface)
     if (surface->premultiplied || (surface->channelSize != sizeof(uint32_t))) return;
     surface->premultiplied = true;
 
+    TVGTRACE("rasterPremultiply");
+
     TVGLOG("SW_ENGINE", "Premultiply [Size: %d x %d]", surface->w, surface->h);
 
     //OPTIMIZE_ME: +SIMD
@@ -1630,12 +1682,17 @@ void rasterPremultiply(RenderSurface* surface)
 }
 
 
-bool rasterScaledImage(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity)
+bool rasterScaledImage(SwSurface* surface, const SwImage& source, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity)
 {
+    TVGTRACE("rasterScaledImage");
+
     Matrix itransform;
 
     if (!inverse(&transform, &itransform)) return true;
 
+    SwImage level;
+    auto& image = _mipmap(source, level, itransform);
+
     if (_compositing(surface)) {
         if (_matting(surface)) return _rasterScaledMattedImage(surface, image, &itransform, bbox, opacity);
         else return _rasterScaledMaskedImage(surface, image, &itransform, bbox, opacity);
@@ -1648,6 +1705,8 @@ bool rasterScaledImage(SwSurface* surface, const SwImage& image, const Matrix& t
 
 bool rasterDirectImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox, uint8_t opacity)
 {
+    TVGTRACE("rasterDirectImage");
+
     //calculate an actual drawing image size
     auto w = std::min(bbox.max.x - bbox.min.x, int32_t(image.w) - (bbox.min.x + image.ox));
     auto h = std::min(bbox.max.y - bbox.min.y, int32_t(image.h) - (bbox.min.y + image.oy));
@@ -1664,11 +1723,16 @@ bool rasterDirectImage(SwSurface* surface, const SwImage& image, const RenderReg
 }
 
 
-bool rasterScaledRleImage(SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity)
+bool rasterScaledRleImage(SwSurface* surface, const SwImage& source, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity)
 {
+    TVGTRACE("rasterScaledRleImage");
+
     Matrix itransform;
     if (!inverse(&transform, &itransform)) return true;
 
+    SwImage level;
+    auto& image = _mipmap(source, level, itransform);
+
     if (_compositing(surface)) {
         if (_matting(surface)) return _rasterScaledMattedRleImage(surface, image, &itransform, bbox, opacity);
         else return _rasterScaledMaskedRleImage(surface, image, &itransform, bbox, opacity);
@@ -1681,6 +1745,8 @@ bool rasterScaledRleImage(SwSurface* surface, const SwImage& image, const Matrix
 
 bool rasterDirectRleImage(SwSurface* surface, const SwImage& image, const RenderRegion& bbox, uint8_t opacity)
 {
+    TVGTRACE("rasterDirectRleImage");
+
     if (surface->channelSize == sizeof(uint8_t)) {
         TVGERR("SW_ENGINE", "Not supported grayscale rle image!");
         return false;
@@ -1698,6 +1764,8 @@ bool rasterDirectRleImage(SwSurface* surface, const SwImage& image, const Render
 
 bool rasterGradientShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, const Fill* fdata, uint8_t opacity)
 {
+    TVGTRACE("rasterGradientShape");
+
     if (!shape->fill) return false;
 
     if (auto color = fillFetchSolid(shape->fill, fdata)) {
@@ -1711,14 +1779,16 @@ bool rasterGradientShape(SwSurface* surface, SwShape* shape, const RenderRegion&
         if (type == Type::LinearGradient) return _rasterLinearGradientRect(surface, bbox, shape->fill);
         else if (type == Type::RadialGradient)return _rasterRadialGradientRect(surface, bbox, shape->fill);
     } else if (shape->rle && shape->rle->valid()) {
-        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, shape->fill);
-        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, shape->fill);
+        if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->rle, bbox, shape->fill);
+        else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->rle, bbox, shape->fill);
     } return false;
 }
 
 
 bool rasterGradientStroke(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, const Fill* fdata, uint8_t opacity)
 {
+    TVGTRACE("rasterGradientStroke");
+
     if (!shape->stroke || !shape->stroke->fill || !shape->strokeRle || shape->strokeRle->invalid()) return false;
 
     if (auto color = fillFetchSolid(shape->stroke->fill, fdata)) {
@@ -1728,14 +1798,16 @@ bool rasterGradientStroke(SwSurface* surface, SwShape* shape, const RenderRegion
     }
 
     auto type = fdata->type();
-    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, shape->stroke->fill);
-    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, shape->stroke->fill);
+    if (type == Type::LinearGradient) return _rasterLinearGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
+    else if (type == Type::RadialGradient) return _rasterRadialGradientRle(surface, shape->strokeRle, bbox, shape->stroke->fill);
     return false;
 }
 
 
 bool rasterShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, RenderColor& c)
 {
+    TVGTRACE("rasterShape");
+
     if (c.a < 255) {
         c.r = MULTIPLY(c.r, c.a);
         c.g = MULTIPLY(c.g, c.a);
@@ -1748,6 +1820,8 @@ bool rasterShape(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, R
 
 bool rasterStroke(SwSurface* surface, SwShape* shape, const RenderRegion& bbox, RenderColor& c)
 {
+    TVGTRACE("rasterStroke");
+
     if (c.a < 255) {
         c.r = MULTIPLY(c.r, c.a);
         c.g = MULTIPLY(c.g, c.a);
@@ -1763,6 +1837,11 @@ bool rasterConvertCS(RenderSurface* surface, ColorSpace to)
     ScopedLock lock(surface->key);
     if (surface->cs == to) return true;
 
+    TVGTRACE("rasterConvertCS");
+
+    //the levels are swizzled along with the pixels on the next minified drawing
+    surface->invalidate();
+
     //TODO: Support SIMD accelerations
     auto from = surface->cs;
 
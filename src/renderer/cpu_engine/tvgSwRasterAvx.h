@@ -107,7 +107,7 @@ static bool avxRasterTranslucentRect(SwSurface* surface, const RenderRegion& bbo
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
         auto color = surface->join(c.r, c.g, c.b, c.a);
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
 
         uint32_t ialpha = 255 - c.a;
 
@@ -145,7 +145,7 @@ static bool avxRasterTranslucentRect(SwSurface* surface, const RenderRegion& bbo
     //8bit grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
         TVGLOG("SW_ENGINE", "Require AVX Optimization, Channel Size = %d", surface->channelSize);
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         auto ialpha = ~c.a;
         for (uint32_t y = 0; y < h; ++y) {
             auto dst = &buffer[y * surface->stride];
@@ -173,7 +173,7 @@ static bool avxRasterTranslucentRle(SwSurface* surface, const SwRle* rle, const
             if (span->coverage < 255) src = ALPHA_BLEND(color, span->coverage);
             else src = color;
 
-            auto dst = &surface->buf32[span->y * surface->stride + x];
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
             auto ialpha = IA(src);
 
             //1. fill the not aligned memory (for 128-bit registers a 16-bytes alignment is required)
@@ -214,7 +214,7 @@ static bool avxRasterTranslucentRle(SwSurface* surface, const SwRle* rle, const
         uint8_t src;
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf8[span->y * surface->stride + x];
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
             if (span->coverage < 255) src = MULTIPLY(span->coverage, c.a);
             else src = c.a;
             auto ialpha = ~c.a;
@@ -103,7 +103,7 @@ static bool inline cRasterTranslucentRle(SwSurface* surface, const SwRle* rle, c
         uint32_t src;
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf32[span->y * surface->stride + x];
+            auto dst = &surface->buf32[surface->offset(x, span->y)];
             if (span->coverage < 255) src = ALPHA_BLEND(color, span->coverage);
             else src = color;
             auto ialpha = IA(src);
@@ -116,7 +116,7 @@ static bool inline cRasterTranslucentRle(SwSurface* surface, const SwRle* rle, c
         uint8_t src;
         for (auto span = rle->fetch(bbox, &end); span < end; ++span) {
             if (!span->fetch(bbox, x, len)) continue;
-            auto dst = &surface->buf8[span->y * surface->stride + x];
+            auto dst = &surface->buf8[surface->offset(x, span->y)];
             if (span->coverage < 255) src = MULTIPLY(span->coverage, c.a);
             else src = c.a;
             auto ialpha = ~c.a;
@@ -134,7 +134,7 @@ static bool inline cRasterTranslucentRect(SwSurface* surface, const RenderRegion
     //32bits channels
     if (surface->channelSize == sizeof(uint32_t)) {
         auto color = surface->join(c.r, c.g, c.b, c.a);
-        auto buffer = surface->buf32 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf32 + surface->offset(bbox.min.x, bbox.min.y);
         auto ialpha = 255 - c.a;
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             auto dst = &buffer[y * surface->stride];
@@ -144,7 +144,7 @@ static bool inline cRasterTranslucentRect(SwSurface* surface, const RenderRegion
         }
     //8bit grayscale
     } else if (surface->channelSize == sizeof(uint8_t)) {
-        auto buffer = surface->buf8 + (bbox.min.y * surface->stride) + bbox.min.x;
+        auto buffer = surface->buf8 + surface->offset(bbox.min.x, bbox.min.y);
         auto ialpha = ~c.a;
         for (uint32_t y = 0; y < bbox.h(); ++y) {
             auto dst = &buffer[y * surface->stride];
@@ -106,7 +106,7 @@ static void _rasterBlendingPolygonImageSegment(SwSurface* surface, const SwImage
             dx = 1 - (_xa - x1);
             u = _ua + dx * _dudx;
             v = _va + dx * _dvdx;
-            buf = dbuf + ((y * surface->stride) + x1);
+            buf = dbuf + surface->offset(x1, y);
             x = x1;
 
             //Draw horizontal line
@@ -207,10 +207,10 @@ static void _rasterPolygonImageSegment32(SwSurface* surface, const SwImage& imag
             dx = 1 - (_xa - x1);
             u = _ua + dx * _dudx;
             v = _va + dx * _dvdx;
-            buf = dbuf + ((y * surface->stride) + x1);
+            buf = dbuf + surface->offset(x1, y);
             x = x1;
 
-            if (matting) cmp = &surface->compositor->image.buf8[(y * surface->compositor->image.stride + x1) * csize];
+            if (matting) cmp = &surface->compositor->image.buf8[surface->compositor->image.offset(x1, y) * csize];
 
             //Draw horizontal line
             while (x++ < x2) {
@@ -310,7 +310,7 @@ static void _rasterPolygonImageSegment8(SwSurface* surface, const SwImage& image
             dx = 1 - (_xa - x1);
             u = _ua + dx * _dudx;
             v = _va + dx * _dvdx;
-            buf = dbuf + ((y * surface->stride) + x1);
+            buf = dbuf + surface->offset(x1, y);
             x = x1;
             //Draw horizontal line
             while (x++ < x2) {
@@ -84,7 +84,7 @@ struct SwTask : Task
         return true;
     }
 
-    virtual bool clip(SwRle* target) = 0;
+    virtual bool clip(SwRle* target, unsigned tid) = 0;
     virtual ~SwTask() {}
 };
 
@@ -93,6 +93,11 @@ struct SwShapeTask : SwTask
 {
     SwShape shape;
     const RenderShape* rshape = nullptr;
+    struct {
+        int32_t x, y;
+        bool valid = false;
+    } shift;                   //integral translation from the previous rendering, the rle can be moved
+    SwShapeTask* origin = nullptr;  //the other instance of the same path, its rle can be copied
     bool clipper = false;
 
     ~SwShapeTask()
@@ -117,18 +122,87 @@ struct SwShapeTask : SwTask
         return (rshape->stroke->width * sqrt(transform.e11 * transform.e11 + transform.e12 * transform.e12));
     }
 
-    bool clip(SwRle* target) override
+    bool clip(SwRle* target, unsigned tid) override
     {
-        if (shape.strokeRle) return rleClip(target, shape.strokeRle);
+        if (shape.strokeRle) return rleClip(target, shape.strokeRle, renderer->mpool, tid);
         if (shape.fastTrack) return rleClip(target, &curBox);
-        if (shape.rle) return rleClip(target, shape.rle);
+        if (shape.rle) return rleClip(target, shape.rle, renderer->mpool, tid);
         return false;
     }
 
+    //move the previous rle if the shape is just translated by whole pixels
+    bool translate()
+    {
+        if (!shift.valid || flags[0] != RenderUpdateFlag::Transform || clips.count > 0 || clipper) return false;
+
+        RenderRegion box = {{curBox.min.x + shift.x, curBox.min.y + shift.y}, {curBox.max.x + shift.x, curBox.max.y + shift.y}};
+
+        //the rle must be free from the clipping of the both sides
+        auto inside = [](const RenderRegion& box, const RenderRegion& clip) {
+            return box.min.x > clip.min.x && box.min.y > clip.min.y && box.max.x < clip.max.x && box.max.y < clip.max.y;
+        };
+        if (!inside(box, clipBox)) return false;
+
+        rleTranslate(shape.rle, shift.x, shift.y);
+        rleTranslate(shape.strokeRle, shift.x, shift.y);
+        shape.bbox = {{shape.bbox.min.x + shift.x, shape.bbox.min.y + shift.y}, {shape.bbox.max.x + shift.x, shape.bbox.max.y + shift.y}};
+        curBox = box;
+        return true;
+    }
+
+    //copy the rle of the other instance if they differ in the whole pixels translation only
+    bool share(float strokeWidth, unsigned tid)
+    {
+        if (!origin || !(flags[0] & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform))) return false;
+
+        origin->done();
+
+        if (!origin->valid || origin->shape.fastTrack || origin->clips.count > 0) return false;
+        if ((rshape->fill || rshape->color.a > 0) != (origin->rshape->fill || origin->rshape->color.a > 0)) return false;
+        if ((strokeWidth > 0.0f) != (origin->shape.strokeRle && origin->shape.strokeRle->valid())) return false;
+
+        auto x = int32_t(transform.e13 - origin->transform.e13);
+        auto y = int32_t(transform.e23 - origin->transform.e23);
+        auto& src = origin->curBox;
+        RenderRegion box = {{src.min.x + x, src.min.y + y}, {src.max.x + x, src.max.y + y}};
+
+        //the rle must be free from the clipping of the both sides
+        auto inside = [](const RenderRegion& box, const RenderRegion& clip) {
+            return box.min.x > clip.min.x && box.min.y > clip.min.y && box.max.x < clip.max.x && box.max.y < clip.max.y;
+        };
+        if (!inside(src, origin->clipBox) || !inside(box, clipBox)) return false;
+
+        auto copy = [&](SwRle*& dst, const SwRle* src) {
+            if (!src) {
+                rleReset(dst);
+                return;
+            }
+            if (!dst) dst = new SwRle;
+            dst->spans = src->spans;
+            rleTranslate(dst, x, y);
+        };
+
+        shapeReset(shape);
+        copy(shape.rle, origin->shape.rle);
+        if (strokeWidth > 0.0f) {
+            shapeResetStroke(shape, rshape, transform, renderer->mpool, tid);
+            copy(shape.strokeRle, origin->shape.strokeRle);
+        }
+        auto& bbox = origin->shape.bbox;
+        shape.bbox = {{bbox.min.x + x, bbox.min.y + y}, {bbox.max.x + x, bbox.max.y + y}};
+        curBox = box;
+        return true;
+    }
+
     void run(unsigned tid) override
     {
+        TVGTRACE("SwShapeTask::run");
+
         auto strokeWidth = validStrokeWidth(clipper);
-        auto updateShape = flags[0] & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform | RenderUpdateFlag::Clip);
+        //the origin may run on this thread with the same tid, share() must precede any use of the mpool
+        auto translated = translate() || share(strokeWidth, tid);
+        renderer->mpool->cell(tid)->retries = 0;
+        auto updateShape = !translated && (flags[0] & (RenderUpdateFlag::Path | RenderUpdateFlag::Transform | RenderUpdateFlag::Clip));
         auto updateFill = flags[0] & (RenderUpdateFlag::Color | RenderUpdateFlag::Gradient | RenderUpdateFlag::Transform);
 
         //Shape
@@ -140,8 +214,10 @@ struct SwShapeTask : SwTask
                     updateFill = false;
                     curBox.reset();
                 }
+                if (shape.rle) RENDER_STATS(renderer, spans, shape.rle->size());
             }
-        }
+            RENDER_STATS(renderer, tessellated, 1);
+        } else RENDER_STATS(renderer, reused, 1);
         //Fill
         if (updateFill) {
             if (!shapeGenFillColors(shape.fill, rshape->fill, transform, renderer->surface, opacity, (flags[0] & RenderUpdateFlag::Gradient))) goto err;
@@ -149,7 +225,11 @@ struct SwShapeTask : SwTask
         //Stroke
         if (strokeWidth > 0.0f) {
             auto updateStroke = updateShape || (flags[0] & RenderUpdateFlag::Stroke);
-            if (updateStroke && !shapeGenStrokeRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, renderer->antiAlias)) goto err;
+            if (translated) updateStroke = false;
+            if (updateStroke) {
+                if (!shapeGenStrokeRle(shape, rshape, transform, clipBox, curBox, renderer->mpool, tid, renderer->antiAlias)) goto err;
+                RENDER_STATS(renderer, spans, shape.strokeRle->size());
+            }
             auto ctable = flags[0] & RenderUpdateFlag::GradientStroke;
             if (ctable || flags[0] & RenderUpdateFlag::Transform) {
                 if (!shapeGenFillColors(shape.stroke->fill, rshape->strokeFill(), transform, renderer->surface, opacity, ctable)) goto err;
@@ -163,11 +243,12 @@ struct SwShapeTask : SwTask
         //Clip Path
         ARRAY_FOREACH(p, clips) {
             auto clipper = static_cast<SwTask*>(*p);
-            auto clipShapeRle = shape.rle ? clipper->clip(shape.rle) : true;
-            auto clipStrokeRle = shape.strokeRle ? clipper->clip(shape.strokeRle) : true;
+            auto clipShapeRle = shape.rle ? clipper->clip(shape.rle, tid) : true;
+            auto clipStrokeRle = shape.strokeRle ? clipper->clip(shape.strokeRle, tid) : true;
             if (!clipShapeRle || !clipStrokeRle) goto err;
         }
 
+        RENDER_STATS(renderer, retries, renderer->mpool->cell(tid)->retries);
         valid = true;
         if (!nodirty) dirtyRegion->add(prvBox, curBox);
         return;
@@ -190,7 +271,7 @@ struct SwImageTask : SwTask
         imageFree(image);
     }
 
-    bool clip(SwRle* target) override
+    bool clip(SwRle* target, unsigned tid) override
     {
         TVGERR("SW_ENGINE", "Image is used as ClipPath?");
         return true;
@@ -198,6 +279,8 @@ struct SwImageTask : SwTask
 
     void run(unsigned tid) override
     {
+        TVGTRACE("SwImageTask::run");
+
         //Convert colorspace if it's not aligned.
         rasterConvertCS(source, renderer->surface->cs);
         rasterPremultiply(source);
@@ -217,13 +300,14 @@ struct SwImageTask : SwTask
             if (updateImage) imageReset(image);
             if (!image.data || image.w == 0 || image.h == 0) goto err;
             if (!imagePrepare(image, transform, clipBox, curBox, renderer->mpool, tid)) goto err;
+            imageMipmap(image, source);
             valid = true;
             if (clips.count > 0) {
                 if (!imageGenRle(image, curBox, renderer->mpool, tid, false)) goto err;
                 if (image.rle) {
                     ARRAY_FOREACH(p, clips) {
                         auto clipper = static_cast<SwTask*>(*p);
-                        if (!clipper->clip(image.rle)) goto err;
+                        if (!clipper->clip(image.rle, tid)) goto err;
                     }
                     if (!nodirty) dirtyRegion->add(prvBox, curBox);
                     return;
@@ -240,6 +324,25 @@ struct SwImageTask : SwTask
 };
 
 
+//Confine the drawing to the pixels backed by the target and its mask buffers
+static RenderRegion _clip(const SwSurface* surface, const RenderRegion& bbox)
+{
+    auto ret = RenderRegion::intersect(bbox, surface->region);
+    if (surface->compositor && surface->compositor->method != MaskMethod::None) {
+        ret = RenderRegion::intersect(ret, surface->compositor->bbox);
+    }
+    return ret;
+}
+
+
+static uint32_t _alignPow2(uint32_t value)
+{
+    uint32_t ret = 1;
+    while (ret < value) ret <<= 1;
+    return ret;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
@@ -294,6 +397,7 @@ Result SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h
     surface->cs = cs;
     surface->channelSize = CHANNEL_SIZE(cs);
     surface->premultiplied = true;
+    surface->region = {{0, 0}, {int32_t(w), int32_t(h)}};
 
     dirtyRegion.init(w, h);
 
@@ -305,12 +409,14 @@ Result SwRenderer::target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h
 
 bool SwRenderer::preUpdate()
 {
+    instances.clear();
     return surface != nullptr;
 }
 
 
 bool SwRenderer::postUpdate()
 {
+    instances.clear();
     return true;
 }
 
@@ -318,7 +424,10 @@ bool SwRenderer::postUpdate()
 bool SwRenderer::preRender()
 {
     if (!surface) return false;
-    if (fulldraw || dirtyRegion.deactivated()) return true;
+    if (fulldraw || dirtyRegion.deactivated()) {
+        RENDER_STATS(this, area, vport.w() * vport.h());
+        return true;
+    }
 
     ARRAY_FOREACH(p, tasks) (*p)->done();
 
@@ -328,6 +437,7 @@ bool SwRenderer::preRender()
     for (int idx = 0; idx < RenderDirtyRegion::PARTITIONING; ++idx) {
         ARRAY_FOREACH(p, dirtyRegion.get(idx)) {
             rasterClear(surface, p->x(), p->y(), p->w(), p->h());
+            RENDER_STATS(this, area, p->w() * p->h());
         }
     }
 
@@ -339,7 +449,7 @@ void SwRenderer::clearCompositors()
 {
     //Free Composite Caches
     ARRAY_FOREACH(p, compositors) {
-        tvg::free((*p)->compositor->image.data);
+        tvg::free((*p)->compositor->capacity > 0 ? (*p)->compositor->buffer : (*p)->compositor->image.data);
         delete((*p)->compositor);
         delete(*p);
     }
@@ -382,7 +492,8 @@ bool SwRenderer::renderImage(RenderData data)
     task->done();
 
     if (task->valid) {
-        auto raster = [&](SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& bbox, uint8_t opacity) {
+        auto raster = [&](SwSurface* surface, const SwImage& image, const Matrix& transform, const RenderRegion& region, uint8_t opacity) {
+            auto bbox = _clip(surface, region);
             if (bbox.invalid() || bbox.x() >= surface->w || bbox.y() >= surface->h) return true;
 
             //RLE Image
@@ -392,7 +503,7 @@ bool SwRenderer::renderImage(RenderData data)
                 else if (image.scaled) return rasterScaledRleImage(surface, image, transform, bbox, opacity);
                 else {
                     //create a intermediate buffer for rle clipping
-                    auto cmp = request(sizeof(pixel_t), false);
+                    auto cmp = request(sizeof(pixel_t), bbox);
                     cmp->compositor->method = MaskMethod::None;
                     cmp->compositor->valid = true;
                     cmp->compositor->image.rle = image.rle;
@@ -435,7 +546,8 @@ bool SwRenderer::renderShape(RenderData data)
     task->done();
 
     if (task->valid) {
-        auto fill = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
+        auto fill = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& region) {
+            auto bbox = _clip(surface, region);
             if (auto fill = task->rshape->fill) {
                 rasterGradientShape(surface, &task->shape, bbox, fill, task->opacity);
             } else {
@@ -446,7 +558,8 @@ bool SwRenderer::renderShape(RenderData data)
             }
         };
 
-        auto stroke = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& bbox) {
+        auto stroke = [](SwShapeTask* task, SwSurface* surface, const RenderRegion& region) {
+            auto bbox = _clip(surface, region);
             if (auto strokeFill = task->rshape->strokeFill()) {
                 rasterGradientStroke(surface, &task->shape, bbox, strokeFill, task->opacity);
             } else {
@@ -580,24 +693,18 @@ const RenderSurface* SwRenderer::mainSurface()
 }
 
 
-SwSurface* SwRenderer::request(int channelSize, bool square)
+SwSurface* SwRenderer::request(int channelSize)
 {
     SwSurface* cmp = nullptr;
-    uint32_t w, h;
 
-    if (square) {
-        //Same Dimensional Size is demanded for the Post Processing Fast Flipping
-        w = h = std::max(surface->w, surface->h);
-    } else {
-        w = surface->w;
-        h = surface->h;
-    }
+    //Same Dimensional Size is demanded for the Post Processing Fast Flipping
+    auto size = std::max(surface->w, surface->h);
 
     //Use cached data
     ARRAY_FOREACH(p, compositors) {
         auto cur = *p;
-        if (cur->compositor->valid && cur->compositor->image.channelSize == channelSize) {
-            if (w == cur->w && h == cur->h) {
+        if (cur->compositor->valid && cur->compositor->capacity == 0 && cur->compositor->image.channelSize == channelSize) {
+            if (size == cur->w && size == cur->h) {
                 cmp = *p;
                 break;
             }
@@ -609,15 +716,17 @@ SwSurface* SwRenderer::request(int channelSize, bool square)
         //Inherits attributes from main surface
         cmp = new SwSurface(surface);
         cmp->compositor = new SwCompositor;
-        cmp->compositor->image.data = tvg::malloc<pixel_t>(channelSize * w * h);
-        cmp->w = cmp->compositor->image.w = w;
-        cmp->h = cmp->compositor->image.h = h;
-        cmp->stride = cmp->compositor->image.stride = w;
+        cmp->compositor->image.data = tvg::malloc<pixel_t>(channelSize * size * size);
+        cmp->w = cmp->compositor->image.w = size;
+        cmp->h = cmp->compositor->image.h = size;
+        cmp->stride = cmp->compositor->image.stride = size;
         cmp->compositor->image.direct = true;
         cmp->compositor->valid = true;
         cmp->channelSize = cmp->compositor->image.channelSize = channelSize;
+        cmp->region = {{0, 0}, {int32_t(size), int32_t(size)}};
 
         compositors.push(cmp);
+        RENDER_STATS(this, compositors, 1);
     }
 
     //Sync. This may have been modified by post-processing.
@@ -627,12 +736,77 @@ SwSurface* SwRenderer::request(int channelSize, bool square)
 }
 
 
+SwSurface* SwRenderer::request(int channelSize, const RenderRegion& region)
+{
+    SwSurface* cmp = nullptr;    //best fit
+    SwSurface* less = nullptr;   //too small, but can be grown
+    auto size = region.w() * region.h();
+
+    //Use cached data
+    ARRAY_FOREACH(p, compositors) {
+        auto cur = (*p)->compositor;
+        if (!cur->valid || cur->capacity == 0 || cur->image.channelSize != channelSize) continue;
+        if (cur->capacity >= size) {
+            if (!cmp || cur->capacity < cmp->compositor->capacity) cmp = *p;
+        } else less = *p;
+    }
+
+    if (!cmp) {
+        //pow2 buckets let the buffers be recycled across the frames while the regions vary
+        auto capacity = std::min(_alignPow2(size), surface->w * surface->h);
+
+        if (less) {
+            cmp = less;
+            tvg::free(cmp->compositor->buffer);
+        //New Composition
+        } else {
+            //Inherits attributes from main surface
+            cmp = new SwSurface(surface);
+            cmp->compositor = new SwCompositor;
+            cmp->w = surface->w;
+            cmp->h = surface->h;
+            cmp->compositor->image.direct = true;
+            cmp->compositor->valid = true;
+            cmp->channelSize = cmp->compositor->image.channelSize = channelSize;
+
+            compositors.push(cmp);
+        }
+        cmp->compositor->buffer = tvg::malloc<pixel_t>(channelSize * capacity);
+        cmp->compositor->capacity = capacity;
+        RENDER_STATS(this, compositors, 1);
+    }
+
+    /* The buffer only covers the region. The raster paths address the pixels in the canvas coordinates,
+       the surface region and the image offset translate them into the buffer. */
+    cmp->data = cmp->compositor->image.data = cmp->compositor->buffer;
+    cmp->stride = cmp->compositor->image.stride = cmp->compositor->image.w = region.w();
+    cmp->compositor->image.h = region.h();
+    cmp->compositor->image.ox = -region.sx();
+    cmp->compositor->image.oy = -region.sy();
+    cmp->region = region;
+
+    return cmp;
+}
+
+
 RenderCompositor* SwRenderer::target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags)
 {
-    auto bbox = RenderRegion::intersect(region, {{0, 0}, {int32_t(surface->w), int32_t(surface->h)}});
-    if (bbox.invalid()) return nullptr;
+    RENDER_STATS_TIME(this, composite);
+
+    SwSurface* cmp;
+    RenderRegion bbox;
 
-    auto cmp = request(CHANNEL_SIZE(cs), (flags & CompositionFlag::PostProcessing));
+    //Post effects may spread the pixels out of the current target, they work on a canvas-sized one.
+    if (flags & CompositionFlag::PostProcessing) {
+        bbox = RenderRegion::intersect(region, {{0, 0}, {int32_t(surface->w), int32_t(surface->h)}});
+        if (bbox.invalid()) return nullptr;
+        cmp = request(CHANNEL_SIZE(cs));
+    //Otherwise, only the pixels inside of the current target could be composited back.
+    } else {
+        bbox = _clip(surface, region);
+        if (bbox.invalid()) return nullptr;
+        cmp = request(CHANNEL_SIZE(cs), bbox);
+    }
     cmp->compositor->recoverSfc = surface;
     cmp->compositor->recoverCmp = surface->compositor;
     cmp->compositor->valid = false;
@@ -653,6 +827,8 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 {
     if (!cmp) return false;
 
+    RENDER_STATS_TIME(this, composite);
+
     auto p = static_cast<SwCompositor*>(cmp);
 
     //Recover Context
@@ -665,7 +841,7 @@ bool SwRenderer::endComposite(RenderCompositor* cmp)
 
     //Default is alpha blending
     if (p->method == MaskMethod::None) {
-        return rasterDirectImage(surface, p->image, p->bbox, p->opacity);
+        return rasterDirectImage(surface, p->image, _clip(surface, p->bbox), p->opacity);
     }
 
     return true;
@@ -763,6 +939,8 @@ bool SwRenderer::region(RenderEffect* effect)
 
 bool SwRenderer::render(RenderCompositor* cmp, const RenderEffect* effect, bool direct)
 {
+    RENDER_STATS_TIME(this, effect);
+
     auto p = static_cast<SwCompositor*>(cmp);
 
     if (p->image.channelSize != sizeof(uint32_t)) {
@@ -772,15 +950,18 @@ bool SwRenderer::render(RenderCompositor* cmp, const RenderEffect* effect, bool
 
     //TODO: Support grayscale effects.
     if (p->recoverSfc->channelSize != sizeof(uint32_t)) direct = false;
+
+    //The origin surface might not cover the whole region of the effect.
+    if (!p->recoverSfc->region.contained(p->bbox)) direct = false;
     
     switch (effect->type) {
         case SceneEffect::GaussianBlur: {
-            return effectGaussianBlur(p, request(surface->channelSize, true), static_cast<const RenderEffectGaussianBlur*>(effect));
+            return effectGaussianBlur(p, request(surface->channelSize), static_cast<const RenderEffectGaussianBlur*>(effect));
         }
         case SceneEffect::DropShadow: {
-            auto cmp1 = request(surface->channelSize, true);
+            auto cmp1 = request(surface->channelSize);
             cmp1->compositor->valid = false;   //prevent a conflict with cmp2 request.
-            auto cmp2 = request(surface->channelSize, true);
+            auto cmp2 = request(surface->channelSize);
             SwSurface* surfaces[] = {cmp1, cmp2};
             auto ret = effectDropShadow(p, surfaces, static_cast<const RenderEffectDropShadow*>(effect), direct);
             cmp1->compositor->valid = true;
@@ -850,7 +1031,10 @@ SwTask* SwRenderer::prepareCommon(SwTask* task, const Matrix& transform, const A
 
     if (task->ready(ready)) return task;
 
-    if (flags) TaskScheduler::request(task);
+    if (flags) {
+        TaskScheduler::request(task);
+        RENDER_STATS(this, tasks, 1);
+    }
 
     return task;
 }
@@ -872,12 +1056,35 @@ RenderData SwRenderer::prepare(const RenderShape& rshape, RenderData data, const
 {
     auto task = static_cast<SwShapeTask*>(data);
     if (task) task->done();
-    else {
-        task = new SwShapeTask;
-        task->rshape = &rshape;
-    }
-
+    else task = new SwShapeTask;
+
+    //the previous rle is reusable when the current one was fully drawn and it's translated by whole pixels
+    auto& prev = task->transform;
+    auto dx = transform.e13 - prev.e13;
+    auto dy = transform.e23 - prev.e23;
+    task->shift.valid = data && task->valid && !task->shape.fastTrack && task->rshape == &rshape && task->curBox.min.x > task->clipBox.min.x && task->curBox.min.y > task->clipBox.min.y && task->curBox.max.x < task->clipBox.max.x && task->curBox.max.y < task->clipBox.max.y &&
+                        prev.e11 == transform.e11 && prev.e12 == transform.e12 && prev.e21 == transform.e21 && prev.e22 == transform.e22 && prev.e31 == transform.e31 && prev.e32 == transform.e32 && prev.e33 == transform.e33 &&
+                        dx == floorf(dx) && dy == floorf(dy) && fabsf(dx) < 65536.0f && fabsf(dy) < 65536.0f;
+    if (task->shift.valid) task->shift = {int32_t(dx), int32_t(dy), true};
+
+    task->rshape = &rshape;   //an instance may switch its shape data
     task->clipper = clipper;
+    task->origin = nullptr;
+
+    //the instances of a shape share the path, the rle can be copied if the subpixel positions are the same
+    if (clips.count == 0 && !clipper && !rshape.path.pts.empty()) {
+        auto& origin = instances[rshape.path.pts.data];
+        if (!origin) origin = task;
+        else if (origin != task) {
+            auto& m = origin->transform;
+            auto dx = transform.e13 - m.e13;
+            auto dy = transform.e23 - m.e23;
+            if (m.e11 == transform.e11 && m.e12 == transform.e12 && m.e21 == transform.e21 && m.e22 == transform.e22 && m.e31 == transform.e31 && m.e32 == transform.e32 && m.e33 == transform.e33 &&
+                dx == floorf(dx) && dy == floorf(dy) && fabsf(dx) < 65536.0f && fabsf(dy) < 65536.0f) {
+                task->origin = static_cast<SwShapeTask*>(origin);
+            }
+        }
+    }
 
     return prepareCommon(task, transform, clips, opacity, flags, (opacity == 0 && !clipper));
 }
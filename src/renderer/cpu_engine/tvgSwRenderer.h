@@ -24,6 +24,7 @@
 #define _TVG_SW_RENDERER_H_
 
 #include "tvgRender.h"
+#include "tvgMap.h"
 
 struct SwSurface;
 struct SwTask;
@@ -57,7 +58,8 @@ struct SwRenderer : RenderMethod
     Result target(pixel_t* data, uint32_t stride, uint32_t w, uint32_t h, ColorSpace cs);
 
     //composition
-    SwSurface* request(int channelSize, bool square);
+    SwSurface* request(int channelSize);
+    SwSurface* request(int channelSize, const RenderRegion& region);
     RenderCompositor* target(const RenderRegion& region, ColorSpace cs, CompositionFlag flags) override;
     bool beginComposite(RenderCompositor* cmp, MaskMethod method, uint8_t opacity) override;
     bool endComposite(RenderCompositor* cmp) override;
@@ -84,6 +86,7 @@ private:
     bool                 fulldraw = true;             //buffer is cleared (need to redraw full screen)
     Array<SwTask*>       tasks;                       //async task list
     Array<SwSurface*>    compositors;                 //render targets cache list
+    Map<const Point*, SwTask*> instances;             //the first shape task of each shared path in an update, keyed by the path
     RenderDirtyRegion    dirtyRegion;                 //partial rendering support
 
     ~SwRenderer();
@@ -190,6 +190,7 @@
 
 #include <limits.h>
 #include "tvgSwCommon.h"
+#include "tvgTrace.h"
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -205,7 +206,7 @@ struct Band
 
 struct RleWorker
 {
-    SwRle* rle;
+    Array<SwSpan>* spans;   //the per-worker slab
 
     SwPoint cellPos;
     SwPoint cellMin;
@@ -232,7 +233,6 @@ struct RleWorker
     SwOutline* outline;
 
     int bandSize;
-    int bandShoot;
 
     SwCell* buffer;
     uint32_t bufferSize;
@@ -334,13 +334,13 @@ static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_
 
     if (coverage == 0) return;
 
-    auto rle = rw.rle;
+    auto& spans = *rw.spans;
 
     if (!rw.antiAlias) coverage = 255;
 
     //see whether we can add this span to the current list
-    if (!rle->spans.empty()) {
-        auto& span = rle->spans.last();
+    if (!spans.empty()) {
+        auto& span = spans.last();
         if ((span.coverage == coverage) && (span.y == y) && (span.x + span.len == x)) {
             //Clip x range
             int32_t xOver = 0;
@@ -363,7 +363,7 @@ static void _horizLine(RleWorker& rw, int32_t x, int32_t y, int32_t area, int32_
     if (aCount + xOver <= 0) return;
 
     //add a span to the current list
-    rle->spans.next() = {x, y,  aCount + xOver, (uint8_t)coverage};
+    spans.next() = {x, y,  aCount + xOver, (uint8_t)coverage};
 }
 
 
@@ -731,6 +731,37 @@ static bool _decomposeOutline(RleWorker& rw)
 }
 
 
+//estimate the cells of the outline, an edge passes through its manhattan length of pixels at most
+static size_t _cellDemand(const SwOutline* outline, const RenderRegion& bbox)
+{
+    uint64_t len = 0;
+    auto pts = outline->out.data;
+    uint32_t first = 0;
+
+    ARRAY_FOREACH(p, outline->cntrs) {
+        auto last = *p;
+        for (auto i = first; i < last; ++i) {
+            len += abs(pts[i + 1].x - pts[i].x) + abs(pts[i + 1].y - pts[i].y);
+        }
+        len += abs(pts[first].x - pts[last].x) + abs(pts[first].y - pts[last].y);  //closing edge
+        first = last + 1;
+    }
+
+    //26.6 fixed-point to pixels, plus the cells of the points. no more than the pixels of the area
+    return size_t(std::min((len >> 6) + outline->out.count, uint64_t(bbox.w()) * bbox.h()));
+}
+
+
+//keep the capacity of the rle across the frames, but release it if it's mostly wasted
+static void _commit(SwRle* rle, const Array<SwSpan>& spans)
+{
+    if (rle->spans.reserved > SW_SPAN_COMPACT_SIZE && spans.count < (rle->spans.reserved >> 2)) rle->spans.reset();
+    //a margin for the slight changes of the next frames
+    if (spans.count > rle->spans.reserved) rle->spans.reserve(spans.count + (spans.count >> 2));
+    rle->spans = spans;
+}
+
+
 static bool _genRle(RleWorker& rw)
 {
     if (!_decomposeOutline(rw)) return false;
@@ -746,17 +777,17 @@ static bool _genRle(RleWorker& rw)
 SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox, SwMpool* mpool, unsigned tid, bool antiAlias)
 {
     if (!outline) return nullptr;
+
+    TVGTRACE("rleRender");
   
     RleWorker rw;
     auto cellPool = mpool->cell(tid);
-    auto reqSize = uint32_t(std::max(bbox.w(), bbox.h()) * 0.75f) * sizeof(SwCell);  //experimental decision
 
-    // grow by 1.25x and align to multiple of sizeof(SwCell)
-    if (reqSize > cellPool->size) {
-        cellPool->size = ((reqSize + (reqSize >> 2)) / sizeof(SwCell)) * sizeof(SwCell);
-        tvg::free(cellPool->buffer);
-        cellPool->buffer = tvg::malloc<SwCell>(cellPool->size);
-    }
+    //the pool to cover the whole shape in a single band, with the margin learned from the previous overflows
+    auto rows = bbox.h();
+    auto demand = _cellDemand(outline, bbox);
+    auto reqSize = rows * sizeof(SwCell*) + (demand + (demand * cellPool->margin) / 100 + 1) * sizeof(SwCell);
+    cellPool->grow(reqSize);
 
     //Init Cells
     rw.buffer = cellPool->buffer;
@@ -773,19 +804,19 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
     rw.cellXCnt = rw.cellMax.x - rw.cellMin.x;
     rw.cellYCnt = rw.cellMax.y - rw.cellMin.y;
     rw.outline = const_cast<SwOutline*>(outline);
-    rw.bandSize = rw.bufferSize / (sizeof(SwCell) * 2);
-    rw.bandShoot = 0;
+    //split the bands in proportion to the shortage of the pool
+    rw.bandSize = (reqSize <= rw.bufferSize) ? rows : std::max(int(size_t(rows) * rw.bufferSize / reqSize), 1);
     rw.antiAlias = antiAlias;
 
-    if (!rle) rw.rle = new SwRle;
-    else rw.rle = rle;
-    rw.rle->spans.reserve(256);
+    //the spans are collected in the worker's slab, then copied to the rle keeping its capacity
+    rw.spans = mpool->spans(tid);
 
     //Generate RLE
     constexpr auto BAND_SIZE = 40;
 
     Band bands[BAND_SIZE];
     Band* band;
+    uint32_t retries = 0;
 
     /* set up vertical bands */
     auto bandCnt = static_cast<int>((rw.cellMax.y - rw.cellMin.y) / rw.bandSize);
@@ -845,11 +876,12 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
             /* This is too complex for a single scanline; there must
                be some problems */
             if (middle == bottom) {
-                rleFree(rw.rle);
+                rleFree(rle);
                 return nullptr;
             }
 
-            if (bottom - top >= rw.bandSize) ++rw.bandShoot;
+            ++cellPool->retries;
+            ++retries;
 
             band[1].min = bottom;
             band[1].max = middle;
@@ -858,16 +890,19 @@ SwRle* rleRender(SwRle* rle, const SwOutline* outline, const RenderRegion& bbox,
             ++band;
         }
     }
-    if (rw.bandShoot > 8 && rw.bandSize > 16) {
-        rw.bandSize = (rw.bandSize >> 1);
-    }
-    return rw.rle;
+    //underestimated, prepare a larger pool for the next shapes
+    if (retries > 0 && reqSize <= SW_CELL_POOL_LIMIT) cellPool->overflow();
+
+    if (!rle) rle = new SwRle;
+    _commit(rle, *rw.spans);
+
+    return rle;
 }
 
 
 SwRle* rleRender(const RenderRegion* bbox)
 {
-    auto rle = tvg::calloc<SwRle>(sizeof(SwRle), 1);
+    auto rle = new SwRle;
     rle->spans.reserve(bbox->h());
     rle->spans.count = bbox->h();
 
@@ -890,18 +925,27 @@ void rleReset(SwRle* rle)
 }
 
 
+void rleTranslate(SwRle* rle, int32_t x, int32_t y)
+{
+    if (!rle) return;
+    ARRAY_FOREACH(p, rle->spans) {
+        p->x += x;
+        p->y += y;
+    }
+}
+
+
 void rleFree(SwRle* rle)
 {
     delete(rle);
 }
 
 
-bool rleClip(SwRle* rle, const SwRle *clip)
+bool rleClip(SwRle* rle, const SwRle *clip, SwMpool* mpool, unsigned tid)
 {
     if (rle->spans.empty() || clip->spans.empty()) return false;
 
-    Array<SwSpan> out;
-    out.reserve(std::max(rle->spans.count, clip->spans.count));
+    auto& out = *mpool->spans(tid);
 
     const SwSpan *end;
     auto spans = rle->fetch(clip->spans.first().y, clip->spans.last().y, &end);
@@ -940,7 +984,7 @@ bool rleClip(SwRle* rle, const SwRle *clip)
         }
         ++spans;
     }
-    out.move(rle->spans);
+    _commit(rle, out);
     return true;
 }
 
@@ -953,9 +997,8 @@ bool rleClip(SwRle *rle, const RenderRegion* clip)
     auto& min = clip->min;
     auto& max = clip->max;
 
-    Array<SwSpan> out;
-    out.reserve(rle->spans.count);
-    auto data = out.data;
+    //clipped in place, the spans only shrink
+    auto data = rle->spans.data;
     const SwSpan* end;
     int32_t x, len;
 
@@ -972,10 +1015,9 @@ bool rleClip(SwRle *rle, const RenderRegion* clip)
         if (len > 0) {
             *data = {x, p->y, len, p->coverage};
             ++data;
-            ++out.count;
         }
     }
-    out.move(rle->spans);
+    rle->spans.count = data - rle->spans.data;
     return true;
 }
 
@@ -232,31 +232,25 @@ static void _dashMoveTo(SwDashStroke& dash, uint32_t offIdx, float offset, const
     dash.move = true;
 }
 
+static const RenderPath* _trimmedPath(const RenderShape* rshape, SwMpool* mpool, unsigned tid)
+{
+    auto trimmed = mpool->path(tid);
+    if (!rshape->stroke->trim.trim(rshape->path, *trimmed)) return nullptr;
+    return trimmed;
+}
+
+
 static SwOutline* _genDashOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed)
 {
-    PathCommand *cmds, *tcmds = nullptr;
-    Point *pts, *tpts = nullptr;
-    uint32_t cmdCnt, ptsCnt;
-
-    if (trimmed) {
-        RenderPath trimmed;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmed)) return nullptr;
-        cmds = tcmds = trimmed.cmds.data;
-        cmdCnt = trimmed.cmds.count;
-        pts = tpts = trimmed.pts.data;
-        ptsCnt = trimmed.pts.count;
-
-        trimmed.cmds.data = nullptr;
-        trimmed.pts.data = nullptr;
-    } else {
-        cmds = rshape->path.cmds.data;
-        cmdCnt = rshape->path.cmds.count;
-        pts = rshape->path.pts.data;
-        ptsCnt = rshape->path.pts.count;
-    }
+    auto path = trimmed ? _trimmedPath(rshape, mpool, tid) : &rshape->path;
+    if (!path) return nullptr;
+
+    auto cmds = path->cmds.data;
+    auto cmdCnt = path->cmds.count;
+    auto pts = path->pts.data;
 
     //No actual shape data
-    if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
+    if (cmdCnt == 0 || path->pts.count == 0) return nullptr;
 
     SwDashStroke dash;
     dash.pattern = rshape->stroke->dash.pattern;
@@ -320,9 +314,6 @@ static SwOutline* _genDashOutline(const RenderShape* rshape, SwMpool* mpool, uns
 
     dash.outline->fillRule = rshape->rule;
 
-    tvg::free(tcmds);
-    tvg::free(tpts);
-
     return dash.outline;
 }
 
@@ -345,32 +336,8 @@ static bool _axisAlignedRect(const SwOutline* outline)
     return false;
 }
 
-static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed = false)
+static SwOutline* _genOutline(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, FillRule rule, SwMpool* mpool, unsigned tid)
 {
-    PathCommand *cmds, *tcmds = nullptr;
-    Point *pts, *tpts = nullptr;
-    uint32_t cmdCnt, ptsCnt;
-
-    if (trimmed) {
-        RenderPath trimmed;
-        if (!rshape->stroke->trim.trim(rshape->path, trimmed)) return nullptr;
-        cmds = tcmds = trimmed.cmds.data;
-        cmdCnt = trimmed.cmds.count;
-        pts = tpts = trimmed.pts.data;
-        ptsCnt = trimmed.pts.count;
-
-        trimmed.cmds.data = nullptr;
-        trimmed.pts.data = nullptr;
-    } else {
-        cmds = rshape->path.cmds.data;
-        cmdCnt = rshape->path.cmds.count;
-        pts = rshape->path.pts.data;
-        ptsCnt = rshape->path.pts.count;
-    }
-
-    // No actual shape data
-    if (cmdCnt == 0 || ptsCnt == 0) return nullptr;
-
     auto outline = mpool->outline(tid);
     auto closed = false;
 
@@ -404,20 +371,200 @@ static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigne
 
     if (!closed) _outlineEnd(*outline);
 
-    outline->fillRule = rshape->rule;
-
-    tvg::free(tcmds);
-    tvg::free(tpts);
+    outline->fillRule = rule;
 
     return outline;
 }
 
+static SwOutline* _genOutline(const RenderShape* rshape, SwMpool* mpool, unsigned tid, bool trimmed = false)
+{
+    auto path = trimmed ? _trimmedPath(rshape, mpool, tid) : &rshape->path;
+
+    // No actual shape data
+    if (!path || path->cmds.empty() || path->pts.empty()) return nullptr;
+
+    return _genOutline(path->cmds.data, path->cmds.count, path->pts.data, rshape->rule, mpool, tid);
+}
+
+#define SW_GLYPH_SUBPIXEL 4     //subpixel positions of a glyph per pixel
+#define SW_GLYPH_MAX_SIZE 256   //the largest em size in pixels to be cached
+
+//the spans of a cached glyph placed in the text
+struct SwGlyphSpans
+{
+    const SwSpan* span;
+    const SwSpan* end;
+    int32_t x, y;
+};
+
+static bool _glyphCacheable(const RenderShape* rshape, const Matrix& transform)
+{
+    auto glyphs = rshape->glyphs;
+    if (!glyphs || glyphs->data.empty() || rshape->rule != FillRule::NonZero || rshape->trimpath()) return false;
+
+    //neither rotated, skewed nor projected
+    if (!tvg::zero(transform.e12) || !tvg::zero(transform.e21) || !tvg::zero(transform.e31) || !tvg::zero(transform.e32)) return false;
+
+    return (fabsf(transform.e11) * glyphs->em <= SW_GLYPH_MAX_SIZE && fabsf(transform.e22) * glyphs->em <= SW_GLYPH_MAX_SIZE);
+}
+
+static const SwGlyph* _glyph(SwGlyphCache* cache, const RenderShape* rshape, const RenderGlyph& glyph, const Matrix& transform, uint8_t subpixel, SwMpool* mpool, unsigned tid)
+{
+    auto font = rshape->glyphs->font;
+    uint32_t sx, sy;
+    memcpy(&sx, &transform.e11, sizeof(sx));
+    memcpy(&sy, &transform.e22, sizeof(sy));
+    auto key = (uint64_t(font) << 32 | glyph.idx) ^ ((uint64_t(sx) << 32 | sy) * 0x9e3779b97f4a7c15ULL) ^ subpixel;
+
+    if (auto it = cache->index.find(key)) {
+        auto cached = &cache->glyphs[it->val];
+        if (cached->font == font && cached->idx == glyph.idx && cached->sx == transform.e11 && cached->sy == transform.e22 && cached->subpixel == subpixel) return cached;
+        return nullptr;  //hash collision, no replacement since the spans could be in use
+    }
+
+    //rasterize the glyph at the subpixel offset from the integer origin
+    auto fx = float(subpixel & 0x0f) / SW_GLYPH_SUBPIXEL;
+    auto fy = float(subpixel >> 4) / SW_GLYPH_SUBPIXEL;
+    Matrix m = {transform.e11, 0.0f, fx - transform.e11 * glyph.origin.x, 0.0f, transform.e22, fy - transform.e22 * glyph.origin.y, 0.0f, 0.0f, 1.0f};
+
+    auto outline = _genOutline(rshape->path.cmds.data + glyph.cmd, glyph.cmdCnt, rshape->path.pts.data + glyph.pt, rshape->rule, mpool, tid);
+
+    BBox bbox;
+    utilExport(outline, m, bbox);
+
+    //the exported coordinates are truncated toward zero, keep them positive to match the text rasterized on the canvas
+    auto ox = std::min((int32_t)floorf(bbox.min.x), 0);
+    auto oy = std::min((int32_t)floorf(bbox.min.y), 0);
+    if (ox < 0 || oy < 0) {
+        m.e13 -= ox;
+        m.e23 -= oy;
+        outline->out.clear();
+        utilExport(outline, m, bbox);
+    }
+
+    SwGlyph cached = {font, glyph.idx, transform.e11, transform.e22, subpixel, nullptr, {}};
+    cached.bbox = {{(int32_t)floorf(bbox.min.x), (int32_t)floorf(bbox.min.y)}, {(int32_t)ceilf(bbox.max.x), (int32_t)ceilf(bbox.max.y)}};
+    if (cached.bbox.valid()) cached.rle = rleRender(nullptr, outline, cached.bbox, mpool, tid, true);
+    else cached.rle = new SwRle;
+    if (!cached.rle) return nullptr;
+
+    //back to the glyph origin
+    ARRAY_FOREACH(span, cached.rle->spans) {
+        span->x += ox;
+        span->y += oy;
+    }
+    cached.bbox.min.x += ox;
+    cached.bbox.min.y += oy;
+    cached.bbox.max.x += ox;
+    cached.bbox.max.y += oy;
+
+    cache->index[key] = cache->glyphs.count;
+    cache->glyphs.push(cached);
+    return &cache->glyphs.last();
+}
+
+//compose the text coverage from the cached glyph coverages, return false to fall back to the outline rasterization
+static bool _genGlyphRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid)
+{
+    auto cache = mpool->glyphs(tid);
+
+    //flush the cache in advance, the cached spans are referred until the text is composed
+    if (cache->glyphs.count > SW_GLYPH_CACHE_SIZE) cache->reset();
+
+    Array<SwGlyphSpans> placed;
+    placed.reserve(rshape->glyphs->data.count);
+    RenderRegion bbox = {{INT32_MAX, INT32_MAX}, {INT32_MIN, INT32_MIN}};
+
+    ARRAY_FOREACH(p, rshape->glyphs->data) {
+        auto pos = p->origin * transform;
+        auto x = (int32_t)floorf(pos.x);
+        auto y = (int32_t)floorf(pos.y);
+        auto fx = (int32_t)((pos.x - x) * SW_GLYPH_SUBPIXEL + 0.5f);
+        auto fy = (int32_t)((pos.y - y) * SW_GLYPH_SUBPIXEL + 0.5f);
+        if (fx == SW_GLYPH_SUBPIXEL) {
+            fx = 0;
+            ++x;
+        }
+        if (fy == SW_GLYPH_SUBPIXEL) {
+            fy = 0;
+            ++y;
+        }
+        auto glyph = _glyph(cache, rshape, *p, transform, uint8_t(fy << 4 | fx), mpool, tid);
+        if (!glyph) return false;
+        if (glyph->rle->invalid()) continue;
+        placed.push({glyph->rle->spans.begin(), glyph->rle->spans.end(), x, y});
+        bbox.add({{glyph->bbox.min.x + x, glyph->bbox.min.y + y}, {glyph->bbox.max.x + x, glyph->bbox.max.y + y}});
+    }
+
+    renderBox = bbox;
+    renderBox.intersect(clipBox);
+    if (placed.empty() || renderBox.invalid()) {
+        renderBox.reset();
+        return true;
+    }
+
+    std::sort(placed.begin(), placed.end(), [](const SwGlyphSpans& lhs, const SwGlyphSpans& rhs) {
+        return lhs.span->y + lhs.y < rhs.span->y + rhs.y;
+    });
+
+    if (!shape.rle) shape.rle = new SwRle;
+    auto& spans = shape.rle->spans;
+
+    //accumulate the overlapped glyph coverages per scanline
+    auto w = renderBox.sw();
+    auto cover = mpool->cover(tid, w);
+    Array<SwGlyphSpans*> active;
+    auto next = placed.begin();
+
+    for (auto y = renderBox.min.y; y < renderBox.max.y; ++y) {
+        while (next < placed.end() && next->span->y + next->y <= y) active.push(next++);
+
+        auto min = w, max = 0;
+        for (uint32_t i = 0; i < active.count;) {
+            auto g = active[i];
+            while (g->span < g->end && g->span->y + g->y < y) ++g->span;
+            while (g->span < g->end && g->span->y + g->y == y) {
+                auto x1 = std::max(g->span->x + g->x - renderBox.min.x, 0);
+                auto x2 = std::min(g->span->x + g->x + g->span->len - renderBox.min.x, w);
+                for (auto x = x1; x < x2; ++x) {
+                    auto c = cover[x] + g->span->coverage;
+                    cover[x] = c > 255 ? 255 : c;
+                }
+                if (x1 < x2) {
+                    if (x1 < min) min = x1;
+                    if (x2 > max) max = x2;
+                }
+                ++g->span;
+            }
+            if (g->span < g->end) ++i;
+            else active[i] = active[--active.count];
+        }
+
+        for (auto x = min; x < max;) {
+            auto begin = x;
+            auto c = cover[x];
+            while (x < max && cover[x] == c) cover[x++] = 0;
+            if (c > 0) spans.push({begin + renderBox.min.x, y, x - begin, c});
+        }
+    }
+
+    if (spans.empty()) renderBox.reset();
+    shape.bbox = renderBox;
+
+    return true;
+}
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
 bool shapeGenRle(SwShape& shape, const RenderShape* rshape, const Matrix& transform, const RenderRegion& clipBox, RenderRegion& renderBox, SwMpool* mpool, unsigned tid, bool composite, bool antiAlias)
 {
+    //texts reuse the cached glyph coverages as long as they are neither rotated nor skewed
+    if (antiAlias && _glyphCacheable(rshape, transform) && _genGlyphRle(shape, rshape, transform, clipBox, renderBox, mpool, tid)) {
+        return renderBox.valid();
+    }
+
     auto outline = _genOutline(rshape, mpool, tid, rshape->trimpath());
     if (!outline || outline->in.empty()) {
         renderBox.reset();
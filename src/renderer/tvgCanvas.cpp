@@ -23,6 +23,7 @@
 #include "tvgCanvas.h"
 #include "tvgTaskScheduler.h"
 #include "tvgLoader.h"
+#include "tvgTrace.h"
 
 #ifdef THORVG_CPU_ENGINE_SUPPORT
     #include "tvgSwRenderer.h"
@@ -58,6 +59,12 @@ const list<Paint*>& Canvas::paints() const noexcept
 }
 
 
+uint32_t Canvas::paints(Paint* const** paints) const noexcept
+{
+    return pImpl->scene->paints(paints);
+}
+
+
 Result Canvas::add(Paint* target, Paint* at) noexcept
 {
     if (target) return pImpl->add(target, at);
@@ -67,6 +74,7 @@ Result Canvas::add(Paint* target, Paint* at) noexcept
 
 Result Canvas::draw(bool clear) noexcept
 {
+    TVGTRACE("Canvas::draw");
     TVGLOG("RENDERER", "Draw S. -------------------------------- Canvas(%p)", this);
     auto ret = pImpl->draw(clear);
     TVGLOG("RENDERER", "Draw E. -------------------------------- Canvas(%p)", this);
@@ -77,6 +85,7 @@ Result Canvas::draw(bool clear) noexcept
 
 Result Canvas::update() noexcept
 {
+    TVGTRACE("Canvas::update");
     TVGLOG("RENDERER", "Update S. ------------------------------ Canvas(%p)", this);
     auto ret = pImpl->update();
     TVGLOG("RENDERER", "Update E. ------------------------------ Canvas(%p)", this);
@@ -99,10 +108,17 @@ Result Canvas::viewport(int32_t x, int32_t y, int32_t w, int32_t h) noexcept
 
 Result Canvas::sync() noexcept
 {
+    TVGTRACE("Canvas::sync");
     return pImpl->sync();
 }
 
 
+Result Canvas::stats(FrameStats* stats) const noexcept
+{
+    return pImpl->stats(stats);
+}
+
+
 /************************************************************************/
 /* SwCanvas Class Implementation                                        */
 /************************************************************************/
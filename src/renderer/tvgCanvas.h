@@ -24,6 +24,7 @@
 #define _TVG_CANVAS_H_
 
 #include "tvgPaint.h"
+#include "tvgLoaderMgr.h"
 
 enum Status : uint8_t {Synced = 0, Painting, Updating, Drawing, Damaged};
 
@@ -90,8 +91,16 @@ struct Canvas::Impl
 
         if (!renderer->preUpdate()) return Result::InsufficientCondition;
 
+#ifdef THORVG_STATS_SUPPORT
+        renderer->stats.reset();
+#endif
+        RENDER_STATS_TIME(renderer, update);
+
         clips.clear();
 
+        //Drop the decoded images over the memory budget, nothing is being rendered at this point.
+        LoaderMgr::evict(renderer);
+
         auto m = tvg::identity();
         PAINT(scene)->update(renderer, m, clips, 255, flag);
 
@@ -109,6 +118,9 @@ struct Canvas::Impl
         }
         if (status == Status::Painting || status == Status::Damaged) update();
         if (status != Status::Updating) return Result::InsufficientCondition;
+
+        RENDER_STATS_TIME(renderer, render);
+
         if (clear && !renderer->clear()) return Result::InsufficientCondition;
         if (!renderer->preRender()) return Result::InsufficientCondition;
         if (!PAINT(scene)->render(renderer) || !renderer->postRender()) return Result::InsufficientCondition;
@@ -121,6 +133,9 @@ struct Canvas::Impl
     Result sync()
     {
         if (status == Status::Synced) return Result::Success;
+
+        RENDER_STATS_TIME(renderer, render);
+
         if (renderer->sync()) {
             status = Status::Synced;
             return Result::Success;
@@ -128,6 +143,19 @@ struct Canvas::Impl
         return Result::Unknown;
     }
 
+    Result stats(FrameStats* stats)
+    {
+#ifdef THORVG_STATS_SUPPORT
+        if (!stats) return Result::InvalidArguments;
+        if (status != Status::Synced) return Result::InsufficientCondition;
+
+        auto& src = renderer->stats;
+        *stats = {float(src.update), float(src.render), float(src.composite), float(src.effect), src.tessellated, src.reused, src.spans, src.compositors, src.tasks, src.area, src.retries};
+        return Result::Success;
+#endif
+        return Result::NonSupport;
+    }
+
     Result viewport(int32_t x, int32_t y, int32_t w, int32_t h)
     {
         if (status == Status::Synced || status == Status::Damaged) {
@@ -46,9 +46,13 @@ struct Fill::Impl
 
     void copy(const Fill::Impl& dup)
     {
+        //keep the current buffer if it fits
+        if (!colorStops || cnt != dup.cnt) {
+            tvg::free(colorStops);
+            colorStops = tvg::malloc<ColorStop>(sizeof(ColorStop) * dup.cnt);
+        }
         cnt = dup.cnt;
         spread = dup.spread;
-        colorStops = tvg::malloc<ColorStop>(sizeof(ColorStop) * dup.cnt);
         if (dup.cnt > 0) memcpy(colorStops, dup.colorStops, sizeof(ColorStop) * dup.cnt);
         transform = dup.transform;
     }
@@ -89,9 +93,9 @@ struct RadialGradientImpl : RadialGradient
         Fill::pImpl = &impl;
     }
 
-    Fill* duplicate() const
+    Fill* duplicate(Fill* ret = nullptr) const
     {
-        auto ret = RadialGradient::gen();
+        if (!ret) ret = RadialGradient::gen();
         RADIAL(ret)->impl.copy(this->impl);
         RADIAL(ret)->center = center;
         RADIAL(ret)->r = r;
@@ -165,9 +169,9 @@ struct LinearGradientImpl :  LinearGradient
         Fill::pImpl = &impl;
     }
 
-    Fill* duplicate() const
+    Fill* duplicate(Fill* ret = nullptr) const
     {
-        auto ret = LinearGradient::gen();
+        if (!ret) ret = LinearGradient::gen();
         LINEAR(ret)->impl.copy(this->impl);
         LINEAR(ret)->p1 = p1;
         LINEAR(ret)->p2 = p2;
@@ -195,4 +199,16 @@ struct LinearGradientImpl :  LinearGradient
 };
 
 
+//copy the fill into the target if they are the same type, otherwise replace the target with a duplicate
+static inline Fill* fillDuplicate(const Fill* fill, Fill* target)
+{
+    if (fill && target && fill->type() == target->type()) {
+        if (fill->type() == Type::LinearGradient) return CONST_LINEAR(fill)->duplicate(target);
+        return CONST_RADIAL(fill)->duplicate(target);
+    }
+    delete(target);
+    return fill ? fill->duplicate() : nullptr;
+}
+
+
 #endif  //_TVG_FILL_H_
@@ -23,6 +23,7 @@
 #include "tvgCommon.h"
 #include "tvgTaskScheduler.h"
 #include "tvgLoaderMgr.h"
+#include "tvgTrace.h"
 
 #ifdef THORVG_CPU_ENGINE_SUPPORT
     #include "tvgSwRenderer.h"
@@ -46,6 +47,7 @@ namespace tvg {
 }
 
 static uint16_t _version = 0;
+static Allocator _allocator;
 
 
 static bool _buildVersionInfo(uint32_t* major, uint32_t* minor, uint32_t* micro)
@@ -82,14 +84,30 @@ static bool _buildVersionInfo(uint32_t* major, uint32_t* minor, uint32_t* micro)
 
 Result Initializer::init(uint32_t threads) noexcept
 {
+    return init(threads, nullptr);
+}
+
+
+Result Initializer::init(uint32_t threads, const Allocator* allocator) noexcept
+{
+    if (allocator && (!allocator->malloc || !allocator->calloc || !allocator->realloc || !allocator->free)) return Result::InvalidArguments;
+
     if (engineInit++ > 0) return Result::Success;
 
+    //installed before any allocation of the engine
+    if (allocator) {
+        _allocator = *allocator;
+        Allocators<>::custom = &_allocator;
+    } else Allocators<>::custom = nullptr;
+
     if (!_buildVersionInfo(nullptr, nullptr, nullptr)) return Result::Unknown;
 
     if (!LoaderMgr::init()) return Result::Unknown;
 
     TaskScheduler::init(threads);
 
+    TVGTRACE_THREAD("main", 0);
+
     return Result::Success;
 }
 
@@ -116,6 +134,13 @@ Result Initializer::term() noexcept
 
     if (!LoaderMgr::term()) return Result::Unknown;
 
+    //no thread records the events anymore
+#ifdef THORVG_TRACE_SUPPORT
+    Trace::term();
+#endif
+
+    //the allocator stays until the next initialization, the engine objects may be released after the termination
+
     return Result::Success;
 }
 
@@ -127,31 +152,39 @@ const char* Initializer::version(uint32_t* major, uint32_t* minor, uint32_t* mic
 }
 
 
+Result Initializer::budget(uint32_t kbytes) noexcept
+{
+    LoaderMgr::budget(kbytes);
+    return Result::Success;
+}
+
+
 uint16_t THORVG_VERSION_NUMBER()
 {
     return _version;
 }
 
 
+//These are process wide, the objects of the application might be released with the other allocator.
 void* operator new(std::size_t size)
 {
-    return tvg::malloc(size);
+    return std::malloc(size);
 }
 
 
 void operator delete(void* ptr) noexcept
 {
-    tvg::free(ptr);
+    std::free(ptr);
 }
 
 
 void* operator new[](std::size_t size)
 {
-    return tvg::malloc(size);
+    return std::malloc(size);
 }
 
 
 void operator delete[](void* ptr) noexcept
 {
-    tvg::free(ptr);
+    std::free(ptr);
 }
\ No newline at end of file
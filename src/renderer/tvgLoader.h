@@ -58,9 +58,28 @@ struct PictureOps : LoaderOps
     AssetResolver* resolver;
     const char* rpath;  // decide the relative path file if the file is loaded from memory
     bool accessible;    // allow the accessor
+    Point target = {};  // the picture size requested prior to the loading, the loaders may decode at the reduced resolution
 
     PictureOps(Ownership owner, AssetResolver* resolver, const char* rpath, bool accessible) :
         LoaderOps{Type::Picture, owner}, resolver(resolver), rpath(rpath), accessible(accessible) {}
+
+    // the largest power of two reduction (up to 1/2^max) of the given image size which still covers the target
+    static int downscale(const LoaderOps& ops, int width, int height, int max)
+    {
+        if (ops.caller != Type::Picture || width <= 0 || height <= 0) return 0;
+
+        auto& target = static_cast<const PictureOps*>(&ops)->target;
+        if (target.x <= 0.0f || target.y <= 0.0f) return 0;
+
+        // the picture keeps the aspect ratio, the smaller scaling factor is applied.
+        auto sx = target.x / float(width);
+        auto sy = target.y / float(height);
+        auto s = sx < sy ? sx : sy;
+
+        auto scale = 0;
+        while (scale < max && s * float(2 << scale) <= 1.0f) ++scale;
+        return scale;
+    }
 };
 
 struct Loader
@@ -84,7 +103,7 @@ struct Loader
         tvg::free(hashpath);
     }
 
-    bool allowCache()
+    virtual bool allowCache()
     {
         if (type == FileType::Lot) return false;
         if (type == FileType::Gif) return false;
@@ -174,13 +193,44 @@ struct BitmapLoader : ImageLoader
     static atomic<ColorSpace> cs;  // desired value
 
     RenderSurface surface;
+    RenderRegion area{};           // the decoded area of the striped image, see stripe()
+    const RenderMethod* user = nullptr;  // the renderer preparing this bitmap, only it can evict the bitmap. see LoaderMgr::use()
+    atomic<uint32_t> drawn{0};     // the latest frame of the user drawing this bitmap, see LoaderMgr::evict()
+    atomic<bool> tracked{false};   // counted in the image memory budget
+    bool shared = false;           // prepared by the several renderers, none of them evicts it
+    bool striped = false;          // the huge image decodes only the visible area on demand
+    uint8_t reduction = 0;         // decoded at 1/2^reduction for the picture size requested prior to the loading, see PictureOps::target
 
     BitmapLoader(FileType type, bool playable = false) : ImageLoader(type, playable) {}
+    ~BitmapLoader();
 
-    RenderSurface* bitmap() override
+    RenderSurface* bitmap() override;
+
+    // the striped area or the reduced pixels can't serve the other pictures
+    bool allowCache() override
     {
-        return surface.data ? &surface : nullptr;
+        return !striped && reduction == 0 && ImageLoader::allowCache();
     }
+
+    // the decoded pixels of the whole image, the picture scales them up to the image size (w, h)
+    RenderRegion extent() const
+    {
+        return {{0, 0}, {(int32_t(w) + (1 << reduction) - 1) >> reduction, (int32_t(h) + (1 << reduction) - 1) >> reduction}};
+    }
+
+    // the image memory budget support: the decoded pixels can be dropped and decoded again from the source.
+    virtual bool evictable() { return false; }
+    // drop the decoded pixels, the next read() decodes them again.
+    virtual void evict() {}
+
+    // the images over 16M pixels are decoded partially if the loaders support it
+    static bool huge(float w, float h)
+    {
+        return w * h > 4096.0f * 4096.0f;
+    }
+
+    // adjust the decoded area to cover the visible one, returns true if the pixels need to be decoded again.
+    bool stripe(const RenderRegion& visible);
 };
 
 struct AnimLoader : ImageLoader
@@ -231,7 +281,7 @@ struct FontLoader : Loader
 
     using Loader::read;
 
-    virtual bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out) = 0;
+    virtual bool get(FontMetrics& fm, char* text, uint32_t len, RenderPath& out, RenderGlyphs& glyphs) = 0;
     virtual void transform(Paint* paint, FontMetrics& fm, float italicShear) = 0;
     virtual void release(FontMetrics& fm) = 0;
     virtual void metrics(const FontMetrics& fm, TextMetrics& out) = 0;
@@ -21,6 +21,7 @@
  */
 
 #include <atomic>
+#include <algorithm>
 #include "tvgInlist.h"
 #include "tvgLoaderMgr.h"
 #include "tvgLock.h"
@@ -70,6 +71,29 @@ atomic<ColorSpace> BitmapLoader::cs{ColorSpace::ARGB8888};
 static Key _key;
 static Inlist<tvg::Loader> _activeLoaders;
 
+//image memory budget
+static Key _imageKey;
+static Array<BitmapLoader*> _bitmaps;  //decoded bitmaps which can be evicted
+static size_t _budget = 0;             //bytes, 0: unlimited
+static size_t _used = 0;               //bytes of the decoded bitmaps
+
+static size_t _bytes(const RenderSurface& surface)
+{
+    return size_t(surface.stride) * surface.h * surface.channelSize;
+}
+
+static void _untrack(BitmapLoader* loader)
+{
+    for (uint32_t i = 0; i < _bitmaps.count; ++i) {
+        if (_bitmaps[i] != loader) continue;
+        _bitmaps[i] = _bitmaps.last();
+        _bitmaps.pop();
+        break;
+    }
+    _used -= _bytes(loader->surface);
+    loader->tracked = false;
+}
+
 static tvg::Loader* _find(FileType type)
 {
     switch (type) {
@@ -206,6 +230,13 @@ bool LoaderMgr::term()
         _activeLoaders.remove(loader);
         delete (loader);
     }
+
+    //the tracking list was allocated by the current allocator
+    ScopedLock lock(_imageKey);
+    for (auto loader : _bitmaps) loader->tracked = false;
+    _bitmaps.reset();
+    _used = 0;
+
     return true;
 }
 
@@ -385,3 +416,113 @@ tvg::Loader* LoaderMgr::anyfont()
     }
     return nullptr;
 }
+
+BitmapLoader::~BitmapLoader()
+{
+    LoaderMgr::untrack(this);
+}
+
+RenderSurface* BitmapLoader::bitmap()
+{
+    //the striped image is decoded once its visible area is known, see stripe()
+    if (!surface.data) return striped ? &surface : nullptr;
+    LoaderMgr::track(this);
+    return &surface;
+}
+
+bool BitmapLoader::stripe(const RenderRegion& visible)
+{
+    if (surface.data && area.contained(visible)) return false;
+
+    //snap to the tiles not to decode again on every slight move
+    static constexpr int32_t TILE = 512;
+    auto full = extent();
+    area.min = {visible.min.x & ~(TILE - 1), visible.min.y & ~(TILE - 1)};
+    area.max = {std::min((visible.max.x + TILE - 1) & ~(TILE - 1), full.max.x), std::min((visible.max.y + TILE - 1) & ~(TILE - 1), full.max.y)};
+
+    if (surface.data) {
+        LoaderMgr::untrack(this);
+        evict();
+        surface.invalidate();
+    }
+    readied = false;
+    return true;
+}
+
+void LoaderMgr::budget(uint32_t kbytes)
+{
+    ScopedLock lock(_imageKey);
+    _budget = size_t(kbytes) * 1024;
+}
+
+//The decoded bitmaps keep their sources to decode them again only if they might be evicted
+bool LoaderMgr::budgeted()
+{
+    ScopedLock lock(_imageKey);
+    return _budget > 0;
+}
+
+void LoaderMgr::track(BitmapLoader* loader)
+{
+    if (loader->tracked || !loader->evictable()) return;
+
+    ScopedLock lock(_imageKey);
+    if (loader->tracked) return;  //tracked by the other picture sharing it in the meantime
+    loader->tracked = true;
+    _bitmaps.push(loader);
+    _used += _bytes(loader->surface);
+}
+
+void LoaderMgr::untrack(BitmapLoader* loader)
+{
+    if (!loader->tracked) return;
+
+    ScopedLock lock(_imageKey);
+    if (loader->tracked) _untrack(loader);
+}
+
+//Called before the renderer refers to the bitmap pixels. Once another renderer prepared them,
+//the bitmap may be in its drawing at any time, so the both renderers leave it.
+void LoaderMgr::use(BitmapLoader* loader, const RenderMethod* renderer)
+{
+    if (!loader->evictable()) return;
+
+    ScopedLock lock(_imageKey);
+    if (loader->user == renderer) return;
+    if (loader->user) loader->shared = true;
+    loader->user = renderer;
+    loader->drawn = renderer->frame;  //a fresh use is kept at least for this and the next frame
+}
+
+void LoaderMgr::touch(BitmapLoader* loader, const RenderMethod* renderer)
+{
+    loader->drawn = renderer->frame;
+}
+
+//Called prior to the canvas update when its renderer doesn't refer to the bitmaps.
+//The bitmaps used by this renderer only are evicted, the other canvases may be drawing theirs.
+void LoaderMgr::evict(RenderMethod* renderer)
+{
+    ScopedLock lock(_imageKey);
+
+    ++renderer->frame;
+
+    if (_budget == 0 || _used <= _budget) return;
+
+    //the bitmaps not drawn in the current and the previous frames, the least recently drawn first.
+    Array<BitmapLoader*> candidates;
+    for (auto loader : _bitmaps) {
+        if (loader->user == renderer && !loader->shared && loader->drawn + 1 < renderer->frame) candidates.push(loader);
+    }
+    std::sort(candidates.begin(), candidates.end(), [](const BitmapLoader* a, const BitmapLoader* b) {
+        return a->drawn.load() < b->drawn.load();
+    });
+
+    for (auto loader : candidates) {
+        if (_used <= _budget) break;
+        TVGLOG("LOADER", "Evict the decoded image [Size: %d x %d]", loader->surface.w, loader->surface.h);
+        _untrack(loader);
+        loader->evict();
+        loader->surface.invalidate();
+    }
+}
@@ -40,6 +40,15 @@ struct LoaderMgr
     static Loader* anyfont();
     static bool retrieve(const char* filename);
     static bool retrieve(Loader* loader);
+
+    // image memory budget
+    static void budget(uint32_t kbytes);
+    static bool budgeted();
+    static void track(BitmapLoader* loader);
+    static void untrack(BitmapLoader* loader);
+    static void use(BitmapLoader* loader, const RenderMethod* renderer);
+    static void touch(BitmapLoader* loader, const RenderMethod* renderer);
+    static void evict(RenderMethod* renderer);
 };
 
 }  // namespace tvg
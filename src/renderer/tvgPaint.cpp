@@ -76,7 +76,7 @@ static bool _compFastTrack(RenderMethod* renderer, Paint* cmpTarget, const Matri
     auto shape = static_cast<Shape*>(cmpTarget);
 
     //Trimming likely makes the shape non-rectangular
-    if (to<ShapeImpl>(shape)->rs.trimpath()) return false;
+    if (to<ShapeImpl>(shape)->shape().trimpath()) return false;
 
     //Rectangle Candidates?
     const Point* pts;
@@ -248,7 +248,7 @@ RenderData Paint::Impl::update(RenderMethod* renderer, const Matrix& pm, Array<R
         auto pclip = PAINT(this->clipper);
         pclip->ctxFlag &= ~ContextFlag::FastTrack;   //reset
         viewport = renderer->viewport();
-        if (!pclip->clipper && to<ShapeImpl>(this->clipper)->rs.strokeWidth() == 0.0f && _compFastTrack(renderer, this->clipper, pm, viewport)) {
+        if (!pclip->clipper && to<ShapeImpl>(this->clipper)->shape().strokeWidth() == 0.0f && _compFastTrack(renderer, this->clipper, pm, viewport)) {
             pclip->ctxFlag |= ContextFlag::FastTrack;
             compFastTrack = true;
         } else {
@@ -198,13 +198,16 @@ struct Paint::Impl
 
         if (maskData) {
             PAINT(maskData->target)->unref(maskData->target != target);
-            tvg::free(maskData);
-            maskData = nullptr;
+            //reuse it for the next mask, the masks are often replaced every frame
+            if (method == MaskMethod::None) {
+                tvg::free(maskData);
+                maskData = nullptr;
+            }
         }
 
         if (method == MaskMethod::None) return (target ? Result::InvalidArguments : Result::Success);
 
-        maskData = tvg::malloc<Mask>(sizeof(Mask));
+        if (!maskData) maskData = tvg::malloc<Mask>(sizeof(Mask));
         target->ref();
         maskData->target = target;
         PAINT(target)->parent = parent;
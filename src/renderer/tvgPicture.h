@@ -37,11 +37,13 @@ struct PictureImpl : Picture
     ImageLoader* loader = nullptr;
     Paint* vector = nullptr;          //vector picture uses
     RenderSurface* bitmap = nullptr;  //bitmap picture uses
+    void* pixels = nullptr;           //the evictable bitmap pixels prepared by the renderer
     AssetResolver* resolver = nullptr;
     Point origin = {};
     float w = 0, h = 0;
     FilterMethod filter = FilterMethod::Bilinear;
     bool resizing = false;
+    bool shown = false;               //the bitmap is placed in the viewport
 
     PictureImpl() : impl(Paint::Impl(this))
     {
@@ -56,14 +58,71 @@ struct PictureImpl : Picture
 
     bool skip(RenderUpdateFlag flag)
     {
-        // The media have its own playback update
-        return !loader || (flag == RenderUpdateFlag::None && loader->type != FileType::Media);
+        // The media have its own playback update, the evicted bitmap may need to be decoded again.
+        return !loader || (flag == RenderUpdateFlag::None && loader->type != FileType::Media && !evicted());
+    }
+
+    // the decoded pixels were dropped (or decoded again by the other sharing picture) by the image memory budget, see LoaderMgr::evict()
+    bool evicted()
+    {
+        return bitmap && (!bitmap->data || (pixels && pixels != bitmap->data));
+    }
+
+    static void bbox(const Point* pt, Point& min, Point& max)
+    {
+        min = max = pt[0];
+        for (int i = 1; i < 4; ++i) {
+            if (pt[i].x < min.x) min.x = pt[i].x;
+            if (pt[i].x > max.x) max.x = pt[i].x;
+            if (pt[i].y < min.y) min.y = pt[i].y;
+            if (pt[i].y > max.y) max.y = pt[i].y;
+        }
+    }
+
+    bool onscreen(RenderMethod* renderer, const Matrix& m)
+    {
+        Point pt[4] = {Point{0.0f, 0.0f} * m, Point{loader->w, 0.0f} * m, Point{loader->w, loader->h} * m, Point{0.0f, loader->h} * m};
+        Point min, max;
+        bbox(pt, min, max);
+        auto vport = renderer->viewport();
+        return max.x > vport.min.x && min.x < vport.max.x && max.y > vport.min.y && min.y < vport.max.y;
+    }
+
+    // the decoded pixels shown in the viewport with the margin for the filtering
+    RenderRegion visible(RenderMethod* renderer, const Matrix& m)
+    {
+        Matrix inv;
+        if (!inverse(&m, &inv)) return {};
+
+        auto vport = renderer->viewport();
+        auto x1 = float(vport.min.x - 2), y1 = float(vport.min.y - 2), x2 = float(vport.max.x + 2), y2 = float(vport.max.y + 2);
+        Point pt[4] = {Point{x1, y1} * inv, Point{x2, y1} * inv, Point{x2, y2} * inv, Point{x1, y2} * inv};
+        Point min, max;
+        bbox(pt, min, max);
+
+        RenderRegion area = {{int32_t(floorf(min.x)) - 1, int32_t(floorf(min.y)) - 1}, {int32_t(ceilf(max.x)) + 1, int32_t(ceilf(max.y)) + 1}};
+        return RenderRegion::intersect(area, static_cast<BitmapLoader*>(loader)->extent());
+    }
+
+    // the pixels were updated in place, the other pictures sharing them see the new ones as well
+    void invalidate()
+    {
+        ScopedLock lock(bitmap->key);
+        bitmap->invalidate();
+    }
+
+    bool restore()
+    {
+        auto loader = static_cast<BitmapLoader*>(this->loader);
+        if (!loader->read()) return false;
+        bitmap = loader->bitmap();
+        return bitmap != nullptr;
     }
 
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, TVG_UNUSED bool clipper)
     {
         flag |= load();
-        if (flag == RenderUpdateFlag::None) return true;
+        if (flag == RenderUpdateFlag::None && !evicted()) return true;
 
         auto pivot = Point{-origin.x * float(w), -origin.y * float(h)};
 
@@ -77,7 +136,26 @@ struct PictureImpl : Picture
             auto sy = h / loader->h;
             auto scale = sx < sy ? sx : sy;
             auto m = transform * Matrix{scale, 0, pivot.x, 0, scale, pivot.y, 0, 0, 1};
+            auto loader = static_cast<BitmapLoader*>(this->loader);
+            shown = opacity > 0 && onscreen(renderer, m);
+            //The reduced pixels are scaled up to the image size.
+            if (loader->reduction > 0) {
+                auto full = loader->extent();
+                scaleR(&m, {loader->w / float(full.sw()), loader->h / float(full.sh())});
+            }
+            //The huge image decodes the visible area only.
+            if (loader->striped && shown) loader->stripe(visible(renderer, m));
+            //Claim the pixels before the check, the other renderers won't evict them anymore.
+            LoaderMgr::use(loader, renderer);
+            //Decode the evicted pixels again once it's shown, render() skips it in the meantime.
+            if (evicted()) {
+                if (!bitmap->data && !shown) return true;
+                if (!bitmap->data && !restore()) return false;
+                flag = RenderUpdateFlag::All;
+            }
+            if (loader->striped) translateR(&m, {float(loader->area.min.x), float(loader->area.min.y)});
             impl.rd = renderer->prepare(bitmap, impl.rd, m, clips, opacity, filter, flag);
+            pixels = loader->evictable() ? bitmap->data : nullptr;
         } else if (vector) {
             if (resizing) {
                 loader->resize(vector, w, h);
@@ -138,6 +216,7 @@ struct PictureImpl : Picture
         if (vector || bitmap) return Result::InsufficientCondition;
 
         PictureOps ops = {Ownership::Transfer, resolver, nullptr, accessible};
+        if (resizing && !loader) ops.target = {w, h};
         auto ret = Result::InvalidArguments;
         auto loader = LoaderMgr::loader(filename, ops, ret);
         return loader ? load(loader) : ret;
@@ -149,6 +228,7 @@ struct PictureImpl : Picture
         if (vector || bitmap) return Result::InsufficientCondition;
 
         PictureOps ops = {owner, resolver, rpath, accessible};
+        if (resizing && !loader) ops.target = {w, h};
         auto ret = Result::InvalidArguments;
         auto loader = LoaderMgr::loader(data, size, mimeType, ops, ret);
         return loader ? load(loader) : ret;
@@ -192,6 +272,12 @@ struct PictureImpl : Picture
         }
 
         if (loader) {
+            //the striped area can't serve the multiple pictures, the whole image is decoded instead.
+            if (bitmap && static_cast<BitmapLoader*>(loader)->striped) {
+                auto loader = static_cast<BitmapLoader*>(this->loader);
+                loader->stripe(loader->extent());
+                loader->striped = false;
+            }
             dup->loader = loader;
             ++dup->loader->sharing;
             PAINT(picture)->mark(RenderUpdateFlag::Image);
@@ -235,7 +321,10 @@ struct PictureImpl : Picture
         // reload the next frame if any
         if (vector || bitmap) {
             // sync call must be guaranteed.
-            if (loader->sync() && bitmap) return RenderUpdateFlag::Image;
+            if (loader->sync() && bitmap) {
+                invalidate();
+                return RenderUpdateFlag::Image;
+            }
         // load the first frame
         } else {
             if ((vector = loader->paint())) {
@@ -276,6 +365,8 @@ struct PictureImpl : Picture
         auto ret = true;
 
         if (bitmap) {
+            if (evicted()) return true;
+            if (shown) LoaderMgr::touch(static_cast<BitmapLoader*>(loader), renderer);
             renderer->blend(impl.blendMethod);
             return renderer->renderImage(impl.rd);
         } else if (vector) {
@@ -302,7 +393,11 @@ struct PictureImpl : Picture
         //Same resource has been loaded.
         if (this->loader == loader) {
             this->loader->sharing--;  //make it sure the reference counting.
-            if (bitmap) impl.mark(RenderUpdateFlag::Image);  // force the bitmap updated
+            // force the bitmap updated, the pixels might be rewritten in the same buffer
+            if (bitmap) {
+                invalidate();
+                impl.mark(RenderUpdateFlag::Image);
+            }
             return Result::Success;
         } else if (this->loader) {
             LoaderMgr::retrieve(this->loader);
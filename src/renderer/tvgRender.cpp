@@ -196,7 +196,7 @@ void RenderPath::addRect(float x, float y, float w, float h, float rx, float ry,
     }
 }
 
-bool RenderPath::bounds(const Matrix* m, BBox& box)
+bool RenderPath::bounds(const Matrix* m, BBox& box) const
 {
     if (cmds.empty() || cmds.first() == PathCommand::CubicTo) return false;
 
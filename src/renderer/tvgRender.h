@@ -30,6 +30,12 @@
 #include "tvgLock.h"
 #include "tvgColor.h"
 #include "tvgMath.h"
+#include "tvgFill.h"
+
+#ifdef THORVG_STATS_SUPPORT
+    #include <atomic>
+    #include <chrono>
+#endif
 
 namespace tvg
 {
@@ -59,6 +65,23 @@ static inline bool operator&(const EngineOption a, const EngineOption b)
     return (uint8_t(a) & uint8_t(b));
 }
 
+//Box filtered, halved copies of the surface for the strongly minified drawing, built by the engine on demand
+struct RenderMipmap
+{
+    struct Level
+    {
+        uint32_t* data;
+        uint32_t w, h;
+    };
+
+    Array<Level> levels;            //levels[0] is the half size of the surface
+
+    ~RenderMipmap()
+    {
+        ARRAY_FOREACH(p, levels) tvg::free(p->data);
+    }
+};
+
 struct RenderSurface
 {
     union {
@@ -73,9 +96,15 @@ struct RenderSurface
     uint8_t channelSize = 0;
     bool premultiplied = false;         //Alpha-premultiplied
     bool alphaIgnored = false;          // If true, the alpha channel can be ignored.
+    RenderMipmap* mipmap = nullptr;     //the downscaled levels shared by the pictures of this surface, guarded by the key
 
     RenderSurface() = default;
 
+    ~RenderSurface()
+    {
+        delete(mipmap);
+    }
+
     RenderSurface(const RenderSurface* rhs)
     {
         data = rhs->data;
@@ -98,6 +127,14 @@ struct RenderSurface
         this->cs = cs;
         this->premultiplied = (cs == ColorSpace::ABGR8888 || cs == ColorSpace::ARGB8888);
         this->alphaIgnored = alphaIgnored;
+        invalidate();
+    }
+
+    //the pixels are replaced, the downscaled levels are no longer valid
+    void invalidate()
+    {
+        delete(mipmap);
+        mipmap = nullptr;
     }
 };
 
@@ -332,7 +369,7 @@ struct RenderPath
         return curr;
     }
 
-    bool bounds(const Matrix* m, BBox& box);
+    bool bounds(const Matrix* m, BBox& box) const;
     void addCircle(float cx, float cy, float rx, float ry, bool cw);
     void addRect(float x, float y, float w, float h, float rx, float ry, bool cw);
 
@@ -376,16 +413,20 @@ struct RenderStroke
         width = rhs.width;
         color = rhs.color;
 
-        delete(fill);
-        if (rhs.fill) fill = rhs.fill->duplicate();
-        else fill = nullptr;
+        fill = fillDuplicate(rhs.fill, fill);
 
-        tvg::free(dash.pattern);
+        //keep the current pattern buffer if it fits
+        auto pattern = dash.pattern;
+        if (pattern && dash.count != rhs.dash.count) {
+            tvg::free(pattern);
+            pattern = nullptr;
+        }
         dash = rhs.dash;
         if (rhs.dash.count > 0) {
-            dash.pattern = tvg::malloc<float>(sizeof(float) * rhs.dash.count);
-            memcpy(dash.pattern, rhs.dash.pattern, sizeof(float) * rhs.dash.count);
+            if (!pattern) pattern = tvg::malloc<float>(sizeof(float) * rhs.dash.count);
+            memcpy(pattern, rhs.dash.pattern, sizeof(float) * rhs.dash.count);
         }
+        dash.pattern = pattern;
 
         miterlimit = rhs.miterlimit;
         trim = rhs.trim;
@@ -401,18 +442,36 @@ struct RenderStroke
     }
 };
 
+//A glyph outline placed in a text path
+struct RenderGlyph
+{
+    uint32_t idx;           //glyph index in the font
+    uint32_t cmd, cmdCnt;   //range of the glyph commands in the path
+    uint32_t pt, ptCnt;     //range of the glyph points in the path
+    Point origin;           //glyph placement in the path space
+};
+
+struct RenderGlyphs
+{
+    Array<RenderGlyph> data;
+    float em = 0.0f;        //em size in the path space
+    uint32_t font = 0;      //unique font id
+};
+
 struct RenderShape
 {
     RenderPath path;
     Fill *fill = nullptr;
     RenderColor color{};
     RenderStroke *stroke = nullptr;
+    RenderGlyphs *glyphs = nullptr;   //optional, the glyphs composing the path if it's a text
     FillRule rule = FillRule::NonZero;
 
     ~RenderShape()
     {
         delete(fill);
         delete(stroke);
+        delete(glyphs);
     }
 
     void fillColor(uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) const
@@ -594,6 +653,40 @@ struct RenderEffectTritone : RenderEffect
     }
 };
 
+#ifdef THORVG_STATS_SUPPORT
+
+//per-frame statistics of a renderer, the counters may be raised by the worker threads
+struct RenderStats
+{
+    atomic<uint32_t> tessellated{0}, reused{0}, spans{0}, tasks{0}, retries{0};
+    uint32_t compositors = 0, area = 0;
+    double update = 0.0, render = 0.0, composite = 0.0, effect = 0.0;  //milliseconds
+
+    //accumulates the elapsed time of its scope
+    struct Timer
+    {
+        double& out;
+        chrono::steady_clock::time_point begin;
+
+        Timer(double& out) : out(out), begin(chrono::steady_clock::now()) {}
+        ~Timer() { out += chrono::duration<double, milli>(chrono::steady_clock::now() - begin).count(); }
+    };
+
+    void reset()
+    {
+        tessellated = reused = spans = tasks = retries = 0;
+        compositors = area = 0;
+        update = render = composite = effect = 0.0;
+    }
+};
+
+    #define RENDER_STATS(renderer, field, n) ((renderer)->stats.field += (n))
+    #define RENDER_STATS_TIME(renderer, field) RenderStats::Timer _statsTimer((renderer)->stats.field)
+#else
+    #define RENDER_STATS(...) do {} while(0)
+    #define RENDER_STATS_TIME(...) do {} while(0)
+#endif
+
 struct RenderMethod
 {
 private:
@@ -604,6 +697,11 @@ protected:
     RenderRegion vport;         //viewport
 
 public:
+#ifdef THORVG_STATS_SUPPORT
+    RenderStats stats;
+#endif
+    uint32_t frame = 1;         //increased by every canvas update, see LoaderMgr::evict()
+
     //common implementation
     uint32_t ref();
     uint32_t unref();
@@ -23,16 +23,45 @@
 #ifndef _TVG_SAVE_MODULE_H_
 #define _TVG_SAVE_MODULE_H_
 
+#include <cstdio>
 #include "tvgCommon.h"
 
 namespace tvg
 {
 
+//Buffered output of the encoded data, either into a file or to the user writer.
+struct SaveStream
+{
+    using Writer = std::function<bool(const uint8_t* data, uint32_t size, void* user)>;
+
+    SaveStream(const char* filename);
+    SaveStream(Writer writer, void* user);
+    ~SaveStream();
+
+    void put(uint8_t c)
+    {
+        if (count == sizeof(buffer)) flush();
+        buffer[count++] = c;
+    }
+
+    void write(const void* data, uint32_t size);
+    bool flush();   //deliver the pending data, the file is opened at the first one
+
+private:
+    uint8_t buffer[16384];
+    uint32_t count = 0;
+    char* path = nullptr;
+    FILE* file = nullptr;
+    Writer writer;
+    void* user = nullptr;
+    bool failed = false;
+};
+
 struct SaveModule
 {
     virtual ~SaveModule() {}
-    virtual bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) = 0;
-    virtual bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) = 0;
+    virtual bool save(Paint* paint, Paint* bg, SaveStream* stream, uint32_t quality) = 0;
+    virtual bool save(Animation* animation, Paint* bg, SaveStream* stream, uint32_t quality, uint32_t fps) = 0;
     virtual bool close() = 0;
 };
 
@@ -20,6 +20,7 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include <cstring>
 #include "tvgCommon.h"
 #include "tvgStr.h"
@@ -29,6 +30,9 @@
 #ifdef THORVG_GIF_SAVER_SUPPORT
     #include "tvgGifSaver.h"
 #endif
+#ifdef THORVG_PNG_SAVER_SUPPORT
+    #include "tvgPngSaver.h"
+#endif
 
 /************************************************************************/
 /* Internal Class Implementation                                        */
@@ -37,13 +41,44 @@
 struct Saver::Impl
 {
     SaveModule* saveModule = nullptr;
+    SaveStream* stream = nullptr;
     Paint* bg = nullptr;
 
     ~Impl()
     {
         delete(saveModule);
+        delete(stream);
         if (bg) bg->unref();
     }
+
+    Result save(SaveModule* saveModule, Paint* paint, SaveStream* stream, uint32_t quality)
+    {
+        if (saveModule && saveModule->save(paint, bg, stream, quality)) {
+            this->saveModule = saveModule;
+            this->stream = stream;
+            return Result::Success;
+        }
+        Paint::rel(paint);
+        delete(stream);
+        if (!saveModule) return Result::NonSupport;
+        delete(saveModule);
+        return Result::Unknown;
+    }
+
+    Result save(SaveModule* saveModule, Animation* animation, SaveStream* stream, uint32_t quality, uint32_t fps)
+    {
+        if (saveModule && saveModule->save(animation, bg, stream, quality, fps)) {
+            this->saveModule = saveModule;
+            this->stream = stream;
+            return Result::Success;
+        }
+        //animation holds the picture, it must be 1 at the bottom.
+        if (animation->picture()->refCnt() <= 1) delete(animation);
+        delete(stream);
+        if (!saveModule) return Result::NonSupport;
+        delete(saveModule);
+        return Result::Unknown;
+    }
 };
 
 
@@ -53,6 +88,12 @@ static SaveModule* _find(FileType type)
         case FileType::Gif: {
 #ifdef THORVG_GIF_SAVER_SUPPORT
             return new GifSaver;
+#endif
+            break;
+        }
+        case FileType::Png: {
+#ifdef THORVG_PNG_SAVER_SUPPORT
+            return new PngSaver;
 #endif
             break;
         }
@@ -68,6 +109,10 @@ static SaveModule* _find(FileType type)
             format = "GIF";
             break;
         }
+        case FileType::Png: {
+            format = "PNG";
+            break;
+        }
         default: {
             format = "???";
             break;
@@ -79,10 +124,11 @@ static SaveModule* _find(FileType type)
 }
 
 
-static SaveModule* _find(const char* filename)
+//the file extension or the mime type
+static SaveModule* _find(const char* type)
 {
-    auto ext = fileext(filename);
-    if (ext && !strcmp(ext, "gif")) return _find(FileType::Gif);
+    if (type && !strcmp(type, "gif")) return _find(FileType::Gif);
+    if (type && !strcmp(type, "png")) return _find(FileType::Png);
     return nullptr;
 }
 
@@ -91,6 +137,61 @@ static SaveModule* _find(const char* filename)
 /* External Class Implementation                                        */
 /************************************************************************/
 
+SaveStream::SaveStream(const char* filename) : path(duplicate(filename))
+{
+}
+
+
+SaveStream::SaveStream(Writer writer, void* user) : writer(writer), user(user)
+{
+}
+
+
+SaveStream::~SaveStream()
+{
+    if (file) fclose(file);
+    tvg::free(path);
+}
+
+
+void SaveStream::write(const void* data, uint32_t size)
+{
+    auto src = static_cast<const uint8_t*>(data);
+    while (size > 0) {
+        if (count == sizeof(buffer)) flush();
+        auto len = std::min(size, uint32_t(sizeof(buffer)) - count);
+        memcpy(buffer + count, src, len);
+        count += len;
+        src += len;
+        size -= len;
+    }
+}
+
+
+bool SaveStream::flush()
+{
+    if (failed) {
+        count = 0;
+        return false;
+    }
+
+    if (writer) {
+        if (count > 0 && !writer(buffer, count, user)) failed = true;
+    } else {
+        if (!file && path) {
+#if defined(_MSC_VER) && (_MSC_VER >= 1400)
+            fopen_s(&file, path, "wb");
+#else
+            file = fopen(path, "wb");
+#endif
+        }
+        if (!file || fwrite(buffer, 1, count, file) != count) failed = true;
+    }
+    count = 0;
+    return !failed;
+}
+
+
 Saver::Saver() : pImpl(new Impl())
 {
 }
@@ -112,18 +213,26 @@ Result Saver::save(Paint* paint, const char* filename, uint32_t quality) noexcep
         return Result::InsufficientCondition;
     }
 
-    if (auto saveModule = _find(filename)) {
-        if (saveModule->save(paint, pImpl->bg, filename, quality)) {
-            pImpl->saveModule = saveModule;
-            return Result::Success;
-        } else {
-            Paint::rel(paint);
-            delete(saveModule);
-            return Result::Unknown;
-        }
+    return pImpl->save(_find(fileext(filename)), paint, new SaveStream(filename), quality);
+}
+
+
+Result Saver::save(Paint* paint, const char* mimeType, std::function<bool(const uint8_t* data, uint32_t size, void* user)> writer, void* user, uint32_t quality) noexcept
+{
+    if (!paint) return Result::InvalidArguments;
+
+    if (!writer) {
+        Paint::rel(paint);
+        return Result::InvalidArguments;
     }
-    Paint::rel(paint);
-    return Result::NonSupport;
+
+    //Already on saving another resource.
+    if (pImpl->saveModule) {
+        Paint::rel(paint);
+        return Result::InsufficientCondition;
+    }
+
+    return pImpl->save(_find(mimeType), paint, new SaveStream(writer, user), quality);
 }
 
 
@@ -157,18 +266,34 @@ Result Saver::save(Animation* animation, const char* filename, uint32_t quality,
         return Result::InsufficientCondition;
     }
 
-    if (auto saveModule = _find(filename)) {
-        if (saveModule->save(animation, pImpl->bg, filename, quality, fps)) {
-            pImpl->saveModule = saveModule;
-            return Result::Success;
-        } else {
-            if (remove) delete(animation);
-            delete(saveModule);
-            return Result::Unknown;
-        }
+    return pImpl->save(_find(fileext(filename)), animation, new SaveStream(filename), quality, fps);
+}
+
+
+Result Saver::save(Animation* animation, const char* mimeType, std::function<bool(const uint8_t* data, uint32_t size, void* user)> writer, void* user, uint32_t quality, uint32_t fps) noexcept
+{
+    if (!animation) return Result::InvalidArguments;
+
+    //animation holds the picture, it must be 1 at the bottom.
+    auto remove = animation->picture()->refCnt() <= 1 ? true : false;
+
+    if (!writer) {
+        if (remove) delete(animation);
+        return Result::InvalidArguments;
     }
-    if (remove) delete(animation);
-    return Result::NonSupport;
+
+    if (tvg::zero(animation->totalFrame())) {
+        if (remove) delete(animation);
+        return Result::InsufficientCondition;
+    }
+
+    //Already on saving another resource.
+    if (pImpl->saveModule) {
+        if (remove) delete(animation);
+        return Result::InsufficientCondition;
+    }
+
+    return pImpl->save(_find(mimeType), animation, new SaveStream(writer, user), quality, fps);
 }
 
 
@@ -179,6 +304,10 @@ Result Saver::sync() noexcept
     delete(pImpl->saveModule);
     pImpl->saveModule = nullptr;
 
+    //closes the file
+    delete(pImpl->stream);
+    pImpl->stream = nullptr;
+
     return Result::Success;
 }
 
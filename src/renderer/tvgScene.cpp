@@ -20,8 +20,199 @@
  * SOFTWARE.
  */
 
+#include <algorithm>
 #include "tvgScene.h"
 
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+static RenderRegion _bounds(Paint* paint)
+{
+    auto p = PAINT(paint);
+    if (!p->renderer || p->hidden) return {};
+    return p->bounds();
+}
+
+
+bool ScenePicker::range(const RenderRegion& box, RenderRegion& out)
+{
+    auto clipped = RenderRegion::intersect(box, domain);
+    if (clipped.invalid()) return false;
+    out.min.x = (clipped.min.x - domain.min.x) / size;
+    out.min.y = (clipped.min.y - domain.min.y) / size;
+    out.max.x = (clipped.max.x - 1 - domain.min.x) / size + 1;
+    out.max.y = (clipped.max.y - 1 - domain.min.y) / size + 1;
+    return true;
+}
+
+
+void ScenePicker::insert(uint32_t idx)
+{
+    auto& item = items[idx];
+    RenderRegion r;
+    item.large = false;
+    if (!range(item.box, r)) return;
+
+    if (r.w() * r.h() > MAX_CELLS) {
+        item.large = true;
+        large.push(idx);
+        return;
+    }
+
+    for (auto y = r.min.y; y < r.max.y; ++y) {
+        for (auto x = r.min.x; x < r.max.x; ++x) {
+            auto& head = cells[y * cols + x];
+            uint32_t node;
+            if (freed != INVALID) {
+                node = freed;
+                freed = nodes[node].next;
+            } else {
+                node = nodes.count;
+                nodes.push(Node{});
+            }
+            nodes[node] = {idx, head};
+            head = node;
+        }
+    }
+}
+
+
+void ScenePicker::remove(uint32_t idx)
+{
+    auto& item = items[idx];
+
+    if (item.large) {
+        ARRAY_FOREACH(p, large) {
+            if (*p == idx) {
+                *p = large.last();
+                large.pop();
+                break;
+            }
+        }
+        return;
+    }
+
+    RenderRegion r;
+    if (!range(item.box, r)) return;
+
+    for (auto y = r.min.y; y < r.max.y; ++y) {
+        for (auto x = r.min.x; x < r.max.x; ++x) {
+            auto link = &cells[y * cols + x];
+            while (*link != INVALID) {
+                auto node = *link;
+                if (nodes[node].item == idx) {
+                    *link = nodes[node].next;
+                    nodes[node].next = freed;
+                    freed = node;
+                    break;
+                }
+                link = &nodes[node].next;
+            }
+        }
+    }
+}
+
+
+void ScenePicker::rebuild(const Array<Paint*>& paints, const RenderRegion& viewport)
+{
+    domain = viewport;
+    items.clear();
+    nodes.clear();
+    large.clear();
+    freed = INVALID;
+
+    //a few items per cell on average
+    auto area = float(domain.w()) * float(domain.h());
+    size = std::max(16, int32_t(sqrtf(area / float(paints.count)) * 2.0f));
+    while (true) {
+        cols = (domain.sw() + size - 1) / size;
+        rows = (domain.sh() + size - 1) / size;
+        if (cols * rows <= 65536) break;
+        size *= 2;
+    }
+
+    cells.clear();
+    cells.reserve(cols * rows);
+    for (int32_t i = 0; i < cols * rows; ++i) cells.push(INVALID);
+
+    items.reserve(paints.count);
+    ARRAY_FOREACH(p, paints) {
+        items.push({*p, _bounds(*p), 0, false});
+        insert(items.count - 1);
+    }
+    reset = dirty = false;
+}
+
+
+void ScenePicker::refresh(const Array<Paint*>& paints, RenderMethod* renderer)
+{
+    auto viewport = renderer->viewport();
+
+    if (reset || !(viewport == domain)) {
+        rebuild(paints, viewport);
+        return;
+    }
+
+    //move only the children which render regions are changed
+    uint32_t idx = 0;
+    ARRAY_FOREACH(p, paints) {
+        auto box = _bounds(*p);
+        if (!(box == items[idx].box)) {
+            remove(idx);
+            items[idx].box = box;
+            insert(idx);
+        }
+        ++idx;
+    }
+    dirty = false;
+}
+
+
+void ScenePicker::pick(const Array<Paint*>& paints, RenderMethod* renderer, const RenderRegion& region, std::function<bool(Paint* paint, void* data)>& func, void* data)
+{
+    if (reset || dirty) refresh(paints, renderer);
+
+    if (++stamp == 0) {
+        ARRAY_FOREACH(p, items) p->stamp = 0;
+        stamp = 1;
+    }
+
+    Array<uint32_t> hits;
+
+    auto visit = [&](uint32_t idx) {
+        auto& item = items[idx];
+        if (item.stamp == stamp) return;
+        item.stamp = stamp;
+        if (item.box.intersected(region)) hits.push(idx);
+    };
+
+    RenderRegion r;
+    if (range(region, r)) {
+        for (auto y = r.min.y; y < r.max.y; ++y) {
+            for (auto x = r.min.x; x < r.max.x; ++x) {
+                for (auto node = cells[y * cols + x]; node != INVALID; node = nodes[node].next) {
+                    visit(nodes[node].item);
+                }
+            }
+        }
+    }
+    ARRAY_FOREACH(p, large) visit(*p);
+
+    //top-down
+    std::sort(hits.begin(), hits.end(), [](uint32_t a, uint32_t b) { return a > b; });
+
+    ARRAY_FOREACH(p, hits) {
+        auto paint = items[*p].paint;
+        if (PAINT(paint)->intersects(region, true) && !func(paint, data)) break;
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
 
 Scene::Scene() = default;
 
@@ -53,7 +244,22 @@ Result Scene::remove(Paint* paint) noexcept
 
 const list<Paint*>& Scene::paints() const noexcept
 {
-    return to<SceneImpl>(this)->paints;
+    return to<SceneImpl>(this)->toList();
+}
+
+
+uint32_t Scene::paints(Paint* const** paints) const noexcept
+{
+    auto scene = to<SceneImpl>(this);
+    if (paints) *paints = scene->paints.data;
+    return scene->paints.count;
+}
+
+
+Result Scene::pick(int32_t x, int32_t y, int32_t w, int32_t h, std::function<bool(Paint* paint, void* data)> func, void* data) noexcept
+{
+    if (w <= 0 || h <= 0 || !func) return Result::InvalidArguments;
+    return to<SceneImpl>(this)->pick({{x, y}, {x + w, y + h}}, func, data);
 }
 
 
@@ -28,12 +28,57 @@
 #include "tvgPaint.h"
 #include "tvgAccessor.h"
 
+//Uniform grid of the children render regions for the fast region queries
+struct ScenePicker
+{
+    static constexpr uint32_t INVALID = UINT32_MAX;
+    static constexpr uint32_t MAX_CELLS = 64;    //an item spanning more cells is kept out of the grid
+
+    struct Item
+    {
+        Paint* paint;
+        RenderRegion box;     //indexed render region
+        uint32_t stamp;       //the last query visited
+        bool large;
+    };
+
+    struct Node
+    {
+        uint32_t item;
+        uint32_t next;
+    };
+
+    Array<Item> items;        //children in the drawing order
+    Array<uint32_t> cells;    //the first node of each cell
+    Array<Node> nodes;        //items in the cells
+    Array<uint32_t> large;    //items out of the grid
+    RenderRegion domain{};
+    uint32_t freed = INVALID; //recycled nodes
+    uint32_t stamp = 0;
+    int32_t size = 0;         //cell size in pixels
+    int32_t cols = 0, rows = 0;
+    bool dirty = true;        //children might be updated
+    bool reset = true;        //children list is changed
+
+    void pick(const Array<Paint*>& paints, RenderMethod* renderer, const RenderRegion& region, std::function<bool(Paint* paint, void* data)>& func, void* data);
+
+private:
+    void rebuild(const Array<Paint*>& paints, const RenderRegion& viewport);
+    void refresh(const Array<Paint*>& paints, RenderMethod* renderer);
+    bool range(const RenderRegion& box, RenderRegion& out);
+    void insert(uint32_t idx);
+    void remove(uint32_t idx);
+};
+
+
 struct SceneImpl : Scene
 {
     Paint::Impl impl;
-    list<Paint*> paints;     //children list
+    Array<Paint*> paints;    //children in the rendering order
+    list<Paint*>* plist = nullptr;  //lazily built for the Scene::paints() list compatibility
     RenderRegion vport = {};
     Array<RenderEffect*>* effects = nullptr;
+    ScenePicker* picker = nullptr;
     Point fsize;          //fixed scene size
     bool fixed = false;   //true: fixed scene size, false: dynamic size
     bool vdirty = false;
@@ -47,6 +92,8 @@ struct SceneImpl : Scene
     {
         clearPaints();
         resetEffects(false);
+        delete(picker);
+        delete(plist);
     }
 
     void size(const Point& size)
@@ -68,8 +115,8 @@ struct SceneImpl : Scene
         if (opacity == 255) return impl.cmpFlag;
 
         //Only shape or picture may not require composition.
-        if (paints.size() == 1) {
-            auto type = paints.front()->type();
+        if (paints.count == 1) {
+            auto type = paints.first()->type();
             if (type == Type::Shape || type == Type::Picture) return impl.cmpFlag;
         }
 
@@ -97,8 +144,8 @@ struct SceneImpl : Scene
         //allow partial rendering?
         auto recover = fixed ? renderer->partial(true) : false;
 
-        for (auto paint : paints) {
-            PAINT(paint)->update(renderer, transform, clips, opacity, flag, false);
+        ARRAY_FOREACH(p, paints) {
+            PAINT((*p))->update(renderer, transform, clips, opacity, flag, false);
         }
 
         //recover the condition
@@ -110,6 +157,8 @@ struct SceneImpl : Scene
             }
         }
 
+        if (picker) picker->dirty = true;
+
         //this viewport update is more performant than in bounds(). No idea.
         vport = renderer->viewport();
 
@@ -143,8 +192,8 @@ struct SceneImpl : Scene
             renderer->beginComposite(cmp, MaskMethod::None, opacity);
         }
 
-        for (auto paint : paints) {
-            ret &= paint->pImpl->render(renderer, impl.cmpFlag);
+        ARRAY_FOREACH(p, paints) {
+            ret &= (*p)->pImpl->render(renderer, impl.cmpFlag);
         }
 
         if (cmp) {
@@ -170,8 +219,8 @@ struct SceneImpl : Scene
 
         //Merge regions
         RenderRegion pRegion = {{INT32_MAX, INT32_MAX}, {0, 0}};
-        for (auto paint : paints) {
-            auto region = paint->pImpl->bounds();
+        ARRAY_FOREACH(p, paints) {
+            auto region = (*p)->pImpl->bounds();
             if (region.min.x < pRegion.min.x) pRegion.min.x = region.min.x;
             if (pRegion.max.x < region.max.x) pRegion.max.x = region.max.x;
             if (region.min.y < pRegion.min.y) pRegion.min.y = region.min.y;
@@ -204,9 +253,9 @@ struct SceneImpl : Scene
         Point max = {-FLT_MAX, -FLT_MAX};
         auto ret = false;
 
-        for (auto paint : paints) {
+        ARRAY_FOREACH(p, paints) {
             Point tmp[4];
-            if (!PAINT(paint)->bounds(tmp, obb ? nullptr : &m, false)) continue;
+            if (!PAINT((*p))->bounds(tmp, obb ? nullptr : &m, false)) continue;
             //Merge regions
             for (int i = 0; i < 4; ++i) {
                 if (tmp[i].x < min.x) min.x = tmp[i].x;
@@ -236,8 +285,8 @@ struct SceneImpl : Scene
         if (!impl.renderer) return false;
 
         if (this->bounds().intersected(region)) {
-            for (auto paint : paints) {
-                if (PAINT(paint)->intersects(region, visibleOnly)) return true;
+            ARRAY_FOREACH(p, paints) {
+                if (PAINT((*p))->intersects(region, visibleOnly)) return true;
             }
         }
 
@@ -251,11 +300,12 @@ struct SceneImpl : Scene
         auto scene = Scene::gen();
         auto dup = to<SceneImpl>(scene);
 
-        for (auto paint : paints) {
-            auto cdup = paint->duplicate();
+        dup->paints.reserve(paints.count);
+        ARRAY_FOREACH(p, paints) {
+            auto cdup = (*p)->duplicate();
             PAINT(cdup)->parent = scene;
             cdup->ref();
-            dup->paints.push_back(cdup);
+            dup->paints.push(cdup);
         }
 
         if (effects) {
@@ -306,14 +356,15 @@ struct SceneImpl : Scene
         auto recover = (fixed && impl.renderer) ? impl.renderer->partial(true) : false;
         auto partialDmg = !(effects || fixed || recover);
 
-        auto itr = paints.begin();
-        while (itr != paints.end()) {
-            auto paint = PAINT((*itr));
+        ARRAY_FOREACH(p, paints) {
+            auto paint = PAINT((*p));
             //when the paint is destroyed damage will be triggered
             if (paint->refCnt > 1 && partialDmg) paint->damage();
             paint->unref();
-            paints.erase(itr++);
         }
+        paints.clear();
+        if (plist) plist->clear();
+        if (picker) picker->reset = true;
         if (fixed && impl.renderer) impl.renderer->partial(recover);
         if (effects || fixed) impl.damage(vport);  //redraw scene full region
 
@@ -326,7 +377,14 @@ struct SceneImpl : Scene
         //when the paint is destroyed damage will be triggered
         if (PAINT(paint)->refCnt > 1) PAINT(paint)->damage();
         PAINT(paint)->unref();
-        paints.remove(paint);
+        for (uint32_t i = 0; i < paints.count; ++i) {
+            if (paints[i] == paint) {
+                paints.remove(i);
+                break;
+            }
+        }
+        if (plist) plist->remove(paint);
+        if (picker) picker->reset = true;
         return Result::Success;
     }
 
@@ -346,16 +404,39 @@ struct SceneImpl : Scene
         timpl->mark(RenderUpdateFlag::Transform);
 
         if (!at) {
-            paints.push_back(target);
+            paints.push(target);
+            if (plist) plist->push_back(target);
         } else {
             //OPTIMIZE: Remove searching?
-            auto itr = find_if(paints.begin(), paints.end(),[&at](const Paint* paint){ return at == paint; });
-            if (itr == paints.end()) return Result::InvalidArguments;
-            paints.insert(itr, target);
+            uint32_t idx = 0;
+            while (idx < paints.count && paints[idx] != at) ++idx;
+            if (idx == paints.count) return Result::InvalidArguments;
+            paints.insert(idx, target);
+            if (plist) plist->insert(find(plist->begin(), plist->end(), at), target);
         }
         timpl->parent = this;
         if (timpl->clipper) PAINT(timpl->clipper)->parent = this;
         if (timpl->maskData) PAINT(timpl->maskData->target)->parent = this;
+        if (picker) picker->reset = true;
+        return Result::Success;
+    }
+
+    //built once on demand, then kept in sync with the children
+    const list<Paint*>& toList()
+    {
+        if (!plist) {
+            plist = new list<Paint*>;
+            ARRAY_FOREACH(p, paints) plist->push_back(*p);
+        }
+        return *plist;
+    }
+
+    Result pick(const RenderRegion& region, std::function<bool(Paint* paint, void* data)>& func, void* data)
+    {
+        if (!impl.renderer) return Result::InsufficientCondition;
+        if (paints.empty()) return Result::Success;
+        if (!picker) picker = new ScenePicker;
+        picker->pick(paints, impl.renderer, region, func, data);
         return Result::Success;
     }
 
@@ -363,20 +444,17 @@ struct SceneImpl : Scene
     {
         struct SceneIterator : AccessorIterator
         {
-            list<Paint*>* paints;
-            list<Paint*>::iterator itr;
+            Array<Paint*>* paints;
+            uint32_t idx = 0;
 
-            SceneIterator(list<Paint*>* p) : paints(p)
+            SceneIterator(Array<Paint*>* p) : paints(p)
             {
-                itr = paints->begin();
             }
 
             const Paint* next() override
             {
-                if (itr == paints->end()) return nullptr;
-                auto paint = *itr;
-                ++itr;
-                return paint;
+                if (idx >= paints->count) return nullptr;
+                return (*paints)[idx++];
             }
         };
 
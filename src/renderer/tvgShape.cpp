@@ -33,6 +33,12 @@ Shape* Shape::gen() noexcept
 }
 
 
+Shape* Shape::instance() noexcept
+{
+    return to<ShapeImpl>(this)->instance();
+}
+
+
 Type Shape::type() const noexcept
 {
     return Type::Shape;
@@ -48,11 +54,13 @@ Result Shape::reset() noexcept
 
 Result Shape::path(const PathCommand** cmds, uint32_t* cmdsCnt, const Point** pts, uint32_t* ptsCnt) const noexcept
 {
-    if (cmds) *cmds = to<ShapeImpl>(this)->rs.path.cmds.data;
-    if (cmdsCnt) *cmdsCnt = to<ShapeImpl>(this)->rs.path.cmds.count;
+    auto& path = to<ShapeImpl>(this)->shape().path;
+
+    if (cmds) *cmds = path.cmds.data;
+    if (cmdsCnt) *cmdsCnt = path.cmds.count;
 
-    if (pts) *pts = to<ShapeImpl>(this)->rs.path.pts.data;
-    if (ptsCnt) *ptsCnt = to<ShapeImpl>(this)->rs.path.pts.count;
+    if (pts) *pts = path.pts.data;
+    if (ptsCnt) *ptsCnt = path.pts.count;
 
     return Result::Success;
 }
@@ -74,7 +82,7 @@ Result Shape::moveTo(float x, float y) noexcept
 Result Shape::lineTo(float x, float y) noexcept
 {
     to<ShapeImpl>(this)->rs.path.lineTo({x, y});
-    to<ShapeImpl>(this)->impl.mark(RenderUpdateFlag::Path);
+    to<ShapeImpl>(this)->mark(RenderUpdateFlag::Path);
     return Result::Success;
 }
 
@@ -82,7 +90,7 @@ Result Shape::lineTo(float x, float y) noexcept
 Result Shape::cubicTo(float cx1, float cy1, float cx2, float cy2, float x, float y) noexcept
 {
     to<ShapeImpl>(this)->rs.path.cubicTo({cx1, cy1}, {cx2, cy2}, {x, y});
-    to<ShapeImpl>(this)->impl.mark(RenderUpdateFlag::Path);
+    to<ShapeImpl>(this)->mark(RenderUpdateFlag::Path);
     return Result::Success;
 }
 
@@ -90,7 +98,7 @@ Result Shape::cubicTo(float cx1, float cy1, float cx2, float cy2, float x, float
 Result Shape::close() noexcept
 {
     to<ShapeImpl>(this)->rs.path.close();
-    to<ShapeImpl>(this)->impl.mark(RenderUpdateFlag::Path);
+    to<ShapeImpl>(this)->mark(RenderUpdateFlag::Path);
     return Result::Success;
 }
 
@@ -124,14 +132,14 @@ Result Shape::fill(Fill* f) noexcept
 
 Result Shape::fill(uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) const noexcept
 {
-    to<ShapeImpl>(this)->rs.fillColor(r, g, b, a);
+    to<ShapeImpl>(this)->shape().fillColor(r, g, b, a);
     return Result::Success;
 }
 
 
 const Fill* Shape::fill() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.fill;
+    return to<ShapeImpl>(this)->shape().fill;
 }
 
 
@@ -152,7 +160,7 @@ Result Shape::strokeWidth(float width) noexcept
 
 float Shape::strokeWidth() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeWidth();
+    return to<ShapeImpl>(this)->shape().strokeWidth();
 }
 
 
@@ -165,7 +173,7 @@ Result Shape::strokeFill(uint8_t r, uint8_t g, uint8_t b, uint8_t a) noexcept
 
 Result Shape::strokeFill(uint8_t* r, uint8_t* g, uint8_t* b, uint8_t* a) const noexcept
 {
-    if (!to<ShapeImpl>(this)->rs.strokeFill(r, g, b, a)) return Result::InsufficientCondition;
+    if (!to<ShapeImpl>(this)->shape().strokeFill(r, g, b, a)) return Result::InsufficientCondition;
     return Result::Success;
 }
 
@@ -178,7 +186,7 @@ Result Shape::strokeFill(Fill* f) noexcept
 
 const Fill* Shape::strokeFill() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeFill();
+    return to<ShapeImpl>(this)->shape().strokeFill();
 }
 
 
@@ -190,7 +198,7 @@ Result Shape::strokeDash(const float* dashPattern, uint32_t cnt, float offset) n
 
 uint32_t Shape::strokeDash(const float** dashPattern, float* offset) const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeDash(dashPattern, offset);
+    return to<ShapeImpl>(this)->shape().strokeDash(dashPattern, offset);
 }
 
 
@@ -216,19 +224,19 @@ Result Shape::strokeMiterlimit(float miterlimit) noexcept
 
 StrokeCap Shape::strokeCap() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeCap();
+    return to<ShapeImpl>(this)->shape().strokeCap();
 }
 
 
 StrokeJoin Shape::strokeJoin() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeJoin();
+    return to<ShapeImpl>(this)->shape().strokeJoin();
 }
 
 
 float Shape::strokeMiterlimit() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.strokeMiterlimit();
+    return to<ShapeImpl>(this)->shape().strokeMiterlimit();
 }
 
 
@@ -241,12 +249,12 @@ Result Shape::trimpath(float begin, float end, bool simultaneous) noexcept
 
 Result Shape::fillRule(FillRule r) noexcept
 {
-    to<ShapeImpl>(this)->rs.rule = r;
+    to<ShapeImpl>(this)->fillRule(r);
     return Result::Success;
 }
 
 
 FillRule Shape::fillRule() const noexcept
 {
-    return to<ShapeImpl>(this)->rs.rule;
+    return to<ShapeImpl>(this)->shape().rule;
 }
\ No newline at end of file
@@ -34,12 +34,75 @@ struct ShapeImpl : Shape
 {
     Paint::Impl impl;
     RenderShape rs;
-    uint8_t opacity;    //for composition
+    ShapeImpl* source = nullptr;  //the shape instanced by this
+    RenderShape* view = nullptr;  //the source geometry with the fill color of this instance
+    uint32_t version = 0;         //changes of this shape followed by its instances
+    uint32_t synced = 0;          //the source version applied to this instance
+    uint8_t opacity;              //for composition
+    bool recolor = false;         //the instance overrides the source fill color
 
     ShapeImpl() : impl(Paint::Impl(this))
     {
     }
 
+    ~ShapeImpl()
+    {
+        unbind();
+    }
+
+    void mark(RenderUpdateFlag flag)
+    {
+        impl.mark(flag);
+        ++version;
+    }
+
+    //the shape data to render, borrowed from the source in the case of an instance
+    const RenderShape& shape()
+    {
+        if (!source) return rs;
+        if (!recolor) return source->rs;
+
+        if (!view) view = new RenderShape;
+        auto& src = source->rs;
+        view->path.cmds.data = src.path.cmds.data;
+        view->path.cmds.count = view->path.cmds.reserved = src.path.cmds.count;
+        view->path.pts.data = src.path.pts.data;
+        view->path.pts.count = view->path.pts.reserved = src.path.pts.count;
+        view->stroke = src.stroke;
+        view->glyphs = src.glyphs;
+        view->rule = src.rule;
+        view->color = rs.color;
+        return *view;
+    }
+
+    Shape* instance()
+    {
+        auto shape = Shape::gen();
+        auto dup = to<ShapeImpl>(shape);
+        dup->source = source ? source : this;
+        dup->synced = dup->source->version;
+        PAINT(dup->source)->ref();
+        return shape;
+    }
+
+    void unbind()
+    {
+        if (!source) return;
+
+        if (view) {
+            view->path.dismiss();
+            view->stroke = nullptr;
+            view->glyphs = nullptr;
+            delete(view);
+            view = nullptr;
+        }
+        //keep the source in its parent
+        PAINT(source)->unrefx(true);
+        source = nullptr;
+        recolor = false;
+        mark(RenderUpdateFlag::All);
+    }
+
     bool render(RenderMethod* renderer, TVG_UNUSED CompositionFlag flag)
     {
         if (!impl.rd) return false;
@@ -62,6 +125,8 @@ struct ShapeImpl : Shape
     {
         if (opacity == 0) return false;
 
+        auto& rs = shape();
+
         //Shape composition is only necessary when stroking & fill are valid.
         if (!rs.stroke || rs.stroke->width < FLOAT_EPSILON || (!rs.stroke->fill && rs.stroke->color.a == 0)) return false;
         if (!rs.fill && rs.color.a == 0) return false;
@@ -96,7 +161,7 @@ struct ShapeImpl : Shape
 
     bool skip(RenderUpdateFlag flag)
     {
-        return (flag == RenderUpdateFlag::None);
+        return (flag == RenderUpdateFlag::None) && (!source || synced == source->version);
     }
 
     bool update(RenderMethod* renderer, const Matrix& transform, Array<RenderData>& clips, uint8_t opacity, RenderUpdateFlag flag, bool clipper)
@@ -108,7 +173,13 @@ struct ShapeImpl : Shape
             opacity = 255;
         }
 
-        impl.rd = renderer->prepare(rs, impl.rd, transform, clips, opacity, flag, clipper);
+        //follow the changes of the source
+        if (source && synced != source->version) {
+            flag |= RenderUpdateFlag::All;
+            synced = source->version;
+        }
+
+        impl.rd = renderer->prepare(shape(), impl.rd, transform, clips, opacity, flag, clipper);
         return true;
     }
 
@@ -120,6 +191,7 @@ struct ShapeImpl : Shape
     bool bounds(Point* pt4, const Matrix& m, bool obb)
     {
         auto fallback = true;  //TODO: remove this when all backend engines support bounds()
+        auto& rs = shape();
 
         if (impl.renderer && rs.strokeWidth() > 0.0f) {
             if (impl.renderer->bounds(impl.rd, pt4, obb ? tvg::identity() : m)) {
@@ -185,7 +257,7 @@ struct ShapeImpl : Shape
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
         rs.stroke->width = width;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
     }
 
     void trimpath(const RenderTrimPath& trim)
@@ -198,15 +270,15 @@ struct ShapeImpl : Shape
         if (tvg::equal(rs.stroke->trim.begin, trim.begin) && tvg::equal(rs.stroke->trim.end, trim.end) && rs.stroke->trim.simultaneous == trim.simultaneous) return;
 
         rs.stroke->trim = trim;
-        impl.mark(RenderUpdateFlag::Path);
+        mark(RenderUpdateFlag::Path);
     }
 
     bool trimpath(float* begin, float* end)
     {
-        if (rs.stroke) {
-            if (begin) *begin = rs.stroke->trim.begin;
-            if (end) *end = rs.stroke->trim.end;
-            return rs.stroke->trim.simultaneous;
+        if (auto stroke = shape().stroke) {
+            if (begin) *begin = stroke->trim.begin;
+            if (end) *end = stroke->trim.end;
+            return stroke->trim.simultaneous;
         } else {
             if (begin) *begin = 0.0f;
             if (end) *end = 1.0f;
@@ -214,18 +286,25 @@ struct ShapeImpl : Shape
         }
     }
 
+    void fillRule(FillRule rule)
+    {
+        if (rs.rule == rule) return;
+        rs.rule = rule;
+        mark(RenderUpdateFlag::Path);
+    }
+
     void strokeCap(StrokeCap cap)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
         rs.stroke->cap = cap;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
     }
 
     void strokeJoin(StrokeJoin join)
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
         rs.stroke->join = join;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
     }
 
     Result strokeMiterlimit(float miterlimit)
@@ -235,7 +314,7 @@ struct ShapeImpl : Shape
         if (miterlimit < 0.0f) return Result::InvalidArguments;
         if (!rs.stroke) rs.stroke = new RenderStroke();
         rs.stroke->miterlimit = miterlimit;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
 
         return Result::Success;
     }
@@ -252,12 +331,12 @@ struct ShapeImpl : Shape
         if (rs.stroke->fill) {
             delete(rs.stroke->fill);
             rs.stroke->fill = nullptr;
-            impl.mark(RenderUpdateFlag::GradientStroke);
+            mark(RenderUpdateFlag::GradientStroke);
         }
 
         rs.stroke->color = {r, g, b, a};
 
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
     }
 
     Result strokeFill(Fill* f)
@@ -269,7 +348,7 @@ struct ShapeImpl : Shape
         rs.stroke->fill = f;
         rs.stroke->color.a = 0;
 
-        impl.mark(RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
+        mark(RenderUpdateFlag::Stroke | RenderUpdateFlag::GradientStroke);
 
         return Result::Success;
     }
@@ -294,7 +373,7 @@ struct ShapeImpl : Shape
         }
         rs.stroke->dash.count = cnt;
         rs.stroke->dash.offset = offset;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
 
         return Result::Success;
     }
@@ -309,7 +388,7 @@ struct ShapeImpl : Shape
     {
         if (!rs.stroke) rs.stroke = new RenderStroke();
         rs.stroke->first = first;
-        impl.mark(RenderUpdateFlag::Stroke);
+        mark(RenderUpdateFlag::Stroke);
     }
 
     Result fill(Fill* f)
@@ -318,30 +397,38 @@ struct ShapeImpl : Shape
 
         if (rs.fill && rs.fill != f) delete(rs.fill);
         rs.fill = f;
-        impl.mark(RenderUpdateFlag::Gradient);
+        mark(RenderUpdateFlag::Gradient);
 
         return Result::Success;
     }
 
     void fill(uint8_t r, uint8_t g, uint8_t b, uint8_t a)
     {
+        if (source) {
+            recolor = true;
+            rs.color = {r, g, b, a};
+            mark(RenderUpdateFlag::Color | RenderUpdateFlag::Gradient);
+            return;
+        }
+
         if (rs.fill) {
             delete(rs.fill);
             rs.fill = nullptr;
-            impl.mark(RenderUpdateFlag::Gradient);
+            mark(RenderUpdateFlag::Gradient);
         }
 
         if (r == rs.color.r && g == rs.color.g && b == rs.color.b && a == rs.color.a) return;
 
         rs.color = {r, g, b, a};
-        impl.mark(RenderUpdateFlag::Color);
+        mark(RenderUpdateFlag::Color);
     }
 
     void resetPath()
     {
+        unbind();
         rs.path.cmds.clear();
         rs.path.pts.clear();
-        impl.mark(RenderUpdateFlag::Path);
+        mark(RenderUpdateFlag::Path);
     }
 
     Result addPath(const PathCommand* cmds, uint32_t cmdCnt, const Point* pts, uint32_t ptsCnt)
@@ -350,7 +437,7 @@ struct ShapeImpl : Shape
 
         grow(cmdCnt, ptsCnt);
         append(cmds, cmdCnt, pts, ptsCnt);
-        impl.mark(RenderUpdateFlag::Path);
+        mark(RenderUpdateFlag::Path);
 
         return Result::Success;
     }
@@ -358,17 +445,26 @@ struct ShapeImpl : Shape
     void addCircle(float cx, float cy, float rx, float ry, bool cw)
     {
         rs.path.addCircle(cx, cy, rx, ry, cw);
-        impl.mark(RenderUpdateFlag::Path);
+        mark(RenderUpdateFlag::Path);
     }
 
     void addRect(float x, float y, float w, float h, float rx, float ry, bool cw)
     {
         rs.path.addRect(x, y, w, h, rx, ry, cw);
-        impl.mark(RenderUpdateFlag::Path);
+        mark(RenderUpdateFlag::Path);
     }
 
     Paint* duplicate(Paint* ret)
     {
+        //another instance of the same source
+        if (source && !ret) {
+            auto shape = source->instance();
+            auto dup = to<ShapeImpl>(shape);
+            dup->recolor = recolor;
+            dup->rs.color = rs.color;
+            return shape;
+        }
+
         auto shape = static_cast<Shape*>(ret);
         if (!shape) shape = Shape::gen();
         auto dup = to<ShapeImpl>(shape);
@@ -379,9 +475,7 @@ struct ShapeImpl : Shape
         dup->rs.path.pts.push(rs.path.pts);
 
         //Fill
-        delete(dup->rs.fill);
-        if (rs.fill) dup->rs.fill = rs.fill->duplicate();
-        else dup->rs.fill = nullptr;
+        dup->rs.fill = fillDuplicate(rs.fill, dup->rs.fill);
 
         //Stroke
         if (rs.stroke) {
@@ -401,6 +495,7 @@ struct ShapeImpl : Shape
     void reset()
     {
         PAINT(this)->reset();
+        unbind();
         rs.path.cmds.clear();
         rs.path.pts.clear();
 
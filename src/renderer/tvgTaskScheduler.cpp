@@ -33,6 +33,8 @@ namespace tvg {
 
 #ifdef THORVG_THREAD_SUPPORT
 
+static thread_local unsigned _worker = 0;   //the worker index passed to the tasks, 0 for the non-worker threads
+
 struct TaskQueue {
     Inlist<Task>             taskDeque;
     mutex                    mtx;
@@ -44,6 +46,7 @@ struct TaskQueue {
         unique_lock<mutex> lock{mtx, try_to_lock};
         if (!lock || taskDeque.empty()) return false;
         *task = taskDeque.front();
+        (*task)->queue = nullptr;
         return true;
     }
 
@@ -52,6 +55,7 @@ struct TaskQueue {
         {
             unique_lock<mutex> lock{mtx, try_to_lock};
             if (!lock) return false;
+            task->queue = this;
             taskDeque.back(task);
         }
         ready.notify_one();
@@ -78,6 +82,17 @@ struct TaskQueue {
         if (taskDeque.empty()) return false;
 
         *task = taskDeque.front();
+        (*task)->queue = nullptr;
+        return true;
+    }
+
+    //take back the task no worker has started yet
+    bool remove(Task* task)
+    {
+        lock_guard<mutex> lock{mtx};
+        if (task->queue != this) return false;
+        taskDeque.remove(task);
+        task->queue = nullptr;
         return true;
     }
 
@@ -85,6 +100,7 @@ struct TaskQueue {
     {
         {
             lock_guard<mutex> lock{mtx};
+            task->queue = this;
             taskDeque.back(task);
         }
         ready.notify_one();
@@ -129,6 +145,9 @@ struct TaskSchedulerImpl
     void run(unsigned i)
     {
         Task* task;
+        _worker = i + 1;
+
+        TVGTRACE_THREAD("worker", _worker);
 
         //Thread Loop
         while (true) {
@@ -165,8 +184,34 @@ struct TaskSchedulerImpl
     {
         return threads.count;
     }
+
+    //Run the pending task on the calling thread if it's still queued.
+    //Otherwise a worker waiting for a task queued behind itself would never wake up.
+    //The task takes over the caller's tid, which no other thread uses at the moment. Thus a task must not hold
+    //any resources bound to its tid (i.e. SwMpool) while it waits for another task. See SwShapeTask::share()
+    static bool retrieve(Task* task)
+    {
+        auto queue = static_cast<TaskQueue*>(task->queue.load());
+        if (!queue || !queue->remove(task)) return false;
+        (*task)(_worker);
+        return true;
+    }
 };
 
+
+void Task::done()
+{
+    if (!pending) return;
+
+    TVGTRACE("Task::done");
+
+    TaskSchedulerImpl::retrieve(this);
+
+    unique_lock<mutex> lock(mtx);
+    while (!ready) cv.wait(lock);
+    pending = false;
+}
+
 #else //THORVG_THREAD_SUPPORT
 
 struct TaskSchedulerImpl
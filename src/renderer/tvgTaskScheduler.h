@@ -25,6 +25,7 @@
 
 #include "tvgCommon.h"
 #include "tvgInlist.h"
+#include "tvgTrace.h"
 
 #ifdef THORVG_THREAD_SUPPORT
     #include <atomic>
@@ -45,6 +46,7 @@ struct Task
 private:
     mutex                   mtx;
     condition_variable      cv;
+    atomic<void*>           queue{nullptr};  //the task queue holding it until a worker takes it
     bool                    ready = true;
     bool                    pending = false;
 
@@ -53,14 +55,7 @@ public:
 
     virtual ~Task() = default;
 
-    void done()
-    {
-        if (!pending) return;
-
-        unique_lock<mutex> lock(mtx);
-        while (!ready) cv.wait(lock);
-        pending = false;
-    }
+    void done();
 
 protected:
     virtual void run(unsigned tid) = 0;
@@ -68,11 +63,12 @@ protected:
 private:
     void operator()(unsigned tid)
     {
+        TVGTRACE("Task");
         run(tid);
 
         lock_guard<mutex> lock(mtx);
         ready = true;
-        cv.notify_one();
+        cv.notify_all();
     }
 
     void prepare()
@@ -82,6 +78,7 @@ private:
     }
 
     friend struct TaskSchedulerImpl;
+    friend struct TaskQueue;
 };
 
 #else  //THORVG_THREAD_SUPPORT
@@ -118,7 +118,9 @@ struct TextImpl : Text
     {
         if (!loader) return false;
         if (updated) {
-            if (loader->get(fm, utf8, utf8len, to<ShapeImpl>(shape)->rs.path)) {
+            auto& rs = to<ShapeImpl>(shape)->rs;
+            if (!rs.glyphs) rs.glyphs = new RenderGlyphs;
+            if (loader->get(fm, utf8, utf8len, rs.path, *rs.glyphs)) {
                 loader->transform(shape, fm, italicShear);
             }
             updated = false;
@@ -40,9 +40,12 @@
 // Only RGBA8 is currently supported as an input format. (The alpha is ignored.)
 //
 // USAGE:
-// Create a GifWriter struct. Pass it to GifBegin() to initialize and write the header.
-// Pass subsequent frames to GifWriteFrame().
-// Finally, call GifEnd() to close the file handle and free memory.
+// Create a GifWriter struct. Pass it to GifBegin() to initialize, the header goes out with the first frame.
+// Each frame goes through GifQuantize() over the previous frame, then GifEncode().
+// Only the changed region of a frame is encoded, and the global palette of the first frame is reused while it fits.
+// The quantization is sequential, but the encoding of the different frames can run in parallel.
+// Pass the encoded frames to GifWriteFrame() in order.
+// Finally, call GifEnd() to write the trailer.
 //
 
 #include "tvgMath.h"
@@ -54,6 +57,9 @@
 #define BIT_DEPTH 8
 #define LEAF_NODE 0xff
 #define MAX_PAL_COLORS ((1 << BIT_DEPTH) - 1)
+#define GLOBAL_PAL_SAMPLES 1024    // changed pixels checked against the global palette
+#define GLOBAL_PAL_MAX_ERROR 24    // the largest color distance allowed for the global palette
+#define GLOBAL_PAL_AVG_ERROR 3     // the average color distance allowed for the global palette
 
 // Simple structure to write out the LZW-compressed portion of the image
 // one bit at a time
@@ -245,28 +251,82 @@ static void _splitBox(uint8_t* image, GifBoxes* boxes, int idx, int rhsIdx)
     _computeBoxStats(image, boxes, rhsIdx);
 }
 
-// Finds all pixels that have changed from the previous image and
-// moves them to the from of the buffer.
+// Finds the bounding box of the pixels to be drawn in this frame, only this region is encoded.
+// Over the previous frame, the pixels of the changed colors are drawn.
+// With transparency, the previous frame is cleared, so the visible pixels are drawn.
+// With nothing to draw, a single transparent pixel keeps the frame.
+static void _findChangedRegion(GifFrame* frame, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, bool transparent)
+{
+    // every pixel is new
+    if (!lastFrame && !transparent) {
+        frame->left = frame->top = 0;
+        frame->width = width;
+        frame->height = height;
+        return;
+    }
+
+    auto changed = [&](uint32_t idx) {
+        auto next = nextFrame + idx * 4;
+        if (transparent) return next[3] >= TRANSPARENT_THRESHOLD;
+        auto last = lastFrame + idx * 4;
+        return last[0] != next[0] || last[1] != next[1] || last[2] != next[2];
+    };
+
+    uint32_t x0 = width, x1 = 0, y0 = height, y1 = 0;
+
+    for (uint32_t yy = 0; yy < height; ++yy) {
+        auto row = yy * width;
+        uint32_t left = 0;
+        while (left < width && !changed(row + left)) ++left;
+        if (left == width) continue;
+        uint32_t right = width;
+        while (!changed(row + right - 1)) --right;
+
+        if (left < x0) x0 = left;
+        if (right > x1) x1 = right;
+        if (y0 == height) y0 = yy;
+        y1 = yy + 1;
+    }
+
+    if (y0 == height) {
+        frame->left = frame->top = 0;
+        frame->width = frame->height = 1;
+        return;
+    }
+
+    frame->left = x0;
+    frame->top = y0;
+    frame->width = x1 - x0;
+    frame->height = y1 - y0;
+}
+
+// Finds all pixels in the changed region that have changed from the previous image and
+// gathers them in the working buffer.
 // This allows us to build a palette optimized for the colors of the
 // changed pixels only.
 // With no previous frame, every visible pixel counts as changed.
-static int _pickChangedPixels(const uint8_t* lastFrame, uint8_t* frame, int numPixels, bool transparent)
+static int _pickChangedPixels(const GifFrame* frame, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, bool transparent)
 {
     int numChanged = 0;
-    uint8_t* writeIter = frame;
-
-    for (int ii=0; ii < numPixels; ++ii) {
-        if (frame[3] >= TRANSPARENT_THRESHOLD) {
-            if (!lastFrame || transparent || (lastFrame[0] != frame[0] || lastFrame[1] != frame[1] || lastFrame[2] != frame[2])) {
-                writeIter[0] = frame[0];
-                writeIter[1] = frame[1];
-                writeIter[2] = frame[2];
-                ++numChanged;
-                writeIter += 4;
+    uint8_t* writeIter = frame->tmpImage;
+
+    for (uint32_t yy = frame->top; yy < frame->top + frame->height; ++yy) {
+        auto offset = (yy * width + frame->left) * 4;
+        auto last = lastFrame ? lastFrame + offset : NULL;
+        auto next = nextFrame + offset;
+        for (uint32_t xx = 0; xx < frame->width; ++xx) {
+            if (next[3] >= TRANSPARENT_THRESHOLD) {
+                if (!last || transparent || (last[0] != next[0] || last[1] != next[1] || last[2] != next[2])) {
+                    writeIter[0] = next[0];
+                    writeIter[1] = next[1];
+                    writeIter[2] = next[2];
+                    ++numChanged;
+                    writeIter += 4;
+                }
             }
+            if (last) last += 4;
+            next += 4;
         }
-        if (lastFrame) lastFrame += 4;
-        frame += 4;
     }
 
     return numChanged;
@@ -341,25 +401,17 @@ static void _buildSearchTree(GifPalette* pal, uint8_t* colors, int count, int fi
     _buildSearchTree(pal, colors + (count / 2) * 3, count - count / 2, splitElt, lastElt, treeRoot * 2 + 1);
 }
 
-// Quantizes the pixels into up to MAX_PAL_COLORS colors by cutting them into boxes in RGB space and averaging each box.
+// Quantizes the picked pixels into up to MAX_PAL_COLORS colors by cutting them into boxes in RGB space and averaging each box.
 // A k-d tree is then built over those colors, which is what fills in the palette entries.
-static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, uint32_t height, bool transparent)
+static void _medianCut(GifFrame* frame, int numPixels)
 {
-    auto& pal = writer->pal;
-
-    size_t imageSize = (size_t)(width * height * 4 * sizeof(uint8_t));
-    memcpy(writer->tmpImage, nextFrame, imageSize);
-
-    int numPixels = (int)(width * height);
-    numPixels = _pickChangedPixels(lastFrame, writer->tmpImage, numPixels, transparent);
-
-    if (numPixels == 0) return;
+    auto& pal = frame->pal;
 
     // Start with a single large box that contains the picked pixels
     GifBoxes boxes;
     boxes.start[0] = 0;
     boxes.len[0] = numPixels;
-    _computeBoxStats(writer->tmpImage, &boxes, 0);
+    _computeBoxStats(frame->tmpImage, &boxes, 0);
 
     int numBoxes = 1;
 
@@ -378,7 +430,7 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
         // If every box holds a single color
         if (target < 0) break;
 
-        _splitBox(writer->tmpImage, &boxes, target, numBoxes);
+        _splitBox(frame->tmpImage, &boxes, target, numBoxes);
         ++numBoxes;
     }
 
@@ -386,6 +438,51 @@ static void _makePalette(GifWriter* writer, const uint8_t* lastFrame, const uint
 }
 
 
+// Checks whether the palette represents the colors well enough, over the samples of them.
+static bool _fitPalette(GifPalette* pal, const uint8_t* pixels, int count)
+{
+    int step = count / GLOBAL_PAL_SAMPLES + 1;
+    int total = 0;
+    int samples = 0;
+
+    for (int ii = 0; ii < count; ii += step, ++samples) {
+        auto pixel = pixels + ii * 4;
+        int32_t bestDiff = 1000000;
+        int32_t bestInd = 1;
+        _getClosestPaletteColor(pal, pixel[0], pixel[1], pixel[2], &bestInd, &bestDiff, 1);
+        if (bestDiff > GLOBAL_PAL_MAX_ERROR) return false;
+        total += bestDiff;
+    }
+
+    return total <= samples * GLOBAL_PAL_AVG_ERROR;
+}
+
+
+// Picks the palette for the changed pixels of the frame.
+// The first frame makes the global palette, the others reuse it unless their colors drifted away from it.
+static void _makePalette(GifFrame* frame, const uint8_t* lastFrame, const uint8_t* nextFrame, uint32_t width, bool transparent)
+{
+    auto numPixels = _pickChangedPixels(frame, lastFrame, nextFrame, width, transparent);
+
+    // the first frame has no previous one
+    if (!lastFrame) {
+        if (numPixels > 0) _medianCut(frame, numPixels);
+        memcpy(frame->global, &frame->pal, sizeof(GifPalette));
+        frame->local = false;
+        return;
+    }
+
+    if (numPixels == 0 || _fitPalette(frame->global, frame->tmpImage, numPixels)) {
+        memcpy(&frame->pal, frame->global, sizeof(GifPalette));
+        frame->local = false;
+        return;
+    }
+
+    _medianCut(frame, numPixels);
+    frame->local = true;
+}
+
+
 void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pPal)
 {
     int32_t bestDiff = 1000000;
@@ -400,41 +497,47 @@ void _palettizePixel(const uint8_t* nextFrame, uint8_t* outFrame, GifPalette* pP
 }
 
 
-// Picks palette colors for the image using simple threshholding, no dithering
-static void _thresholdImage(GifWriter* writer, const uint8_t* lastFrame, const uint8_t* nextFrame,  uint32_t width, uint32_t height, bool transparent)
+// Picks palette colors for the changed region using simple threshholding, no dithering
+static void _thresholdImage(GifFrame* frame, const uint8_t* lastFrame, const uint8_t* nextFrame,  uint32_t width, uint32_t height, bool transparent)
 {
-    auto outFrame = writer->oldImage;
-    uint32_t numPixels = width*height;
-
-    if (transparent) {
-        for (uint32_t ii = 0; ii < numPixels; ++ii) {
-            if (nextFrame[3] < TRANSPARENT_THRESHOLD) {
-                outFrame[0] = 0;
-                outFrame[1] = 0;
-                outFrame[2] = 0;
-                outFrame[3] = TRANSPARENT_IDX;
-            } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+    // out of the changed region, the previous frame stays
+    if (lastFrame && !transparent) memcpy(frame->image, lastFrame, width * height * 4);
+
+    for (uint32_t yy = frame->top; yy < frame->top + frame->height; ++yy) {
+        auto offset = (yy * width + frame->left) * 4;
+        auto outFrame = frame->image + offset;
+        auto last = lastFrame ? lastFrame + offset : NULL;
+        auto next = nextFrame + offset;
+
+        if (transparent) {
+            for (uint32_t xx = 0; xx < frame->width; ++xx) {
+                if (next[3] < TRANSPARENT_THRESHOLD) {
+                    outFrame[0] = 0;
+                    outFrame[1] = 0;
+                    outFrame[2] = 0;
+                    outFrame[3] = TRANSPARENT_IDX;
+                } else {
+                    _palettizePixel(next, outFrame, &frame->pal);
+                }
+                outFrame += 4;
+                next += 4;
             }
-            if (lastFrame) lastFrame += 4;
-            outFrame += 4;
-            nextFrame += 4;
-        }
-    } else {
-        for (uint32_t ii = 0; ii < numPixels; ++ii) {
-            // if a previous color is available, and it matches the current color,
-            // set the pixel to transparent
-            if(lastFrame && lastFrame[0] == nextFrame[0] && lastFrame[1] == nextFrame[1] && lastFrame[2] == nextFrame[2]) {
-                outFrame[0] = lastFrame[0];
-                outFrame[1] = lastFrame[1];
-                outFrame[2] = lastFrame[2];
-                outFrame[3] = TRANSPARENT_IDX;
-            } else {
-                _palettizePixel(nextFrame, outFrame, &writer->pal);
+        } else {
+            for (uint32_t xx = 0; xx < frame->width; ++xx) {
+                // if a previous color is available, and it matches the current color,
+                // set the pixel to transparent
+                if (last && last[0] == next[0] && last[1] == next[1] && last[2] == next[2]) {
+                    outFrame[0] = last[0];
+                    outFrame[1] = last[1];
+                    outFrame[2] = last[2];
+                    outFrame[3] = TRANSPARENT_IDX;
+                } else {
+                    _palettizePixel(next, outFrame, &frame->pal);
+                }
+                if (last) last += 4;
+                outFrame += 4;
+                next += 4;
             }
-            if (lastFrame) lastFrame += 4;
-            outFrame += 4;
-            nextFrame += 4;
         }
     }
 }
@@ -458,11 +561,13 @@ static void _writeBit(GifBitStatus* stat, uint32_t bit)
 }
 
 
-// write all bytes so far to the file
-static void _writeChunk(FILE* f, GifBitStatus* stat)
+// write all bytes so far to the frame data
+static void _writeChunk(Array<uint8_t>* f, GifBitStatus* stat)
 {
-    fputc((int)stat->chunkIndex, f);
-    fwrite(stat->chunk, 1, stat->chunkIndex, f);
+    f->push(stat->chunkIndex);
+    f->grow(stat->chunkIndex);
+    memcpy(f->end(), stat->chunk, stat->chunkIndex);
+    f->count += stat->chunkIndex;
 
     stat->bitIndex = 0;
     stat->byte = 0;
@@ -470,7 +575,7 @@ static void _writeChunk(FILE* f, GifBitStatus* stat)
 }
 
 
-static void _writeCode(FILE* f, GifBitStatus* stat, uint32_t code, uint32_t length)
+static void _writeCode(Array<uint8_t>* f, GifBitStatus* stat, uint32_t code, uint32_t length)
 {
     for (uint32_t ii = 0; ii < length; ++ii) {
         _writeBit(stat, code);
@@ -480,60 +585,63 @@ static void _writeCode(FILE* f, GifBitStatus* stat, uint32_t code, uint32_t leng
 }
 
 
-// write a 256-color (8-bit) image palette to the file
-static void _writePalette(const GifPalette* pPal, FILE* f)
+// write a 256-color (8-bit) image palette to the frame data
+static void _writePalette(const GifPalette* pPal, Array<uint8_t>* f)
 {
-    fputc(0, f);  // first color: transparency
-    fputc(0, f);
-    fputc(0, f);
+    f->push(0);  // first color: transparency
+    f->push(0);
+    f->push(0);
 
     for (int ii = 1; ii < (1 << BIT_DEPTH); ++ii) {
-        fputc((int)pPal->color[ii].r, f);
-        fputc((int)pPal->color[ii].g, f);
-        fputc((int)pPal->color[ii].b, f);
+        f->push(pPal->color[ii].r);
+        f->push(pPal->color[ii].g);
+        f->push(pPal->color[ii].b);
     }
 }
 
 
 // write the image header, LZW-compress and write out the image
-static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+static void _writeLzwImage(GifFrame* frame, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
 {
-    auto f = writer->f;
-    auto image = writer->oldImage;
+    auto f = &frame->data;
+    auto image = frame->image;
+
+    f->clear();
 
     // graphics control extension
-    fputc(0x21, f);
-    fputc(0xf9, f);
-    fputc(0x04, f);
-    fputc((transparent ? 0x09 : 0x05), f);  //clear prev frame or not.
-    fputc(delay & 0xff, f);
-    fputc((delay >> 8) & 0xff, f);
-    fputc(TRANSPARENT_IDX, f); // transparent color index
-    fputc(0, f);
+    f->push(0x21);
+    f->push(0xf9);
+    f->push(0x04);
+    f->push((transparent ? 0x09 : 0x05));  //clear prev frame or not.
+    f->push(delay & 0xff);
+    f->push((delay >> 8) & 0xff);
+    f->push(TRANSPARENT_IDX); // transparent color index
+    f->push(0);
 
-    fputc(0x2c, f); // image descriptor block
+    f->push(0x2c); // image descriptor block
 
     // corner of image (left, top) in canvas space
-    fputc(0, f);
-    fputc(0, f);
-    fputc(0, f);
-    fputc(0, f);
-
-    fputc(width & 0xff, f);          // width and height of image
-    fputc((width >> 8) & 0xff, f);
-    fputc(height & 0xff, f);
-    fputc((height >> 8) & 0xff, f);
-
-    //fputc(0, f); // no local color table, no transparency
-    //fputc(0x80, f); // no local color table, but transparency
-
-    fputc(0x80 + BIT_DEPTH - 1, f); // local color table present, 2 ^ bitDepth entries
-    _writePalette(&writer->pal, f);
+    f->push(frame->left & 0xff);
+    f->push((frame->left >> 8) & 0xff);
+    f->push(frame->top & 0xff);
+    f->push((frame->top >> 8) & 0xff);
+
+    f->push(frame->width & 0xff);          // width and height of image
+    f->push((frame->width >> 8) & 0xff);
+    f->push(frame->height & 0xff);
+    f->push((frame->height >> 8) & 0xff);
+
+    if (frame->local) {
+        f->push(0x80 + BIT_DEPTH - 1); // local color table present, 2 ^ bitDepth entries
+        _writePalette(&frame->pal, f);
+    } else {
+        f->push(0); // the global color table
+    }
 
     const int minCodeSize = BIT_DEPTH;
     const uint32_t clearCode = 1 << BIT_DEPTH;
 
-    fputc(minCodeSize, f); // min code size 8 bits
+    f->push(minCodeSize); // min code size 8 bits
 
     GifLzwNode* codetree = tvg::malloc<GifLzwNode>(sizeof(GifLzwNode)*4096);
 
@@ -549,8 +657,8 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
 
     _writeCode(f, &stat, clearCode, codeSize);  // start with a fresh LZW dictionary
 
-    for (uint32_t yy = 0; yy < height; ++yy) {
-        for (uint32_t xx=0; xx<width; ++xx) {
+    for (uint32_t yy = frame->top; yy < frame->top + frame->height; ++yy) {
+        for (uint32_t xx = frame->left; xx < frame->left + frame->width; ++xx) {
             // top-left origin
             uint8_t nextValue = image[(yy*width+xx)*4+3];
 
@@ -592,6 +700,10 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
 
     // compression footer
     _writeCode(f, &stat, (uint32_t)curCode, codeSize);
+
+    // the decoder adds an entry for the last code as well, follow its code size
+    if (++maxCode >= (1ul << codeSize) && codeSize < 12) codeSize++;
+
     _writeCode(f, &stat, clearCode, codeSize);
     _writeCode(f, &stat, clearCode + 1, (uint32_t)minCodeSize + 1);
 
@@ -599,88 +711,126 @@ static void _writeLzwImage(GifWriter* writer, uint32_t width, uint32_t height, u
     while (stat.bitIndex) _writeBit(&stat, 0);
     if (stat.chunkIndex) _writeChunk(f, &stat);
 
-    fputc(0, f); // image block terminator
+    f->push(0); // image block terminator
 
     tvg::free(codetree);
 }
 
 
+// write the screen descriptor with the global palette, and the animation header
+static void _writeHeader(GifWriter* writer, const GifPalette* global)
+{
+    auto f = writer->f;
+
+    f->write("GIF89a", 6);
+
+    // screen descriptor
+    f->put(writer->width & 0xff);
+    f->put((writer->width >> 8) & 0xff);
+    f->put(writer->height & 0xff);
+    f->put((writer->height >> 8) & 0xff);
+
+    f->put(0xf0 + BIT_DEPTH - 1);  // there is an unsorted global color table of 2 ^ bitDepth entries
+    f->put(0);     // background color
+    f->put(0);     // pixels are square (we need to specify this because it's 1989)
+
+    // the global palette, color 0 is for transparency
+    f->put(0);
+    f->put(0);
+    f->put(0);
+
+    for (int ii = 1; ii < (1 << BIT_DEPTH); ++ii) {
+        f->put(global ? global->color[ii].r : 0);
+        f->put(global ? global->color[ii].g : 0);
+        f->put(global ? global->color[ii].b : 0);
+    }
+
+    if (writer->delay != 0) {
+        // animation header
+        f->put(0x21); // extension
+        f->put(0xff); // application specific
+        f->put(11); // length 11
+        f->write("NETSCAPE2.0", 11); // yes, really
+        f->put(3); // 3 bytes of NETSCAPE2.0 data
+
+        f->put(1); // JUST BECAUSE
+        f->put(0); // loop infinitely (byte 0)
+        f->put(0); // loop infinitely (byte 1)
+
+        f->put(0); // block terminator
+    }
+
+    writer->started = true;
+}
+
+
 /************************************************************************/
 /* External Class Implementation                                        */
 /************************************************************************/
 
 
-bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay)
+bool gifBegin(GifWriter* writer, SaveStream* stream, uint32_t width, uint32_t height, uint32_t delay)
 {
-#if defined(_MSC_VER) && (_MSC_VER >= 1400)
-	writer->f = 0;
-    fopen_s(&writer->f, filename, "wb");
-#else
-    writer->f = fopen(filename, "wb");
-#endif
-    if (!writer->f) return false;
+    writer->f = stream;
+    writer->width = width;
+    writer->height = height;
+    writer->delay = delay;
+    writer->started = false;
 
-    writer->firstFrame = true;
+    return writer->f != NULL;
+}
 
-    // allocate
-    writer->oldImage = tvg::malloc<uint8_t>(width*height*4);
-    writer->tmpImage = tvg::malloc<uint8_t>(width*height*4);
 
-    fputs("GIF89a", writer->f);
+void gifFrameInit(GifFrame* frame, uint8_t* tmpImage, GifPalette* global, uint32_t width, uint32_t height)
+{
+    frame->image = tvg::malloc<uint8_t>(width * height * 4);
+    frame->tmpImage = tmpImage;
+    frame->global = global;
+    frame->left = frame->top = 0;
+    frame->width = width;
+    frame->height = height;
+    frame->local = false;
+    memset(&frame->pal, 0, sizeof(GifPalette));
+}
 
-    // screen descriptor
-    fputc(width & 0xff, writer->f);
-    fputc((width >> 8) & 0xff, writer->f);
-    fputc(height & 0xff, writer->f);
-    fputc((height >> 8) & 0xff, writer->f);
-
-    fputc(0xf0, writer->f);  // there is an unsorted global color table of 2 entries
-    fputc(0, writer->f);     // background color
-    fputc(0, writer->f);     // pixels are square (we need to specify this because it's 1989)
-
-    // now the "global" palette (really just a dummy palette)
-    // color 0: black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    // color 1: also black
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-    fputc(0, writer->f);
-
-    if(delay != 0) {
-        // animation header
-        fputc(0x21, writer->f); // extension
-        fputc(0xff, writer->f); // application specific
-        fputc(11, writer->f); // length 11
-        fputs("NETSCAPE2.0", writer->f); // yes, really
-        fputc(3, writer->f); // 3 bytes of NETSCAPE2.0 data
 
-        fputc(1, writer->f); // JUST BECAUSE
-        fputc(0, writer->f); // loop infinitely (byte 0)
-        fputc(0, writer->f); // loop infinitely (byte 1)
+void gifFrameFree(GifFrame* frame)
+{
+    tvg::free(frame->image);
+    frame->image = NULL;
+    frame->data.reset();
+}
 
-        fputc(0, writer->f); // block terminator
-    }
 
-    memset(&writer->pal, 0, sizeof(GifPalette));
+void gifQuantize(GifFrame* frame, const GifFrame* prev, const uint8_t* image, uint32_t width, uint32_t height, bool transparent)
+{
+    // the palette is built over the prior one
+    if (prev) memcpy(&frame->pal, &prev->pal, sizeof(GifPalette));
+    else memset(&frame->pal, 0, sizeof(GifPalette));
+
+    const uint8_t* oldImage = prev ? prev->image : NULL;
 
-    return true;
+    _findChangedRegion(frame, oldImage, image, width, height, transparent);
+    _makePalette(frame, oldImage, image, width, transparent);
+    _thresholdImage(frame, oldImage, image, width, height, transparent);
 }
 
 
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
+void gifEncode(GifFrame* frame, uint32_t width, uint32_t height, uint32_t delay, bool transparent)
 {
-    if (!writer->f) return false;
+    _writeLzwImage(frame, width, height, delay, transparent);
+}
+
 
-    const uint8_t* oldImage = writer->firstFrame? NULL : writer->oldImage;
-    writer->firstFrame = false;
+bool gifWriteFrame(GifWriter* writer, const GifFrame* frame)
+{
+    if (!writer->f) return false;
 
-    _makePalette(writer, oldImage, image, width, height, transparent);
-    _thresholdImage(writer, oldImage, image, width, height, transparent);
-    _writeLzwImage(writer, width, height, delay, transparent);
+    if (!writer->started) _writeHeader(writer, frame->global);
 
-    return true;
+    //deliver the encoded frame
+    writer->f->write(frame->data.data, frame->data.count);
+    return writer->f->flush();
 }
 
 
@@ -688,13 +838,11 @@ bool gifEnd(GifWriter* writer)
 {
     if (!writer->f) return false;
 
-    fputc(0x3b, writer->f); // end of file
-    fclose(writer->f);
-    tvg::free(writer->oldImage);
-    tvg::free(writer->tmpImage);
+    if (!writer->started) _writeHeader(writer, NULL);
 
+    writer->f->put(0x3b); // end of file
+    auto ret = writer->f->flush();
     writer->f = NULL;
-    writer->oldImage = NULL;
 
-    return true;
+    return ret;
 }
@@ -25,6 +25,8 @@
 
 #include "tvgCommon.h"
 #include "tvgColor.h"
+#include "tvgArray.h"
+#include "tvgSaveModule.h"
 
 struct GifPalette
 {
@@ -37,27 +39,50 @@ struct GifPalette
     uint8_t treeSplit[256];
 };
 
-struct GifWriter
+// A frame on its way through the encoder
+struct GifFrame
 {
-    FILE* f;
-    uint8_t* oldImage;
-    uint8_t* tmpImage;
+    uint8_t* image;              // the palettized frame, rgb and the palette index in the alpha
+    uint8_t* tmpImage;           // the quantization working buffer, can be shared by the frames quantized in turn
+    GifPalette* global;          // the global palette, made by the first frame and shared by the frames
     GifPalette pal;
-    bool firstFrame;
+    uint32_t left, top;          // the changed region of the frame, only this is encoded
+    uint32_t width, height;
+    bool local;                  // the frame carries its own palette instead of the global one
+    tvg::Array<uint8_t> data;    // the encoded image block
+};
+
+struct GifWriter
+{
+    tvg::SaveStream* f;
+    uint32_t width, height, delay;
+    bool started;                // the header is written out with the first frame
 };
 
-// Creates a gif file.
+// Begins a gif data on the output stream.
 // The input GIFWriter is assumed to be uninitialized.
 // The delay value is the time between frames in hundredths of a second - note that not all viewers pay much attention to this value.
-bool gifBegin(GifWriter* writer, const char* filename, uint32_t width, uint32_t height, uint32_t delay);
+// The header follows with the first frame, since it carries the global palette of it.
+bool gifBegin(GifWriter* writer, tvg::SaveStream* stream, uint32_t width, uint32_t height, uint32_t delay);
+
+// Allocates and releases the frame buffers.
+void gifFrameInit(GifFrame* frame, uint8_t* tmpImage, GifPalette* global, uint32_t width, uint32_t height);
+void gifFrameFree(GifFrame* frame);
+
+// Finds the changed region of the RGBA8 image, picks the palette of it and palettizes it into the frame.
+// Only the pixels changed from the previous frame are counted, pass NULL for the first frame.
+// The global palette is reused if it fits the changed pixels well enough.
+// The previous frame must be quantized before this one.
+void gifQuantize(GifFrame* frame, const GifFrame* prev, const uint8_t* image, uint32_t width, uint32_t height, bool transparent);
+
+// LZW-compresses the changed region of the quantized frame into its image block.
+void gifEncode(GifFrame* frame, uint32_t width, uint32_t height, uint32_t delay, bool transparent);
 
-// Writes out a new frame to a GIF in progress.
+// Writes out the encoded frame to a GIF in progress.
 // The GIFWriter should have been created by GIFBegin.
-// AFAIK, it is legal to use different bit depths for different frames of an image -
-// this may be handy to save bits in animations that don't change much.
-bool gifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width, uint32_t height, uint32_t delay, bool transparent);
+bool gifWriteFrame(GifWriter* writer, const GifFrame* frame);
 
-// Writes the EOF code, closes the file handle, and frees temp memory used by a GIF.
+// Writes the EOF code and flushes the stream.
 // Many if not most viewers will still display a GIF properly if the EOF code is missing,
 // but it's still a good idea to write it out.
 bool gifEnd(GifWriter* writer);
@@ -22,7 +22,6 @@
 
 #include <cstring>
 #include <memory>
-#include "tvgStr.h"
 #include "tvgMath.h"
 #include "tvgGifEncoder.h"
 #include "tvgGifSaver.h"
@@ -31,6 +30,45 @@
 /* Internal Class Implementation                                        */
 /************************************************************************/
 
+#define PIPELINE_DEPTH 3   //frames in flight: rendering, quantizing and encoding
+
+struct GifQuantizeTask : Task
+{
+    GifFrame* frame;
+    const GifFrame* prev;
+    const uint8_t* image;
+    uint32_t w, h;
+    bool transparent;
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        gifQuantize(frame, prev, image, w, h, transparent);
+    }
+};
+
+
+struct GifEncodeTask : Task
+{
+    GifFrame* frame;
+    uint32_t w, h, delay;
+    bool transparent;
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        gifEncode(frame, w, h, delay, transparent);
+    }
+};
+
+
+struct GifSlot
+{
+    uint32_t* buffer;          //the rendered frame
+    GifFrame frame;
+    GifQuantizeTask quantize;
+    GifEncodeTask encode;
+};
+
+
 void GifSaver::run(unsigned tid)
 {
     auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
@@ -54,26 +92,81 @@ void GifSaver::run(unsigned tid)
     auto transparent = bg ? false : true;
 
     GifWriter writer;
-    if (!gifBegin(&writer, path, w, h, uint32_t(delay * 100.f))) {
+    if (!gifBegin(&writer, stream, w, h, uint32_t(delay * 100.f))) {
         TVGERR("GIF_SAVER", "Failed gif encoding");
         return;
     }
 
+    //The frame N renders while N-1 is quantized and N-2 is encoded.
+    //The quantization goes in order since it's based on the previous frame, the encoded frames are written in order.
+    auto tmpImage = tvg::malloc<uint8_t>(w * h * 4);
+    auto global = tvg::malloc<GifPalette>(sizeof(GifPalette));
+    GifSlot slots[PIPELINE_DEPTH];
+    for (auto& slot : slots) {
+        slot.buffer = tvg::malloc<uint32_t>(sizeof(uint32_t) * w * h);
+        gifFrameInit(&slot.frame, tmpImage, global, w, h);
+        slot.quantize.frame = slot.encode.frame = &slot.frame;
+        slot.quantize.image = reinterpret_cast<uint8_t*>(slot.buffer);
+        slot.quantize.w = slot.encode.w = w;
+        slot.quantize.h = slot.encode.h = h;
+        slot.quantize.transparent = slot.encode.transparent = transparent;
+        slot.encode.delay = uint32_t(delay * 100.0f);
+    }
+
+    auto write = [&](GifSlot& slot) {
+        slot.encode.done();
+        return gifWriteFrame(&writer, &slot.frame);
+    };
+
+    auto encode = [&](GifSlot& slot) {
+        slot.quantize.done();
+        TaskScheduler::request(&slot.encode);
+    };
+
     auto duration = animation->duration();
+    auto success = true;
+    uint32_t cnt = 0;
+
+    for (auto p = 0.0f; p < duration; p += delay, ++cnt) {
+        auto& slot = slots[cnt % PIPELINE_DEPTH];
+
+        //the slot is free once its last frame is written out
+        if (cnt >= PIPELINE_DEPTH && !(success = write(slot))) break;
 
-    for (auto p = 0.0f; p < duration; p += delay) {
         auto frameNo = animation->totalFrame() * (p / duration);
         animation->frame(frameNo);
         canvas->update();
         if (canvas->draw(true) == tvg::Result::Success) {
             canvas->sync();
         }
-        if (!gifWriteFrame(&writer, reinterpret_cast<uint8_t*>(buffer), w, h, uint32_t(delay * 100.0f), transparent)) {
-            TVGERR("GIF_SAVER", "Failed gif encoding");
-            break;
+        memcpy(slot.buffer, buffer, sizeof(uint32_t) * w * h);
+
+        GifSlot* prev = cnt > 0 ? &slots[(cnt - 1) % PIPELINE_DEPTH] : nullptr;
+        if (prev) encode(*prev);
+
+        slot.quantize.prev = prev ? &prev->frame : nullptr;
+        TaskScheduler::request(&slot.quantize);
+    }
+
+    //flush the frames in flight
+    if (success && cnt > 0) {
+        encode(slots[(cnt - 1) % PIPELINE_DEPTH]);
+        for (auto i = (cnt > PIPELINE_DEPTH ? cnt - PIPELINE_DEPTH : 0); i < cnt; ++i) {
+            if (!(success = write(slots[i % PIPELINE_DEPTH]))) break;
         }
     }
 
+    if (!success) TVGERR("GIF_SAVER", "Failed gif encoding");
+
+    for (auto& slot : slots) {
+        slot.quantize.done();
+        slot.encode.done();
+        gifFrameFree(&slot.frame);
+        tvg::free(slot.buffer);
+    }
+    tvg::free(tmpImage);
+    tvg::free(global);
+
     if (!gifEnd(&writer)) TVGERR("GIF_SAVER", "Failed gif encoding");
 
     if (bg) {
@@ -104,8 +197,7 @@ bool GifSaver::close()
     if (animation && animation->picture()->refCnt() <= 1) delete(animation);
     animation = nullptr;
 
-    tvg::free(path);
-    path = nullptr;
+    stream = nullptr;
 
     tvg::free(buffer);
     buffer = nullptr;
@@ -114,14 +206,14 @@ bool GifSaver::close()
 }
 
 
-bool GifSaver::save(TVG_UNUSED Paint* paint, TVG_UNUSED Paint* bg, TVG_UNUSED const char* filename, TVG_UNUSED uint32_t quality)
+bool GifSaver::save(TVG_UNUSED Paint* paint, TVG_UNUSED Paint* bg, TVG_UNUSED SaveStream* stream, TVG_UNUSED uint32_t quality)
 {
     TVGLOG("GIF_SAVER", "Paint is not supported.");
     return false;
 }
 
 
-bool GifSaver::save(Animation* animation, Paint* bg, const char* filename, TVG_UNUSED uint32_t quality, uint32_t fps)
+bool GifSaver::save(Animation* animation, Paint* bg, SaveStream* stream, TVG_UNUSED uint32_t quality, uint32_t fps)
 {
     close();
 
@@ -138,8 +230,8 @@ bool GifSaver::save(Animation* animation, Paint* bg, const char* filename, TVG_U
         return false;
     }
 
-    if (!filename) return false;
-    this->path = duplicate(filename);
+    if (!stream) return false;
+    this->stream = stream;
 
     this->animation = animation;
 
@@ -33,15 +33,15 @@ struct GifSaver : SaveModule, Task
 {
     ~GifSaver();
 
-    bool save(Paint* paint, Paint* bg, const char* filename, uint32_t quality) override;
-    bool save(Animation* animation, Paint* bg, const char* filename, uint32_t quality, uint32_t fps) override;
+    bool save(Paint* paint, Paint* bg, SaveStream* stream, uint32_t quality) override;
+    bool save(Animation* animation, Paint* bg, SaveStream* stream, uint32_t quality, uint32_t fps) override;
     bool close() override;
 
 private:
     uint32_t* buffer = nullptr;
     Animation* animation = nullptr;
     Paint* bg = nullptr;
-    char *path = nullptr;
+    SaveStream* stream = nullptr;
     float vsize[2] = {0.0f, 0.0f};
     float fps = 0.0f;
 
@@ -0,0 +1,745 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include "tvgPngEncoder.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define WINDOW_SIZE 32768
+#define WINDOW_MASK (WINDOW_SIZE - 1)
+#define HASH_BITS 15
+#define HASH_SIZE (1 << HASH_BITS)
+#define MIN_MATCH 4                   //the matches are found by 4 bytes hashing, though deflate allows 3
+#define MAX_MATCH 258
+#define BLOCK_TOKENS 16384
+#define STORED_MAX 65535
+#define LITLEN_CODES 286
+#define DIST_CODES 30
+#define CODELEN_CODES 19
+#define END_OF_BLOCK 256
+
+static const uint16_t LEN_BASE[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+static const uint8_t LEN_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+static const uint16_t DIST_BASE[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+static const uint8_t DIST_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+static const uint8_t CODELEN_ORDER[CODELEN_CODES] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+
+//a literal (dist == 0) or a match
+struct Token
+{
+    uint16_t value;
+    uint16_t dist;
+};
+
+
+struct Tables
+{
+    uint32_t crc[256];
+    uint8_t len[MAX_MATCH + 1];     //match length -> length code
+    uint8_t dist[512];              //see _distCode()
+    uint8_t fixedLit[288];          //the fixed huffman code lengths
+    uint8_t fixedDist[DIST_CODES];
+
+    Tables()
+    {
+        for (uint32_t i = 0; i < 256; ++i) {
+            auto c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xedb88320u ^ (c >> 1) : (c >> 1);
+            crc[i] = c;
+        }
+        for (uint8_t code = 0; code < 29; ++code) {
+            for (uint32_t l = LEN_BASE[code]; l < uint32_t(LEN_BASE[code] + (1 << LEN_EXTRA[code])) && l <= MAX_MATCH; ++l) len[l] = code;
+        }
+        len[MAX_MATCH] = 28;   //258 has its own code
+        for (uint8_t code = 0; code < DIST_CODES; ++code) {
+            for (uint32_t d = DIST_BASE[code]; d < uint32_t(DIST_BASE[code] + (1 << DIST_EXTRA[code])); ++d) {
+                dist[(d <= 256) ? (d - 1) : (256 + ((d - 1) >> 7))] = code;
+            }
+        }
+        for (uint32_t i = 0; i < 288; ++i) fixedLit[i] = (i < 144) ? 8 : (i < 256) ? 9 : (i < 280) ? 7 : 8;
+        for (uint32_t i = 0; i < DIST_CODES; ++i) fixedDist[i] = 5;
+    }
+};
+
+
+static const Tables& _tables()
+{
+    static const Tables tables;
+    return tables;
+}
+
+
+static inline uint8_t _distCode(const Tables& tables, uint32_t dist)
+{
+    return tables.dist[(dist <= 256) ? (dist - 1) : (256 + ((dist - 1) >> 7))];
+}
+
+
+//writes the deflate bits from the lsb into the reserved output
+struct BitWriter
+{
+    tvg::Array<uint8_t>* out;
+    uint64_t bits = 0;
+    uint32_t cnt = 0;
+
+    void put(uint32_t value, uint32_t len)
+    {
+        bits |= uint64_t(value) << cnt;
+        cnt += len;
+        while (cnt >= 8) {
+            out->data[out->count++] = uint8_t(bits);
+            bits >>= 8;
+            cnt -= 8;
+        }
+    }
+
+    void align()
+    {
+        if (cnt > 0) put(0, 8 - cnt);
+    }
+};
+
+
+static uint32_t _crc(const Tables& tables, uint32_t crc, const uint8_t* data, uint32_t size)
+{
+    for (uint32_t i = 0; i < size; ++i) crc = tables.crc[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+    return crc;
+}
+
+
+static uint32_t _adler(const uint8_t* data, uint32_t size)
+{
+    uint32_t a = 1, b = 0;
+    while (size > 0) {
+        auto len = std::min(size, 5552u);   //the largest run without the overflow
+        size -= len;
+        while (len-- > 0) {
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+
+//the checksum of the two data in a row, see zlib adler32_combine()
+static uint32_t _adlerCombine(uint32_t adler1, uint32_t adler2, uint32_t len2)
+{
+    const uint32_t BASE = 65521;
+    auto rem = len2 % BASE;
+    auto sum1 = adler1 & 0xffff;
+    auto sum2 = (rem * sum1) % BASE;
+    sum1 += (adler2 & 0xffff) + BASE - 1;
+    sum2 += (adler1 >> 16) + (adler2 >> 16) + BASE - rem;
+    if (sum1 >= BASE) sum1 -= BASE;
+    if (sum1 >= BASE) sum1 -= BASE;
+    if (sum2 >= (BASE << 1)) sum2 -= (BASE << 1);
+    if (sum2 >= BASE) sum2 -= BASE;
+    return sum1 | (sum2 << 16);
+}
+
+
+//builds the huffman code lengths of the symbols, limited to the given bits
+static void _huffman(const uint32_t* freq, uint32_t n, uint8_t* lens, uint32_t limit)
+{
+    uint32_t weight[LITLEN_CODES];
+    uint16_t leaves[LITLEN_CODES];
+    uint32_t nodes[LITLEN_CODES * 2];
+    uint16_t parent[LITLEN_CODES * 2];
+    uint8_t depth[LITLEN_CODES * 2];
+
+    memcpy(weight, freq, sizeof(uint32_t) * n);
+
+    while (true) {
+        uint32_t cnt = 0;
+        for (uint32_t i = 0; i < n; ++i) {
+            lens[i] = 0;
+            if (weight[i] > 0) leaves[cnt++] = i;
+        }
+        if (cnt == 0) return;
+        if (cnt == 1) {
+            lens[leaves[0]] = 1;
+            return;
+        }
+
+        std::sort(leaves, leaves + cnt, [&](uint16_t a, uint16_t b) {
+            return (weight[a] != weight[b]) ? (weight[a] < weight[b]) : (a < b);
+        });
+        for (uint32_t i = 0; i < cnt; ++i) nodes[i] = weight[leaves[i]];
+
+        //the leaves and the merged nodes are both in the ascending order, merge the two lightest in turn
+        uint32_t leaf = 0, inner = cnt, next = cnt;
+        auto pick = [&]() {
+            if (leaf < cnt && (inner >= next || nodes[leaf] <= nodes[inner])) return leaf++;
+            return inner++;
+        };
+        while (next < cnt * 2 - 1) {
+            auto a = pick();
+            auto b = pick();
+            nodes[next] = nodes[a] + nodes[b];
+            parent[a] = parent[b] = next;
+            ++next;
+        }
+
+        //the parents always come after the children
+        uint32_t maxDepth = 0;
+        depth[cnt * 2 - 2] = 0;
+        for (int32_t i = cnt * 2 - 3; i >= 0; --i) {
+            depth[i] = depth[parent[i]] + 1;
+            if (depth[i] > maxDepth) maxDepth = depth[i];
+        }
+
+        if (maxDepth <= limit) {
+            for (uint32_t i = 0; i < cnt; ++i) lens[leaves[i]] = depth[i];
+            return;
+        }
+
+        //flatten the distribution until it fits
+        for (uint32_t i = 0; i < n; ++i) {
+            if (weight[i] > 0) weight[i] = (weight[i] >> 1) | 1;
+        }
+    }
+}
+
+
+//the canonical codes, bit reversed for the lsb first output
+static void _canonical(const uint8_t* lens, uint32_t n, uint16_t* codes)
+{
+    uint16_t count[16] = {0};
+    uint16_t next[16];
+
+    for (uint32_t i = 0; i < n; ++i) ++count[lens[i]];
+    count[0] = 0;
+
+    uint16_t code = 0;
+    for (uint32_t bits = 1; bits < 16; ++bits) {
+        code = (code + count[bits - 1]) << 1;
+        next[bits] = code;
+    }
+
+    for (uint32_t i = 0; i < n; ++i) {
+        if (lens[i] == 0) continue;
+        auto c = next[lens[i]]++;
+        uint16_t r = 0;
+        for (uint32_t b = 0; b < lens[i]; ++b) {
+            r = (r << 1) | (c & 1);
+            c >>= 1;
+        }
+        codes[i] = r;
+    }
+}
+
+
+//at least two codes for the decoders which don't accept an incomplete tree
+static void _complete(uint32_t* freq, uint32_t n)
+{
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (freq[i] > 0) ++used;
+    }
+    for (uint32_t i = 0; i < n && used < 2; ++i) {
+        if (freq[i] == 0) {
+            freq[i] = 1;
+            ++used;
+        }
+    }
+}
+
+
+static uint64_t _cost(const Tables& tables, const Token* tokens, uint32_t cnt, const uint8_t* litLens, const uint8_t* distLens)
+{
+    uint64_t bits = litLens[END_OF_BLOCK];
+    for (auto t = tokens; t < tokens + cnt; ++t) {
+        if (t->dist == 0) bits += litLens[t->value];
+        else {
+            auto lc = tables.len[t->value];
+            auto dc = _distCode(tables, t->dist);
+            bits += litLens[257 + lc] + LEN_EXTRA[lc] + distLens[dc] + DIST_EXTRA[dc];
+        }
+    }
+    return bits;
+}
+
+
+static void _writeTokens(BitWriter& bw, const Tables& tables, const Token* tokens, uint32_t cnt, const uint8_t* litLens, const uint16_t* litCodes, const uint8_t* distLens, const uint16_t* distCodes)
+{
+    for (auto t = tokens; t < tokens + cnt; ++t) {
+        if (t->dist == 0) {
+            bw.put(litCodes[t->value], litLens[t->value]);
+        } else {
+            auto lc = tables.len[t->value];
+            bw.put(litCodes[257 + lc], litLens[257 + lc]);
+            if (LEN_EXTRA[lc] > 0) bw.put(t->value - LEN_BASE[lc], LEN_EXTRA[lc]);
+            auto dc = _distCode(tables, t->dist);
+            bw.put(distCodes[dc], distLens[dc]);
+            if (DIST_EXTRA[dc] > 0) bw.put(t->dist - DIST_BASE[dc], DIST_EXTRA[dc]);
+        }
+    }
+    bw.put(litCodes[END_OF_BLOCK], litLens[END_OF_BLOCK]);
+}
+
+
+//writes a block with the cheapest of the dynamic, fixed or stored encodings
+static void _writeBlock(BitWriter& bw, const Tables& tables, const Token* tokens, uint32_t cnt, const uint8_t* raw, uint32_t rawLen, bool final)
+{
+    uint32_t litFreq[LITLEN_CODES] = {0};
+    uint32_t distFreq[DIST_CODES] = {0};
+
+    for (auto t = tokens; t < tokens + cnt; ++t) {
+        if (t->dist == 0) ++litFreq[t->value];
+        else {
+            ++litFreq[257 + tables.len[t->value]];
+            ++distFreq[_distCode(tables, t->dist)];
+        }
+    }
+    litFreq[END_OF_BLOCK] = 1;
+    _complete(litFreq, LITLEN_CODES);
+    _complete(distFreq, DIST_CODES);
+
+    uint8_t litLens[LITLEN_CODES], distLens[DIST_CODES];
+    _huffman(litFreq, LITLEN_CODES, litLens, 15);
+    _huffman(distFreq, DIST_CODES, distLens, 15);
+
+    uint32_t hlit = LITLEN_CODES, hdist = DIST_CODES;
+    while (hlit > 257 && litLens[hlit - 1] == 0) --hlit;
+    while (hdist > 1 && distLens[hdist - 1] == 0) --hdist;
+
+    //run length encoded code lengths: the symbol in the lower byte and the repeat count in the upper
+    uint8_t lens[LITLEN_CODES + DIST_CODES];
+    memcpy(lens, litLens, hlit);
+    memcpy(lens + hlit, distLens, hdist);
+    auto total = hlit + hdist;
+
+    uint16_t rle[LITLEN_CODES + DIST_CODES];
+    uint32_t rleCnt = 0;
+    uint32_t clFreq[CODELEN_CODES] = {0};
+    auto emit = [&](uint8_t sym, uint8_t extra) {
+        rle[rleCnt++] = sym | (extra << 8);
+        ++clFreq[sym];
+    };
+
+    for (uint32_t i = 0; i < total;) {
+        auto cur = lens[i];
+        uint32_t run = 1;
+        while (i + run < total && lens[i + run] == cur) ++run;
+        i += run;
+        if (cur == 0) {
+            while (run >= 11) {
+                auto r = std::min(run, 138u);
+                emit(18, r - 11);
+                run -= r;
+            }
+            if (run >= 3) {
+                emit(17, run - 3);
+                run = 0;
+            }
+        } else {
+            emit(cur, 0);
+            --run;
+            while (run >= 3) {
+                auto r = std::min(run, 6u);
+                emit(16, r - 3);
+                run -= r;
+            }
+        }
+        while (run-- > 0) emit(cur, 0);
+    }
+
+    uint8_t clLens[CODELEN_CODES];
+    _huffman(clFreq, CODELEN_CODES, clLens, 7);
+    uint32_t hclen = CODELEN_CODES;
+    while (hclen > 4 && clLens[CODELEN_ORDER[hclen - 1]] == 0) --hclen;
+
+    //compare the encoded sizes in bits
+    uint64_t dynamicBits = 3 + 14 + hclen * 3 + _cost(tables, tokens, cnt, litLens, distLens);
+    for (uint32_t i = 0; i < rleCnt; ++i) {
+        auto sym = rle[i] & 0xff;
+        dynamicBits += clLens[sym] + ((sym == 16) ? 2 : (sym == 17) ? 3 : (sym == 18) ? 7 : 0);
+    }
+    auto fixedBits = 3 + _cost(tables, tokens, cnt, tables.fixedLit, tables.fixedDist);
+    auto storedBits = uint64_t(rawLen / STORED_MAX + 1) * 40 + 7 + uint64_t(rawLen) * 8;
+
+    if (storedBits < dynamicBits && storedBits < fixedBits) {
+        do {
+            auto len = std::min(rawLen, uint32_t(STORED_MAX));
+            rawLen -= len;
+            bw.put((final && rawLen == 0) ? 1 : 0, 3);
+            bw.align();
+            bw.put(len, 16);
+            bw.put(~len & 0xffff, 16);
+            memcpy(bw.out->data + bw.out->count, raw, len);
+            bw.out->count += len;
+            raw += len;
+        } while (rawLen > 0);
+    } else if (fixedBits <= dynamicBits) {
+        uint16_t litCodes[288], distCodes[DIST_CODES];
+        _canonical(tables.fixedLit, 288, litCodes);
+        _canonical(tables.fixedDist, DIST_CODES, distCodes);
+        bw.put(final ? 3 : 2, 3);
+        _writeTokens(bw, tables, tokens, cnt, tables.fixedLit, litCodes, tables.fixedDist, distCodes);
+    } else {
+        uint16_t litCodes[LITLEN_CODES], distCodes[DIST_CODES], clCodes[CODELEN_CODES];
+        _canonical(litLens, LITLEN_CODES, litCodes);
+        _canonical(distLens, DIST_CODES, distCodes);
+        _canonical(clLens, CODELEN_CODES, clCodes);
+        bw.put(final ? 5 : 4, 3);
+        bw.put(hlit - 257, 5);
+        bw.put(hdist - 1, 5);
+        bw.put(hclen - 4, 4);
+        for (uint32_t i = 0; i < hclen; ++i) bw.put(clLens[CODELEN_ORDER[i]], 3);
+        for (uint32_t i = 0; i < rleCnt; ++i) {
+            auto sym = rle[i] & 0xff;
+            auto extra = rle[i] >> 8;
+            bw.put(clCodes[sym], clLens[sym]);
+            if (sym == 16) bw.put(extra, 2);
+            else if (sym == 17) bw.put(extra, 3);
+            else if (sym == 18) bw.put(extra, 7);
+        }
+        _writeTokens(bw, tables, tokens, cnt, litLens, litCodes, distLens, distCodes);
+    }
+}
+
+
+static inline uint32_t _hash(const uint8_t* p)
+{
+    uint32_t v;
+    memcpy(&v, p, 4);
+    return (v * 2654435761u) >> (32 - HASH_BITS);
+}
+
+
+//greedy lz77 over the hash chains, the band is a part of the zlib stream
+static void _deflate(PngBand* band)
+{
+    auto& tables = _tables();
+    auto src = band->rows.data;
+    auto size = band->rows.count;
+
+    if (!band->head) {
+        band->head = tvg::malloc<int32_t>(sizeof(int32_t) * HASH_SIZE);
+        band->prev = tvg::malloc<int32_t>(sizeof(int32_t) * WINDOW_SIZE);
+    }
+    auto head = band->head;
+    auto prev = band->prev;
+    for (uint32_t i = 0; i < HASH_SIZE; ++i) head[i] = -1;
+
+    auto insert = [&](uint32_t pos) {
+        auto h = _hash(src + pos);
+        auto cand = head[h];
+        prev[pos & WINDOW_MASK] = cand;
+        head[h] = pos;
+        return cand;
+    };
+
+    //the stored encoding is the worst case of a block
+    band->data.clear();
+    band->data.reserve(size + (size / STORED_MAX + size / BLOCK_TOKENS + 2) * 6 + 64);
+
+    BitWriter bw;
+    bw.out = &band->data;
+
+    Token* tokens = tvg::malloc<Token>(sizeof(Token) * BLOCK_TOKENS);
+    uint32_t cnt = 0;
+    uint32_t blockStart = 0;
+
+    uint32_t i = 0;
+    while (i < size) {
+        uint32_t bestLen = 0, bestDist = 0;
+        if (i + MIN_MATCH <= size) {
+            auto cand = insert(i);
+            auto maxLen = std::min(uint32_t(MAX_MATCH), size - i);
+            auto chain = band->effort;
+            while (cand >= 0 && i - cand <= WINDOW_SIZE && chain-- > 0) {
+                auto a = src + cand;
+                auto b = src + i;
+                if (a[bestLen] == b[bestLen]) {
+                    uint32_t len = 0;
+                    while (len + 8 <= maxLen) {
+                        uint64_t va, vb;
+                        memcpy(&va, a + len, 8);
+                        memcpy(&vb, b + len, 8);
+                        if (va != vb) break;
+                        len += 8;
+                    }
+                    while (len < maxLen && a[len] == b[len]) ++len;
+                    if (len > bestLen) {
+                        bestLen = len;
+                        bestDist = i - cand;
+                        if (len == maxLen) break;
+                    }
+                }
+                auto next = prev[cand & WINDOW_MASK];
+                if (next >= cand) break;   //the slot is taken by a newer position
+                cand = next;
+            }
+        }
+
+        if (bestLen >= MIN_MATCH) {
+            tokens[cnt++] = {uint16_t(bestLen), uint16_t(bestDist)};
+            for (uint32_t j = i + 1; j < i + bestLen && j + MIN_MATCH <= size; ++j) insert(j);
+            i += bestLen;
+        } else {
+            tokens[cnt++] = {src[i], 0};
+            ++i;
+        }
+
+        if (cnt == BLOCK_TOKENS) {
+            _writeBlock(bw, tables, tokens, cnt, src + blockStart, i - blockStart, band->last && i == size);
+            cnt = 0;
+            blockStart = i;
+        }
+    }
+
+    if (cnt > 0) _writeBlock(bw, tables, tokens, cnt, src + blockStart, i - blockStart, band->last);
+
+    //byte align with an empty stored block so that the next band can follow
+    if (!band->last) {
+        bw.put(0, 3);
+        bw.align();
+        bw.put(0, 16);
+        bw.put(0xffff, 16);
+    }
+    bw.align();
+
+    tvg::free(tokens);
+}
+
+
+static inline uint8_t _paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+    int32_t pa = abs(int32_t(b) - c);
+    int32_t pb = abs(int32_t(a) - c);
+    int32_t pc = abs(int32_t(a) + b - 2 * c);
+    return (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+}
+
+
+static inline uint32_t _cost(const uint8_t* row, uint32_t len)
+{
+    uint32_t sum = 0;
+    for (uint32_t x = 0; x < len; ++x) sum += uint32_t(abs(int8_t(row[x])));
+    return sum;
+}
+
+
+//tries out the filters and picks the one of the minimum sum of the absolute differences
+//the loops are kept simple so that they are vectorized
+static void _filter(uint8_t* out, const uint8_t* cur, const uint8_t* prev, uint32_t len, uint32_t bpp, uint8_t* scratch)
+{
+    uint8_t* rows[5] = {const_cast<uint8_t*>(cur), scratch, scratch + len, scratch + len * 2, scratch + len * 3};
+    auto sub = rows[1], up = rows[2], avg = rows[3], paeth = rows[4];
+
+    for (uint32_t x = 0; x < bpp; ++x) {
+        sub[x] = cur[x];
+        avg[x] = cur[x] - (prev[x] >> 1);
+        paeth[x] = cur[x] - prev[x];
+    }
+    for (uint32_t x = bpp; x < len; ++x) sub[x] = cur[x] - cur[x - bpp];
+    for (uint32_t x = 0; x < len; ++x) up[x] = cur[x] - prev[x];
+    for (uint32_t x = bpp; x < len; ++x) avg[x] = cur[x] - uint8_t((cur[x - bpp] + prev[x]) >> 1);
+    for (uint32_t x = bpp; x < len; ++x) paeth[x] = cur[x] - _paeth(cur[x - bpp], prev[x], prev[x - bpp]);
+
+    uint8_t type = 0;
+    auto best = _cost(cur, len);
+    for (uint8_t t = 1; t < 5; ++t) {
+        auto sum = _cost(rows[t], len);
+        if (sum < best) {
+            best = sum;
+            type = t;
+        }
+    }
+
+    out[0] = type;
+    memcpy(out + 1, rows[type], len);
+}
+
+
+//the row bytes in the png order, the ABGR8888S pixels are RGBA in the memory
+static const uint8_t* _row(const PngBand* band, uint32_t y, uint8_t* buffer)
+{
+    auto src = reinterpret_cast<const uint8_t*>(band->image + y * band->width);
+    if (band->channels == 4) return src;
+    for (uint32_t x = 0; x < band->width; ++x, src += 4, buffer += 3) {
+        buffer[0] = src[0];
+        buffer[1] = src[1];
+        buffer[2] = src[2];
+    }
+    return buffer - band->width * 3;
+}
+
+
+static void _chunkBegin(PngWriter* writer, const char* type, uint32_t len)
+{
+    uint8_t header[8] = {uint8_t(len >> 24), uint8_t(len >> 16), uint8_t(len >> 8), uint8_t(len), uint8_t(type[0]), uint8_t(type[1]), uint8_t(type[2]), uint8_t(type[3])};
+    writer->f->write(header, 8);
+    writer->crc = _crc(_tables(), 0xffffffff, header + 4, 4);
+}
+
+
+static void _chunkWrite(PngWriter* writer, const uint8_t* data, uint32_t len)
+{
+    writer->f->write(data, len);
+    writer->crc = _crc(_tables(), writer->crc, data, len);
+}
+
+
+static void _chunkWrite32(PngWriter* writer, uint32_t value)
+{
+    uint8_t data[4] = {uint8_t(value >> 24), uint8_t(value >> 16), uint8_t(value >> 8), uint8_t(value)};
+    _chunkWrite(writer, data, 4);
+}
+
+
+static void _chunkEnd(PngWriter* writer)
+{
+    auto crc = ~writer->crc;
+    uint8_t data[4] = {uint8_t(crc >> 24), uint8_t(crc >> 16), uint8_t(crc >> 8), uint8_t(crc)};
+    writer->f->write(data, 4);
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+bool pngBegin(PngWriter* writer, tvg::SaveStream* stream, uint32_t width, uint32_t height, uint8_t channels, uint32_t frames)
+{
+    writer->f = stream;
+    writer->width = width;
+    writer->height = height;
+    writer->frames = frames;
+    writer->frameNo = 0;
+    writer->seq = 0;
+
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    stream->write(signature, 8);
+
+    _chunkBegin(writer, "IHDR", 13);
+    _chunkWrite32(writer, width);
+    _chunkWrite32(writer, height);
+    uint8_t format[5] = {8, uint8_t(channels == 4 ? 6 : 2), 0, 0, 0};  //8 bits truecolor, deflate, adaptive filtering, no interlace
+    _chunkWrite(writer, format, 5);
+    _chunkEnd(writer);
+
+    if (frames > 0) {
+        _chunkBegin(writer, "acTL", 8);
+        _chunkWrite32(writer, frames);
+        _chunkWrite32(writer, 0);   //loop infinitely
+        _chunkEnd(writer);
+    }
+
+    return stream->flush();
+}
+
+
+void pngEncode(PngBand* band)
+{
+    auto len = band->width * band->channels;
+    band->rows.clear();
+    band->rows.reserve((len + 1) * band->h);
+
+    uint8_t* buffer = tvg::calloc<uint8_t>(len * 7, 1);
+    auto zero = buffer;     //the row above the frame
+    uint8_t* cur = buffer + len;
+    uint8_t* above = buffer + len * 2;
+    uint8_t* scratch = buffer + len * 3;
+
+    auto prev = (band->y > 0) ? _row(band, band->y - 1, above) : zero;
+    auto out = band->rows.data;
+    for (auto y = band->y; y < band->y + band->h; ++y, out += len + 1) {
+        auto row = _row(band, y, cur);
+        _filter(out, row, prev, len, band->channels, scratch);
+        prev = row;
+        std::swap(cur, above);
+    }
+    band->rows.count = (len + 1) * band->h;
+
+    tvg::free(buffer);
+
+    band->adler = _adler(band->rows.data, band->rows.count);
+    _deflate(band);
+}
+
+
+void pngBandFree(PngBand* band)
+{
+    band->rows.reset();
+    band->data.reset();
+    tvg::free(band->head);
+    tvg::free(band->prev);
+    band->head = band->prev = nullptr;
+}
+
+
+bool pngWriteFrame(PngWriter* writer, const PngBand* bands, uint32_t count, uint16_t delayNum, uint16_t delayDen)
+{
+    if (writer->frames > 0) {
+        _chunkBegin(writer, "fcTL", 26);
+        _chunkWrite32(writer, writer->seq++);
+        _chunkWrite32(writer, writer->width);
+        _chunkWrite32(writer, writer->height);
+        _chunkWrite32(writer, 0);
+        _chunkWrite32(writer, 0);
+        uint8_t control[6] = {uint8_t(delayNum >> 8), uint8_t(delayNum), uint8_t(delayDen >> 8), uint8_t(delayDen), 0, 0};  //dispose none, blend source
+        _chunkWrite(writer, control, 6);
+        _chunkEnd(writer);
+    }
+
+    //the first frame is the default image of the apng as well
+    auto fdAT = writer->frameNo > 0;
+    uint32_t adler = 1;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        auto& band = bands[i];
+        auto len = band.data.count + (i == 0 ? 2 : 0) + (i == count - 1 ? 4 : 0) + (fdAT ? 4 : 0);
+        _chunkBegin(writer, fdAT ? "fdAT" : "IDAT", len);
+        if (fdAT) _chunkWrite32(writer, writer->seq++);
+        if (i == 0) {
+            uint8_t header[2] = {0x78, 0x01};
+            _chunkWrite(writer, header, 2);
+        }
+        _chunkWrite(writer, band.data.data, band.data.count);
+        adler = _adlerCombine(adler, band.adler, band.rows.count);
+        if (i == count - 1) _chunkWrite32(writer, adler);
+        _chunkEnd(writer);
+    }
+
+    ++writer->frameNo;
+
+    return writer->f->flush();
+}
+
+
+bool pngEnd(PngWriter* writer)
+{
+    _chunkBegin(writer, "IEND", 0);
+    _chunkEnd(writer);
+    return writer->f->flush();
+}
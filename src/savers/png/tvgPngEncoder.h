@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _TVG_PNG_ENCODER_H_
+#define _TVG_PNG_ENCODER_H_
+
+#include "tvgCommon.h"
+#include "tvgArray.h"
+#include "tvgSaveModule.h"
+
+// A horizontal band of the frame rows, filtered and deflated on its own.
+// The bands of a frame are written in order and make up one zlib stream together.
+struct PngBand
+{
+    const uint32_t* image;           // the frame pixels, ABGR8888S
+    uint32_t width;
+    uint32_t y, h;                   // the rows [y, y + h) of the frame
+    uint8_t channels;                // 3: RGB, 4: RGBA
+    uint8_t effort;                  // the match search depth, the higher the smaller output
+    bool last;                       // the band closes the zlib stream
+
+    tvg::Array<uint8_t> rows;        // the filtered rows
+    tvg::Array<uint8_t> data;        // the deflated rows
+    uint32_t adler;                  // the checksum of the filtered rows
+
+    int32_t* head = nullptr;         // the match finder, kept over the frames
+    int32_t* prev = nullptr;
+};
+
+struct PngWriter
+{
+    tvg::SaveStream* f;
+    uint32_t width, height;
+    uint32_t frames;                 // 0 for a still image
+    uint32_t frameNo;
+    uint32_t seq;                    // the apng chunk sequence
+    uint32_t crc;
+};
+
+// Writes the png signature and the header. An animated png (APNG) of the given frames is written if frames > 0.
+bool pngBegin(PngWriter* writer, tvg::SaveStream* stream, uint32_t width, uint32_t height, uint8_t channels, uint32_t frames);
+
+// Filters and deflates the band rows, safe to run in parallel for the different bands.
+void pngEncode(PngBand* band);
+
+// Releases the band buffers.
+void pngBandFree(PngBand* band);
+
+// Writes out the encoded bands of a frame in order. The delay is the frame duration, delayNum / delayDen seconds.
+bool pngWriteFrame(PngWriter* writer, const PngBand* bands, uint32_t count, uint16_t delayNum, uint16_t delayDen);
+
+// Writes the trailer and flushes the stream.
+bool pngEnd(PngWriter* writer);
+
+#endif  //_TVG_PNG_ENCODER_H_
@@ -0,0 +1,270 @@
+/*
+ * Copyright (c) 2026 ThorVG project. All rights reserved.
+
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include "tvgMath.h"
+#include "tvgPngEncoder.h"
+#include "tvgPngSaver.h"
+
+/************************************************************************/
+/* Internal Class Implementation                                        */
+/************************************************************************/
+
+#define PIPELINE_DEPTH 2   //frames in flight: rendering and encoding
+#define MIN_BAND_ROWS 32   //not worth splitting the rows further
+
+struct PngBandTask : Task
+{
+    PngBand* band;
+
+    void run(TVG_UNUSED unsigned tid) override
+    {
+        pngEncode(band);
+    }
+};
+
+
+struct PngSlot
+{
+    uint32_t* buffer;      //the rendered frame
+    PngBand* bands;
+    PngBandTask* tasks;
+};
+
+
+static bool _opaque(const uint32_t* buffer, uint32_t size)
+{
+    for (auto p = buffer; p < buffer + size; ++p) {
+        if ((*p >> 24) != 0xff) return false;
+    }
+    return true;
+}
+
+
+static bool _viewport(Paint* paint, float* vsize)
+{
+    auto x = 0.0f, y = 0.0f;
+    paint->bounds(&x, &y, &vsize[0], &vsize[1]);
+
+    //cut off the negative space
+    if (x < 0) vsize[0] += x;
+    if (y < 0) vsize[1] += y;
+
+    if (vsize[0] < FLOAT_EPSILON || vsize[1] < FLOAT_EPSILON) {
+        TVGLOG("PNG_SAVER", "Saving paint(%p) has zero view size.", paint);
+        return false;
+    }
+    return true;
+}
+
+
+void PngSaver::run(TVG_UNUSED unsigned tid)
+{
+    auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+    if (!canvas) return;
+
+    auto w = static_cast<uint32_t>(vsize[0]);
+    auto h = static_cast<uint32_t>(vsize[1]);
+
+    buffer = tvg::realloc<uint32_t>(buffer, sizeof(uint32_t) * w * h);
+    canvas->target(buffer, w, w, h, ColorSpace::ABGR8888S);
+    if (bg) canvas->add(bg);
+    canvas->add(animation ? animation->picture() : paint);
+
+    //a still image, or an apng of the frames at the fps
+    uint32_t frames = 1;
+    auto delay = 0.0f;
+    auto duration = 0.0f;
+
+    if (animation) {
+        //use the default fps
+        if (fps > 60.0f) fps = 60.0f;   // just in case
+        else if (tvg::zero(fps) || fps < 0.0f) {
+            fps = (animation->totalFrame() / animation->duration());
+        }
+        delay = (1.0f / fps);
+        duration = animation->duration();
+        frames = 0;
+        for (auto p = 0.0f; p < duration; p += delay) ++frames;
+    }
+
+    //the rows are split into the bands filtered and deflated on the worker threads
+    auto count = std::min(TaskScheduler::threads() + 1, std::max(h / MIN_BAND_ROWS, 1u));
+    auto rows = (h + count - 1) / count;
+    count = (h + rows - 1) / rows;
+
+    PngSlot slots[PIPELINE_DEPTH];
+    for (auto& slot : slots) {
+        slot.buffer = tvg::malloc<uint32_t>(sizeof(uint32_t) * w * h);
+        slot.bands = new PngBand[count];
+        slot.tasks = new PngBandTask[count];
+        for (uint32_t i = 0; i < count; ++i) {
+            auto& band = slot.bands[i];
+            band.image = slot.buffer;
+            band.width = w;
+            band.y = i * rows;
+            band.h = std::min(rows, h - band.y);
+            band.effort = uint8_t(1 + std::min(quality, 100u) / 25);
+            band.last = (i == count - 1);
+            slot.tasks[i].band = &band;
+        }
+    }
+
+    PngWriter writer;
+    uint8_t channels = 4;
+    auto delayNum = uint16_t(tvg::clamp(nearbyintf(delay * 1000.0f), 0.0f, 65535.0f));
+
+    auto write = [&](PngSlot& slot) {
+        for (uint32_t i = 0; i < count; ++i) slot.tasks[i].done();
+        return pngWriteFrame(&writer, slot.bands, count, delayNum, 1000);
+    };
+
+    auto success = true;
+    uint32_t cnt = 0;
+
+    for (auto p = 0.0f; cnt < frames; p += delay, ++cnt) {
+        auto& slot = slots[cnt % PIPELINE_DEPTH];
+
+        //the slot is free once its last frame is written out
+        if (cnt >= PIPELINE_DEPTH && !(success = write(slot))) break;
+
+        if (animation) animation->frame(animation->totalFrame() * (p / duration));
+        canvas->update();
+        if (canvas->draw(true) == tvg::Result::Success) {
+            canvas->sync();
+        }
+        memcpy(slot.buffer, buffer, sizeof(uint32_t) * w * h);
+
+        if (cnt == 0) {
+            //drop the alpha channel of the opaque image, the frames of an animation may differ though
+            if (!animation && _opaque(slot.buffer, w * h)) channels = 3;
+            if (!(success = pngBegin(&writer, stream, w, h, channels, animation ? frames : 0))) break;
+        }
+
+        for (uint32_t i = 0; i < count; ++i) {
+            slot.bands[i].channels = channels;
+            TaskScheduler::request(&slot.tasks[i]);
+        }
+    }
+
+    //flush the frames in flight
+    if (success) {
+        for (auto i = (cnt > PIPELINE_DEPTH ? cnt - PIPELINE_DEPTH : 0); i < cnt; ++i) {
+            if (!(success = write(slots[i % PIPELINE_DEPTH]))) break;
+        }
+    }
+
+    if (success) success = pngEnd(&writer);
+    if (!success) TVGERR("PNG_SAVER", "Failed png encoding");
+
+    for (auto& slot : slots) {
+        for (uint32_t i = 0; i < count; ++i) {
+            slot.tasks[i].done();
+            pngBandFree(&slot.bands[i]);
+        }
+        delete[] slot.tasks;
+        delete[] slot.bands;
+        tvg::free(slot.buffer);
+    }
+}
+
+
+/************************************************************************/
+/* External Class Implementation                                        */
+/************************************************************************/
+
+PngSaver::~PngSaver()
+{
+    close();
+}
+
+
+bool PngSaver::close()
+{
+    this->done();
+
+    if (bg) bg->unref();
+    bg = nullptr;
+
+    if (paint) paint->unref();
+    paint = nullptr;
+
+    //animation holds the picture, it must be 1 at the bottom.
+    if (animation && animation->picture()->refCnt() <= 1) delete(animation);
+    animation = nullptr;
+
+    stream = nullptr;
+
+    tvg::free(buffer);
+    buffer = nullptr;
+
+    return true;
+}
+
+
+bool PngSaver::save(Paint* paint, Paint* bg, SaveStream* stream, uint32_t quality)
+{
+    close();
+
+    if (!_viewport(paint, vsize)) return false;
+    if (!stream) return false;
+
+    this->stream = stream;
+    this->quality = quality;
+
+    paint->ref();
+    this->paint = paint;
+
+    if (bg) {
+        bg->ref();
+        this->bg = bg;
+    }
+
+    TaskScheduler::request(this);
+
+    return true;
+}
+
+
+bool PngSaver::save(Animation* animation, Paint* bg, SaveStream* stream, uint32_t quality, uint32_t fps)
+{
+    close();
+
+    if (!_viewport(animation->picture(), vsize)) return false;
+    if (!stream) return false;
+
+    this->stream = stream;
+    this->quality = quality;
+    this->animation = animation;
+
+    if (bg) {
+        bg->ref();
+        this->bg = bg;
+    }
+    this->fps = static_cast<float>(fps);
+
+    TaskScheduler::request(this);
+
+    return true;
+}
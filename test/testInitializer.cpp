@@ -24,6 +24,7 @@
 #include "config.h"
 #include "catch.hpp"
 #include <cstring>
+#include <memory>
 
 using namespace tvg;
 
@@ -58,4 +59,130 @@ TEST_CASE("Version", "[tvgInitializer]")
 TEST_CASE("Negative termination", "[tvgInitializer]")
 {
     REQUIRE(Initializer::term() == Result::InsufficientCondition);
-}
\ No newline at end of file
+}
+TEST_CASE("Custom allocator", "[tvgInitializer]")
+{
+    struct Counter
+    {
+        uint32_t allocs = 0;
+        int32_t blocks = 0;
+    } counter;
+
+    Allocator allocator = {
+        [](size_t size, void* user) -> void* {
+            auto p = malloc(size);
+            if (p) ++static_cast<Counter*>(user)->allocs, ++static_cast<Counter*>(user)->blocks;
+            return p;
+        },
+        [](size_t nmem, size_t size, void* user) -> void* {
+            auto p = calloc(nmem, size);
+            if (p) ++static_cast<Counter*>(user)->allocs, ++static_cast<Counter*>(user)->blocks;
+            return p;
+        },
+        [](void* ptr, size_t size, void* user) -> void* {
+            auto p = realloc(ptr, size);
+            if (p) {
+                ++static_cast<Counter*>(user)->allocs;
+                if (!ptr) ++static_cast<Counter*>(user)->blocks;
+            }
+            return p;
+        },
+        [](void* ptr, void* user) {
+            if (ptr) --static_cast<Counter*>(user)->blocks;
+            free(ptr);
+        },
+        &counter
+    };
+
+    //Incomplete callbacks
+    auto invalid = allocator;
+    invalid.realloc = nullptr;
+    REQUIRE(Initializer::init(0, &invalid) == Result::InvalidArguments);
+    REQUIRE(Initializer::term() == Result::InsufficientCondition);
+
+    REQUIRE(Initializer::init(0, &allocator) == Result::Success);
+    {
+        uint32_t buffer[100 * 100];
+        auto canvas = std::unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto fill = LinearGradient::gen();
+        fill->linear(0, 0, 100, 100);
+        Fill::ColorStop stops[2] = {{0, 255, 0, 0, 255}, {1, 0, 0, 255, 255}};
+        fill->colorStops(stops, 2);
+
+        float pattern[] = {5, 3};
+        auto shape = Shape::gen();
+        shape->appendCircle(30, 30, 20, 20);
+        shape->fill(fill);
+        shape->strokeWidth(2);
+        shape->strokeFill(0, 0, 0);
+        shape->strokeDash(pattern, 2);
+        shape->trimpath(0.0f, 0.75f);
+
+        auto clipper = Shape::gen();
+        clipper->appendCircle(50, 50, 40, 40);
+        shape->clip(clipper);
+        REQUIRE(canvas->add(shape) == Result::Success);
+
+        auto draw = [&]() {
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        draw();
+        REQUIRE(counter.allocs > 0);
+
+        //steady state, the transient data reuses the memory of the previous frames
+        shape->translate(20, 20);
+        draw();
+
+        auto allocs = counter.allocs;
+        for (int i = 0; i < 4; ++i) {
+            shape->translate(float(i % 2) * 20, float(i % 2) * 20);
+            draw();
+        }
+        //not to leave the allocator installed on a failure
+        CHECK(counter.allocs == allocs);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+    REQUIRE(counter.blocks == 0);
+
+    //The objects released after the termination return their memory to the same allocator
+    REQUIRE(Initializer::init(0, &allocator) == Result::Success);
+    {
+        uint32_t buffer[100 * 100];
+        auto canvas = std::unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendCircle(50, 50, 40, 40) == Result::Success);
+        REQUIRE(shape->fill(255, 0, 0) == Result::Success);
+        REQUIRE(canvas->add(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto orphan = Shape::gen();
+        REQUIRE(orphan->appendCircle(50, 50, 40, 40) == Result::Success);
+
+        //the canvas is alive, the engine can't be terminated completely
+        REQUIRE(Initializer::term() == Result::InsufficientCondition);
+        canvas.reset();
+        REQUIRE(Initializer::init(0, &allocator) == Result::Success);
+        REQUIRE(Initializer::term() == Result::Success);
+
+        REQUIRE(counter.blocks > 0);
+        Paint::rel(orphan);
+    }
+    REQUIRE(counter.blocks == 0);
+
+    //back to the system allocator
+    auto allocs = counter.allocs;
+    REQUIRE(Initializer::init() == Result::Success);
+    auto shape = Shape::gen();
+    REQUIRE(shape->appendRect(0, 0, 10, 10) == Result::Success);
+    Paint::rel(shape);
+    REQUIRE(Initializer::term() == Result::Success);
+    REQUIRE(counter.allocs == allocs);
+}
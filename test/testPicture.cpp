@@ -23,12 +23,119 @@
 #include <thorvg.h>
 #include <fstream>
 #include <cstring>
+#include <string>
+#include <set>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
 
 using namespace tvg;
 using namespace std;
 
+#if defined(THORVG_PNG_LOADER_SUPPORT) || defined(THORVG_JPG_LOADER_SUPPORT) || defined(THORVG_WEBP_LOADER_SUPPORT)
+
+//pan a 4160x4160 black and white checker board of 64x64 cells, only the visible area is decoded
+static void _loadHuge(const char* path)
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        static uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(path) == Result::Success);
+        float w, h;
+        REQUIRE(picture->size(&w, &h) == Result::Success);
+        REQUIRE(w == 4160.0f);
+        REQUIRE(h == 4160.0f);
+        REQUIRE(canvas->add(picture) == Result::Success);
+
+        //across the tiles, back to the skipped rows and down to the last ones
+        int views[][2] = {{2000, 3000}, {1000, 30}, {4060, 4060}};
+        for (auto& view : views) {
+            REQUIRE(picture->translate(-float(view[0]), -float(view[1])) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto matched = true;
+            for (int y = 0; y < 100; ++y) {
+                for (int x = 0; x < 100; ++x) {
+                    auto white = (((x + view[0]) >> 6) + ((y + view[1]) >> 6)) & 1;
+                    if (buffer[y * 100 + x] != (white ? 0xffffffff : 0xff000000)) matched = false;
+                }
+            }
+            REQUIRE(matched);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#if defined(THORVG_JPG_LOADER_SUPPORT) || defined(THORVG_WEBP_LOADER_SUPPORT)
+
+//the copied source data is released after decoding unless the image memory budget may evict the decoded pixels
+static void _keepSource(const char* path, const char* mimeType, uint32_t budget)
+{
+    ifstream file(path, ios::in | ios::binary | ios::ate);
+    REQUIRE(file.is_open());
+    auto size = (uint32_t)file.tellg();
+    auto data = (char*)malloc(size);
+    file.seekg(0);
+    file.read(data, size);
+    file.close();
+
+    struct Source
+    {
+        size_t size;
+        void* copied = nullptr;
+        bool released = false;
+    } source = {size};
+
+    Allocator allocator = {
+        [](size_t size, void* user) -> void* {
+            auto p = malloc(size);
+            if (size == static_cast<Source*>(user)->size) static_cast<Source*>(user)->copied = p;
+            return p;
+        },
+        [](size_t nmem, size_t size, void* user) -> void* { return calloc(nmem, size); },
+        [](void* ptr, size_t size, void* user) -> void* { return realloc(ptr, size); },
+        [](void* ptr, void* user) {
+            if (ptr && ptr == static_cast<Source*>(user)->copied) static_cast<Source*>(user)->released = true;
+            free(ptr);
+        },
+        &source
+    };
+
+    REQUIRE(Initializer::init(0, &allocator) == Result::Success);
+    REQUIRE(Initializer::budget(budget) == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        static uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(data, size, mimeType, "", true) == Result::Success);
+        REQUIRE(source.copied);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(source.released == (budget == 0));
+    }
+    REQUIRE(Initializer::budget(0) == Result::Success);
+    REQUIRE(Initializer::term() == Result::Success);
+    REQUIRE(source.released);
+
+    free(data);
+}
+
+#endif
+
 
 TEST_CASE("Picture Creation", "[tvgPicture]")
 {
@@ -249,6 +356,78 @@ TEST_CASE("Load SVG Data", "[tvgPicture]")
     Paint::rel(picture);
 }
 
+TEST_CASE("Load SVG Data with references", "[tvgPicture]")
+{
+    static const char* svg = "<svg viewBox=\"0 0 100 100\" xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\"><style>.red{fill:red}</style><defs><linearGradient id=\"grad\"><stop offset=\"0\" stop-color=\"#f00\"/><stop offset=\"1\" stop-color=\"#00f\"/></linearGradient><linearGradient id=\"grad2\" xlink:href=\"#grad\"/><circle id=\"dot\" cx=\"10\" cy=\"10\" r=\"5\"/></defs><rect id=\"box\" class=\"red\" width=\"50\" height=\"50\" fill=\"url(#grad2)\"/><use id=\"dot2\" href=\" #dot \" x=\"20\"/><use xlink:href=\"#later\"/><path id=\"a&amp;b\" d=\"M0 0L10 10\" stroke=\"#000\"/><text id=\"txt\" font-size=\"10\">a<tspan id=\"span\" fill=\"red\">b</tspan></text><g id=\"later\"><rect width=\"1\" height=\"1\"/></g></svg>";
+
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //the copied data is tokenized in place, the borrowed one is left untouched
+        for (auto copy : {true, false}) {
+            auto picture = Picture::gen();
+            REQUIRE(picture);
+            picture->accessible = true;
+
+            REQUIRE(picture->load(svg, strlen(svg), "svg", nullptr, copy) == Result::Success);
+
+            REQUIRE(picture->paint(Accessor::id("box")));
+            REQUIRE(picture->paint(Accessor::id("dot2")));
+            REQUIRE(picture->paint(Accessor::id("a&b")));
+            REQUIRE(picture->paint(Accessor::id("later")));
+
+            Paint::rel(picture);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load SVG Data with many children", "[tvgPicture]")
+{
+    //a few children share a clip path, the duplicated id must resolve to the first one
+    std::string svg = "<svg viewBox=\"0 0 1000 1000\" xmlns=\"http://www.w3.org/2000/svg\"><clipPath id=\"clip\"><rect width=\"500\" height=\"500\"/></clipPath>";
+    for (int i = 0; i < 300; ++i) {
+        auto id = (i == 7 || i == 250) ? std::string("dup") : "r" + std::to_string(i);
+        svg += "<rect id=\"" + id + "\" x=\"" + std::to_string(i) + "\" width=\"" + std::to_string(i + 1) + "\" height=\"10\"";
+        if (i % 10 == 0) svg += " clip-path=\"url(#clip)\"";
+        svg += "/>";
+    }
+    svg += "</svg>";
+
+    auto collect = [](const Paint* paint, void* data) -> bool
+    {
+        static_cast<std::string*>(data)->append(std::to_string(paint->id) + ",");
+        return true;
+    };
+
+    std::string order[2];
+    for (auto threads : {0, 2}) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto picture = Picture::gen();
+            REQUIRE(picture);
+            picture->accessible = true;
+
+            REQUIRE(picture->load(svg.c_str(), svg.size(), "svg", nullptr, true) == Result::Success);
+
+            REQUIRE(picture->paint(Accessor::id("r0")));
+            REQUIRE(picture->paint(Accessor::id("r299")));
+
+            auto dup = const_cast<Paint*>(picture->paint(Accessor::id("dup")));
+            REQUIRE(dup);
+            float x, y, w, h;
+            REQUIRE(dup->bounds(&x, &y, &w, &h) == Result::Success);
+            REQUIRE(w == Approx(8.0f).margin(0.000001));
+
+            auto accessor = unique_ptr<Accessor>(Accessor::gen());
+            REQUIRE(accessor->set(picture, collect, &order[threads ? 1 : 0]) == Result::Success);
+
+            Paint::rel(picture);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+    REQUIRE(order[0] == order[1]);
+}
+
 #endif
 
 #ifdef THORVG_PNG_LOADER_SUPPORT
@@ -270,6 +449,16 @@ TEST_CASE("Load PNG file from path", "[tvgPicture]")
     REQUIRE(h == 512);
 
     Paint::rel(picture);
+
+    //The size requested prior to the loading is replaced by the image size
+    picture = Picture::gen();
+    REQUIRE(picture->size(128, 128) == Result::Success);
+    REQUIRE(picture->load(TEST_DIR"/test.png") == Result::Success);
+    REQUIRE(picture->size(&w, &h) == Result::Success);
+    REQUIRE(w == 512);
+    REQUIRE(h == 512);
+
+    Paint::rel(picture);
 }
 
 TEST_CASE("Load PNG file from data", "[tvgPicture]")
@@ -320,6 +509,210 @@ TEST_CASE("Load PNG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Load PNG file in the canvas colorspace", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        //Decoded in the ARGB order
+        static uint32_t buffer1[128*128];
+        REQUIRE(canvas->target(buffer1, 128, 128, 128, ColorSpace::ARGB8888) == Result::Success);
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(TEST_DIR"/test.png") == Result::Success);
+        REQUIRE(picture->size(128, 128) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(canvas->remove() == Result::Success);
+
+        //Decoded in the ABGR order, a copied data not to share the decoded image above
+        static uint32_t buffer2[128*128];
+        REQUIRE(canvas->target(buffer2, 128, 128, 128, ColorSpace::ABGR8888) == Result::Success);
+
+        ifstream file(TEST_DIR"/test.png", ios::in | ios::binary | ios::ate);
+        REQUIRE(file.is_open());
+        auto size = (uint32_t)file.tellg();
+        auto data = (char*)malloc(size);
+        file.seekg(0);
+        file.read(data, size);
+        file.close();
+
+        picture = Picture::gen();
+        REQUIRE(picture->load(data, size, "png", "", true) == Result::Success);
+        free(data);
+        REQUIRE(picture->size(128, 128) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //Same pixels in the swapped channel order
+        auto matched = true;
+        for (int i = 0; i < 128 * 128; ++i) {
+            auto swapped = (buffer2[i] & 0xff00ff00) | ((buffer2[i] & 0xff) << 16) | ((buffer2[i] >> 16) & 0xff);
+            if (buffer1[i] != swapped) matched = false;
+        }
+        REQUIRE(matched);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load PNG file with the scanline filters", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        //160x120 rgb(a) images, compressed with the dynamic huffman codes, filtered by (row % 5) types
+        const uint32_t w = 160, h = 120;
+        static uint32_t buffer1[w * h];
+        static uint32_t buffer2[w * h];
+        static uint32_t pixels[w * h];
+
+        for (auto alpha : {false, true}) {
+            for (uint32_t y = 0; y < h; ++y) {
+                for (uint32_t x = 0; x < w; ++x) {
+                    auto hash = (x >> 3) * 73856093u ^ (y >> 3) * 19349663u;
+                    auto a = (!alpha || (((x >> 4) + (y >> 4)) & 1)) ? 255u : (hash >> 16) & 0xff;
+                    auto r = (hash >> 8) & 0xff;
+                    auto g = (x * 2 + y) & 0xff;
+                    auto b = ((x ^ y) & 0x3f) * 3;
+                    pixels[y * w + x] = (a << 24) | (r << 16) | (g << 8) | b;
+                }
+            }
+
+            //the decoded pixels must be drawn same as the raw ones
+            REQUIRE(canvas->target(buffer1, w, w, h, ColorSpace::ARGB8888S) == Result::Success);
+            auto picture = Picture::gen();
+            REQUIRE(picture->load(alpha ? TEST_DIR"/filters_alpha.png" : TEST_DIR"/filters.png") == Result::Success);
+            REQUIRE(canvas->add(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            REQUIRE(canvas->remove() == Result::Success);
+
+            REQUIRE(canvas->target(buffer2, w, w, h, ColorSpace::ARGB8888S) == Result::Success);
+            picture = Picture::gen();
+            REQUIRE(picture->load(pixels, w, h, ColorSpace::ARGB8888S, false) == Result::Success);
+            REQUIRE(canvas->add(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+            REQUIRE(canvas->remove() == Result::Success);
+
+            REQUIRE(memcmp(buffer1, buffer2, sizeof(buffer1)) == 0);
+
+            //and the opaque ones are kept as they are
+            auto matched = true;
+            for (uint32_t i = 0; i < w * h; ++i) {
+                if ((pixels[i] >> 24) == 0xff && buffer1[i] != pixels[i]) matched = false;
+            }
+            REQUIRE(matched);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Image memory budget", "[tvgPicture]")
+{
+    //counts the decoded pixels of test.png (512 x 512)
+    struct Pixels
+    {
+        set<void*> blocks;
+        uint32_t decoded = 0;
+        uint32_t released = 0;
+
+        void* alloc(void* p, size_t size)
+        {
+            if (p && size == 512 * 512 * 4) {
+                blocks.insert(p);
+                ++decoded;
+            }
+            return p;
+        }
+    } pixels;
+
+    Allocator allocator = {
+        [](size_t size, void* user) -> void* {
+            return static_cast<Pixels*>(user)->alloc(malloc(size), size);
+        },
+        [](size_t nmem, size_t size, void* user) -> void* {
+            return static_cast<Pixels*>(user)->alloc(calloc(nmem, size), nmem * size);
+        },
+        [](void* ptr, size_t size, void* user) -> void* {
+            static_cast<Pixels*>(user)->blocks.erase(ptr);
+            return static_cast<Pixels*>(user)->alloc(realloc(ptr, size), size);
+        },
+        [](void* ptr, void* user) {
+            if (static_cast<Pixels*>(user)->blocks.erase(ptr)) ++static_cast<Pixels*>(user)->released;
+            free(ptr);
+        },
+        &pixels
+    };
+
+    REQUIRE(Initializer::init(0, &allocator) == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        static uint32_t buffer[128*128];
+        REQUIRE(canvas->target(buffer, 128, 128, 128, ColorSpace::ARGB8888) == Result::Success);
+
+        auto draw = [](SwCanvas* canvas) {
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(TEST_DIR"/test.png") == Result::Success);
+        REQUIRE(picture->size(128, 128) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        draw(canvas.get());
+        REQUIRE(pixels.decoded == 1);
+
+        static uint32_t expected[128*128];
+        memcpy(expected, buffer, sizeof(buffer));
+
+        //The decoded pixels over the budget are released while the picture is out of the viewport
+        REQUIRE(Initializer::budget(1) == Result::Success);
+        REQUIRE(picture->translate(1000, 1000) == Result::Success);
+        for (int i = 0; i < 3; ++i) draw(canvas.get());
+        REQUIRE(pixels.released == 1);
+
+        //Decoded again once it's back
+        REQUIRE(picture->translate(0, 0) == Result::Success);
+        draw(canvas.get());
+        REQUIRE(pixels.decoded == 2);
+        REQUIRE(memcmp(expected, buffer, sizeof(buffer)) == 0);
+
+        //The other canvas shares the decoded pixels, they may be in its drawing at any time
+        auto canvas2 = unique_ptr<SwCanvas>(SwCanvas::gen());
+        static uint32_t buffer2[128*128];
+        REQUIRE(canvas2->target(buffer2, 128, 128, 128, ColorSpace::ARGB8888) == Result::Success);
+        auto picture2 = Picture::gen();
+        REQUIRE(picture2->load(TEST_DIR"/test.png") == Result::Success);
+        REQUIRE(picture2->size(128, 128) == Result::Success);
+        REQUIRE(canvas2->add(picture2) == Result::Success);
+        draw(canvas2.get());
+        REQUIRE(pixels.decoded == 2);
+        REQUIRE(memcmp(expected, buffer2, sizeof(buffer2)) == 0);
+
+        REQUIRE(picture->translate(1000, 1000) == Result::Success);
+        for (int i = 0; i < 3; ++i) draw(canvas.get());
+        REQUIRE(pixels.released == 1);
+
+        REQUIRE(Initializer::budget(0) == Result::Success);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load huge PNG file in the viewport", "[tvgPicture]")
+{
+    _loadHuge(TEST_DIR"/huge.png");
+}
+
 #endif
 
 #ifdef THORVG_JPG_LOADER_SUPPORT
@@ -372,6 +765,12 @@ TEST_CASE("Load JPG file from data", "[tvgPicture]")
     Paint::rel(picture);
 }
 
+TEST_CASE("Release the JPG source after decoding", "[tvgPicture]")
+{
+    _keepSource(TEST_DIR"/test.jpg", "jpg", 0);
+    _keepSource(TEST_DIR"/test.jpg", "jpg", 1024);
+}
+
 TEST_CASE("Load JPG file and render", "[tvgPicture]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -393,6 +792,94 @@ TEST_CASE("Load JPG file and render", "[tvgPicture]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Load JPG file in reduced size", "[tvgPicture]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto render = [](Picture* picture, uint32_t* buffer, uint32_t size) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->add(picture) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //Full size decoding, a copied data is not shared with the pictures loaded from the path
+        ifstream file(TEST_DIR"/test.jpg", ios::in | ios::binary);
+        REQUIRE(file.is_open());
+        vector<char> data((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+
+        static uint32_t full[512*512];
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(data.data(), data.size(), "jpg", nullptr, true) == Result::Success);
+        render(picture, full, 512);
+
+        //Reduced size decoding (1/2, 1/4 and 1/8) by the size requested prior to the loading
+        for (auto scale : {2, 4, 8}) {
+            auto size = 512 / scale;
+            vector<uint32_t> reduced(size * size);
+
+            picture = Picture::gen();
+            REQUIRE(picture->size(float(size), float(size)) == Result::Success);
+            REQUIRE(picture->load(TEST_DIR"/test.jpg") == Result::Success);
+
+            //The picture takes the image size, the reduced pixels are scaled up to it
+            float w, h;
+            REQUIRE(picture->size(&w, &h) == Result::Success);
+            REQUIRE(w == 512);
+            REQUIRE(h == 512);
+
+            REQUIRE(picture->size(float(size), float(size)) == Result::Success);
+            render(picture, reduced.data(), size);
+
+            //The reduced IDCT is close to the average of the full size pixels, the DC only one (1/8) is the average itself
+            uint64_t sum = 0;
+            auto max = 0;
+            for (auto y = 0; y < size; ++y) {
+                for (auto x = 0; x < size; ++x) {
+                    for (auto c = 0; c < 24; c += 8) {
+                        auto avg = 0;
+                        for (auto j = 0; j < scale; ++j) {
+                            for (auto i = 0; i < scale; ++i) avg += (full[(y * scale + j) * 512 + x * scale + i] >> c) & 0xff;
+                        }
+                        avg = (avg + scale * scale / 2) / (scale * scale);
+                        auto diff = abs(avg - int((reduced[y * size + x] >> c) & 0xff));
+                        sum += diff;
+                        if (diff > max) max = diff;
+                    }
+                }
+            }
+            REQUIRE(sum < uint64_t(size * size * 3 * 2));
+            if (scale == 8) REQUIRE(max <= 2);
+        }
+
+        //The reduced pixels cover the whole image size without the resizing
+        static uint32_t scaled[512*512];
+        picture = Picture::gen();
+        REQUIRE(picture->size(64, 64) == Result::Success);
+        REQUIRE(picture->load(TEST_DIR"/test.jpg") == Result::Success);
+        render(picture, scaled, 512);
+        REQUIRE((scaled[0] >> 24) == 0xff);
+        REQUIRE((scaled[512 * 512 - 1] >> 24) == 0xff);
+
+        //No reduction for the larger size
+        picture = Picture::gen();
+        REQUIRE(picture->size(600, 600) == Result::Success);
+        REQUIRE(picture->load(TEST_DIR"/test.jpg") == Result::Success);
+        float w, h;
+        REQUIRE(picture->size(&w, &h) == Result::Success);
+        REQUIRE(w == 512);
+        REQUIRE(h == 512);
+        Paint::rel(picture);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Load huge JPG file in the viewport", "[tvgPicture]")
+{
+    _loadHuge(TEST_DIR"/huge.jpg");
+}
+
 #endif
 
 #ifdef THORVG_WEBP_LOADER_SUPPORT
@@ -442,6 +929,12 @@ TEST_CASE("Load WEBP file from data", "[tvgPicture]")
     Paint::rel(picture);
 }
 
+TEST_CASE("Release the WEBP source after decoding", "[tvgPicture]")
+{
+    _keepSource(TEST_DIR"/test.webp", "webp", 0);
+    _keepSource(TEST_DIR"/test.webp", "webp", 1024);
+}
+
 TEST_CASE("Load WEBP file and render", "[tvgPicture]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -475,4 +968,9 @@ TEST_CASE("Filter Method", "[tvgPicture]")
     Paint::rel(picture);
 }
 
+TEST_CASE("Load huge WEBP file in the viewport", "[tvgPicture]")
+{
+    _loadHuge(TEST_DIR"/huge.webp");
+}
+
 #endif
@@ -22,6 +22,9 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <vector>
+#include <cstring>
+#include <functional>
 #include "config.h"
 #include "catch.hpp"
 
@@ -36,6 +39,174 @@ TEST_CASE("Saver Creation", "[tvgSavers]")
 
 #if defined(THORVG_GIF_SAVER_SUPPORT) && defined(THORVG_LOTTIE_LOADER_SUPPORT)
 
+//The frame shown by the gif decoder
+struct GifScreen
+{
+    uint32_t w, h;
+    vector<uint8_t> rgba;    //the frame composed over the previous ones
+    vector<uint8_t> colors;  //the rgb colors drawn by the last image
+};
+
+//A strict LZW decoder, it follows the code size of the dictionary and must meet the end code right after the pixels
+static bool _decodeLzw(const vector<uint8_t>& data, uint32_t minCodeSize, vector<uint8_t>& out, uint32_t count)
+{
+    uint16_t prefix[4096];
+    uint8_t suffix[4096];
+    uint8_t stack[4096];
+
+    auto clear = 1u << minCodeSize;
+    auto codeSize = minCodeSize + 1;
+    auto next = clear + 2;
+    int32_t prev = -1;
+    size_t bit = 0;
+
+    auto first = [&](uint32_t code) {
+        while (code > clear) code = prefix[code];
+        return uint8_t(code);
+    };
+
+    auto emit = [&](uint32_t code) {
+        auto len = 0;
+        while (code > clear) {
+            stack[len++] = suffix[code];
+            code = prefix[code];
+        }
+        stack[len++] = uint8_t(code);
+        if (out.size() + len > count) return false;
+        while (len > 0) out.push_back(stack[--len]);
+        return true;
+    };
+
+    while (true) {
+        if (bit + codeSize > data.size() * 8) return false;
+        uint32_t code = 0;
+        for (uint32_t i = 0; i < codeSize; ++i, ++bit) {
+            code |= ((data[bit / 8] >> (bit % 8)) & 1) << i;
+        }
+
+        if (code == clear) {
+            codeSize = minCodeSize + 1;
+            next = clear + 2;
+            prev = -1;
+            continue;
+        }
+        if (code == clear + 1) break;
+
+        if (prev < 0) {
+            if (code > clear || !emit(code)) return false;
+        } else {
+            if (code > next) return false;
+            auto c = (code == next) ? first(prev) : first(code);
+            if (next < 4096) {
+                prefix[next] = uint16_t(prev);
+                suffix[next] = c;
+                ++next;
+                if (next == (1u << codeSize) && codeSize < 12) ++codeSize;
+            }
+            if (!emit(code)) return false;
+        }
+        prev = code;
+    }
+    return out.size() == count;
+}
+
+//Decodes the gif and composes the frames on the screen with their disposal, calls the viewer per frame
+static bool _decodeGif(const vector<uint8_t>& gif, const function<void(const GifScreen&)>& viewer)
+{
+    if (gif.size() < 13 || memcmp(gif.data(), "GIF89a", 6)) return false;
+
+    GifScreen screen;
+    screen.w = gif[6] | (gif[7] << 8);
+    screen.h = gif[8] | (gif[9] << 8);
+    screen.rgba.assign(screen.w * screen.h * 4, 0);
+
+    size_t p = 13;
+    const uint8_t* global = nullptr;
+    if (gif[10] & 0x80) {
+        global = gif.data() + p;
+        p += 3 * (2 << (gif[10] & 0x07));
+    }
+
+    auto blocks = [&](vector<uint8_t>* data) {
+        while (p < gif.size() && gif[p]) {
+            auto size = gif[p++];
+            if (p + size > gif.size()) return false;
+            if (data) data->insert(data->end(), gif.begin() + p, gif.begin() + p + size);
+            p += size;
+        }
+        return ++p <= gif.size();
+    };
+
+    uint8_t disposal = 0;
+    int32_t transparent = -1;
+
+    while (p < gif.size()) {
+        auto type = gif[p++];
+        //trailer
+        if (type == 0x3b) return p == gif.size();
+        //extensions
+        if (type == 0x21) {
+            if (p + 6 > gif.size()) return false;
+            if (gif[p] == 0xf9) {
+                disposal = (gif[p + 2] >> 2) & 0x07;
+                transparent = (gif[p + 2] & 0x01) ? gif[p + 5] : -1;
+            }
+            ++p;
+            if (!blocks(nullptr)) return false;
+            continue;
+        }
+        if (type != 0x2c || p + 10 > gif.size()) return false;
+
+        //image
+        auto x = gif[p] | (gif[p + 1] << 8);
+        auto y = gif[p + 2] | (gif[p + 3] << 8);
+        auto w = uint32_t(gif[p + 4] | (gif[p + 5] << 8));
+        auto h = uint32_t(gif[p + 6] | (gif[p + 7] << 8));
+        auto flags = gif[p + 8];
+        p += 9;
+        if (x + w > screen.w || y + h > screen.h) return false;
+
+        auto palette = global;
+        if (flags & 0x80) {
+            palette = gif.data() + p;
+            p += 3 * (2 << (flags & 0x07));
+        }
+        if (!palette || p >= gif.size()) return false;
+
+        auto minCodeSize = gif[p++];
+        vector<uint8_t> data, indices;
+        if (!blocks(&data) || !_decodeLzw(data, minCodeSize, indices, w * h)) return false;
+
+        bool used[256] = {};
+        for (uint32_t yy = 0; yy < h; ++yy) {
+            for (uint32_t xx = 0; xx < w; ++xx) {
+                auto idx = indices[yy * w + xx];
+                if (idx == transparent) continue;
+                auto dst = &screen.rgba[((y + yy) * screen.w + x + xx) * 4];
+                memcpy(dst, palette + idx * 3, 3);
+                dst[3] = 255;
+                used[idx] = true;
+            }
+        }
+        screen.colors.clear();
+        for (auto i = 0; i < 256; ++i) {
+            if (used[i]) screen.colors.insert(screen.colors.end(), palette + i * 3, palette + i * 3 + 3);
+        }
+
+        viewer(screen);
+
+        //restore to the background
+        if (disposal == 2) {
+            for (uint32_t yy = 0; yy < h; ++yy) {
+                memset(&screen.rgba[((y + yy) * screen.w + x) * 4], 0, w * 4);
+            }
+        }
+        disposal = 0;
+        transparent = -1;
+    }
+    return false;
+}
+
 TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
     REQUIRE(Initializer::init() == Result::Success);
     {
@@ -57,4 +228,447 @@ TEST_CASE("Save a lottie into gif", "[tvgSavers]") {
     }
     REQUIRE(Initializer::term() == Result::Success);
 }
-#endif
\ No newline at end of file
+
+TEST_CASE("Save a lottie into gif in memory", "[tvgSavers]") {
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto gen = []() {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+            return animation;
+        };
+
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver);
+
+        auto writer = [](const uint8_t* data, uint32_t size, void* user) -> bool {
+            auto out = static_cast<vector<uint8_t>*>(user);
+            out->insert(out->end(), data, data + size);
+            return true;
+        };
+
+        //Invalid arguments
+        REQUIRE(saver->save(gen(), "gif", nullptr, nullptr) == Result::InvalidArguments);
+        REQUIRE(saver->save(gen(), "txt", writer, nullptr) == Result::NonSupport);
+
+        //Same data as the file
+        vector<uint8_t> memory;
+        REQUIRE(saver->save(gen(), "gif", writer, &memory) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+        REQUIRE(memory.size() > 6);
+        REQUIRE(memcmp(memory.data(), "GIF89a", 6) == 0);
+        REQUIRE(memory.back() == 0x3b);
+
+        REQUIRE(saver->save(gen(), TEST_DIR"/test.gif") == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        ifstream file(TEST_DIR"/test.gif", ios::in | ios::binary);
+        REQUIRE(file.is_open());
+        vector<uint8_t> saved((istreambuf_iterator<char>(file)), istreambuf_iterator<char>());
+        REQUIRE(saved == memory);
+
+        //Aborted by the writer
+        auto calls = 0;
+        REQUIRE(saver->save(gen(), "gif", [](const uint8_t*, uint32_t, void* user) -> bool {
+            ++(*static_cast<int*>(user));
+            return false;
+        }, &calls) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+        REQUIRE(calls == 1);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Save a lottie into gif with worker threads", "[tvgSavers]") {
+    auto save = [](uint32_t threads) {
+        vector<uint8_t> memory;
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+
+            auto saver = unique_ptr<Saver>(Saver::gen());
+            REQUIRE(saver->save(animation, "gif", [](const uint8_t* data, uint32_t size, void* user) -> bool {
+                auto out = static_cast<vector<uint8_t>*>(user);
+                out->insert(out->end(), data, data + size);
+                return true;
+            }, &memory) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+        return memory;
+    };
+
+    //The pipelined encoding must not change the output
+    auto single = save(0);
+    REQUIRE(single.size() > 6);
+    REQUIRE(save(4) == single);
+
+    //The saver waits for its own tasks queued behind itself on the only worker
+    REQUIRE(save(1) == single);
+}
+
+TEST_CASE("Compose the gif frames", "[tvgSavers]") {
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto background = []() {
+            auto bg = Shape::gen();
+            bg->fill(255, 255, 255);
+            bg->appendRect(0, 0, 100, 100);
+            return bg;
+        };
+
+        auto gen = []() {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+            return animation;
+        };
+
+        //with a background, the frames keep the previous ones. Otherwise, they are disposed
+        for (auto opaque : {true, false}) {
+            auto saver = unique_ptr<Saver>(Saver::gen());
+            if (opaque) REQUIRE(saver->background(background()) == Result::Success);
+            vector<uint8_t> memory;
+            REQUIRE(saver->save(gen(), "gif", [](const uint8_t* data, uint32_t size, void* user) -> bool {
+                auto out = static_cast<vector<uint8_t>*>(user);
+                out->insert(out->end(), data, data + size);
+                return true;
+            }, &memory) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+
+            //the frames the saver rendered
+            auto animation = unique_ptr<Animation>(gen());
+            vector<uint32_t> rendered(100 * 100);
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(rendered.data(), 100, 100, 100, ColorSpace::ABGR8888S) == Result::Success);
+            if (opaque) REQUIRE(canvas->add(background()) == Result::Success);
+            REQUIRE(canvas->add(animation->picture()) == Result::Success);
+
+            vector<float> frameNos;
+            auto delay = animation->duration() / animation->totalFrame();
+            for (auto p = 0.0f; p < animation->duration(); p += delay) {
+                frameNos.push_back(animation->totalFrame() * (p / animation->duration()));
+            }
+
+            //every shown pixel is either the rendered color, or the closest one of the colors drawn by the frame.
+            //a region or a disposal gone wrong leaves a stale pixel behind.
+            uint32_t frames = 0, mismatches = 0;
+            auto distance = [](const uint8_t* a, const uint8_t* b) {
+                return abs(a[0] - b[0]) + abs(a[1] - b[1]) + abs(a[2] - b[2]);
+            };
+
+            REQUIRE(_decodeGif(memory, [&](const GifScreen& screen) {
+                REQUIRE(frames < frameNos.size());
+                animation->frame(frameNos[frames++]);
+                REQUIRE(canvas->update() == Result::Success);
+                REQUIRE(canvas->draw(true) == Result::Success);
+                REQUIRE(canvas->sync() == Result::Success);
+
+                for (uint32_t i = 0; i < 100 * 100; ++i) {
+                    auto expected = reinterpret_cast<const uint8_t*>(&rendered[i]);
+                    auto shown = &screen.rgba[i * 4];
+                    if (!opaque && expected[3] < 127) {
+                        if (shown[3] != 0) ++mismatches;
+                        continue;
+                    }
+                    if (shown[3] != 255) {
+                        ++mismatches;
+                        continue;
+                    }
+                    auto diff = distance(shown, expected);
+                    if (diff == 0) continue;
+                    for (size_t c = 0; c < screen.colors.size(); c += 3) {
+                        if (distance(&screen.colors[c], expected) < diff) {
+                            ++mismatches;
+                            break;
+                        }
+                    }
+                }
+            }));
+            REQUIRE(frames == frameNos.size());
+            REQUIRE(mismatches == 0);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Save a flat color into gif", "[tvgSavers]") {
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //a single color of 180x180 ends the LZW codes where the dictionary grows the code size
+        auto animation = Animation::gen();
+        auto picture = animation->picture();
+        REQUIRE(picture->load(TEST_DIR"/test.lot") == Result::Success);
+        REQUIRE(picture->size(180, 180) == Result::Success);
+        REQUIRE(picture->opacity(0) == Result::Success);
+
+        auto bg = Shape::gen();
+        REQUIRE(bg->fill(40, 80, 120) == Result::Success);
+        REQUIRE(bg->appendRect(0, 0, 180, 180) == Result::Success);
+
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver->background(bg) == Result::Success);
+        vector<uint8_t> memory;
+        REQUIRE(saver->save(animation, "gif", [](const uint8_t* data, uint32_t size, void* user) -> bool {
+            auto out = static_cast<vector<uint8_t>*>(user);
+            out->insert(out->end(), data, data + size);
+            return true;
+        }, &memory) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        auto frames = 0;
+        auto flat = true;
+        REQUIRE(_decodeGif(memory, [&](const GifScreen& screen) {
+            REQUIRE(screen.w == 180);
+            REQUIRE(screen.h == 180);
+            for (uint32_t i = 0; i < screen.w * screen.h; ++i) {
+                auto pixel = &screen.rgba[i * 4];
+                if (pixel[0] != 40 || pixel[1] != 80 || pixel[2] != 120 || pixel[3] != 255) flat = false;
+            }
+            ++frames;
+        }));
+        REQUIRE(frames > 1);
+        REQUIRE(flat);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+#endif
+#if defined(THORVG_PNG_SAVER_SUPPORT) && defined(THORVG_PNG_LOADER_SUPPORT)
+
+static uint32_t _crc(const uint8_t* data, size_t size, uint32_t crc = 0)
+{
+    crc = ~crc;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= data[i];
+        for (auto k = 0; k < 8; ++k) crc = (crc >> 1) ^ (0xedb88320 & (0 - (crc & 1)));
+    }
+    return ~crc;
+}
+
+static uint32_t _read32(const uint8_t* p)
+{
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+static void _write32(vector<uint8_t>& out, uint32_t v)
+{
+    uint8_t p[4] = {uint8_t(v >> 24), uint8_t(v >> 16), uint8_t(v >> 8), uint8_t(v)};
+    out.insert(out.end(), p, p + 4);
+}
+
+static void _chunk(vector<uint8_t>& out, const char* type, const uint8_t* data, size_t size)
+{
+    _write32(out, uint32_t(size));
+    auto begin = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data, data + size);
+    _write32(out, _crc(out.data() + begin, size + 4));
+}
+
+//Splits the apng into the standalone pngs of its frames, the chunks must be in the sequence
+static bool _decodeApng(const vector<uint8_t>& apng, const function<void(const vector<uint8_t>&)>& viewer)
+{
+    if (apng.size() < 8 || memcmp(apng.data(), "\x89PNG\r\n\x1a\n", 8)) return false;
+
+    vector<uint8_t> header, data;
+    uint32_t seq = 0, frames = 0, shown = 0;
+    auto inFrame = false;
+
+    auto flush = [&]() {
+        if (!inFrame) return;
+        vector<uint8_t> png(apng.begin(), apng.begin() + 8);
+        _chunk(png, "IHDR", header.data(), header.size());
+        _chunk(png, "IDAT", data.data(), data.size());
+        _chunk(png, "IEND", nullptr, 0);
+        viewer(png);
+        data.clear();
+        ++shown;
+    };
+
+    size_t p = 8;
+    while (p + 12 <= apng.size()) {
+        auto size = _read32(&apng[p]);
+        auto type = &apng[p + 4];
+        auto body = &apng[p + 8];
+        if (p + 12 + size > apng.size() || _read32(body + size) != _crc(type, size + 4)) return false;
+        p += 12 + size;
+
+        if (!memcmp(type, "IHDR", 4)) header.assign(body, body + size);
+        else if (!memcmp(type, "acTL", 4)) frames = _read32(body);
+        else if (!memcmp(type, "fcTL", 4)) {
+            //the frames cover the whole image and replace the previous ones
+            if (size != 26 || _read32(body) != seq++) return false;
+            if (memcmp(body + 4, header.data(), 8) || _read32(body + 12) || _read32(body + 16)) return false;
+            flush();
+            inFrame = true;
+        } else if (!memcmp(type, "IDAT", 4)) {
+            if (!inFrame || shown > 0) return false;
+            data.insert(data.end(), body, body + size);
+        } else if (!memcmp(type, "fdAT", 4)) {
+            if (!inFrame || shown == 0 || size < 4 || _read32(body) != seq++) return false;
+            data.insert(data.end(), body + 4, body + size);
+        } else if (!memcmp(type, "IEND", 4)) {
+            flush();
+            return p == apng.size() && shown == frames;
+        }
+    }
+    return false;
+}
+
+
+TEST_CASE("Save a paint into png", "[tvgSavers]")
+{
+    //two opaque rects with a transparent gap in between, filled with the background in the opaque one
+    auto gen = [](bool opaque) {
+        auto scene = Scene::gen();
+        if (opaque) {
+            auto bg = Shape::gen();
+            REQUIRE(bg->appendRect(0, 0, 100, 100) == Result::Success);
+            REQUIRE(bg->fill(0, 128, 0) == Result::Success);
+            scene->add(bg);
+        }
+        auto shape1 = Shape::gen();
+        REQUIRE(shape1->appendRect(0, 0, 40, 100) == Result::Success);
+        REQUIRE(shape1->fill(255, 0, 0) == Result::Success);
+        auto shape2 = Shape::gen();
+        REQUIRE(shape2->appendRect(60, 0, 40, 100) == Result::Success);
+        REQUIRE(shape2->fill(0, 0, 255) == Result::Success);
+        scene->add(shape1);
+        scene->add(shape2);
+        return scene;
+    };
+
+    auto render = [](Paint* paint, uint32_t* buffer) {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ABGR8888S) == Result::Success);
+        REQUIRE(canvas->add(paint) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+    };
+
+    auto writer = [](const uint8_t* data, uint32_t size, void* user) -> bool {
+        auto out = static_cast<vector<uint8_t>*>(user);
+        out->insert(out->end(), data, data + size);
+        return true;
+    };
+
+    //the band split depends on the threads
+    for (auto threads : {0, 4}) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        for (auto opaque : {false, true}) {
+            auto saver = unique_ptr<Saver>(Saver::gen());
+            vector<uint8_t> memory;
+            REQUIRE(saver->save(gen(opaque), "png", writer, &memory) == Result::Success);
+            REQUIRE(saver->sync() == Result::Success);
+            REQUIRE(memory.size() > 26);
+            REQUIRE(memcmp(memory.data(), "\x89PNG", 4) == 0);
+
+            //the opaque image is saved in rgb, the color type of the header
+            REQUIRE(memcmp(memory.data() + 12, "IHDR", 4) == 0);
+            REQUIRE(memory[25] == (opaque ? 2 : 6));
+
+            //lossless round trip
+            auto picture = Picture::gen();
+            REQUIRE(picture->load((const char*)memory.data(), memory.size(), "png", nullptr, true) == Result::Success);
+            float w, h;
+            REQUIRE(picture->size(&w, &h) == Result::Success);
+            REQUIRE(w == 100);
+            REQUIRE(h == 100);
+
+            vector<uint32_t> expected(100 * 100), saved(100 * 100);
+            render(gen(opaque), expected.data());
+            render(picture, saved.data());
+            REQUIRE(saved == expected);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    }
+}
+
+#ifdef THORVG_LOTTIE_LOADER_SUPPORT
+
+TEST_CASE("Save a lottie into apng", "[tvgSavers]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto background = []() {
+            auto bg = Shape::gen();
+            bg->fill(255, 255, 255);
+            bg->appendRect(0, 0, 100, 100);
+            return bg;
+        };
+
+        auto gen = []() {
+            auto animation = Animation::gen();
+            REQUIRE(animation->picture()->load(TEST_DIR"/test.lot") == Result::Success);
+            REQUIRE(animation->picture()->size(100, 100) == Result::Success);
+            return animation;
+        };
+
+        auto saver = unique_ptr<Saver>(Saver::gen());
+        REQUIRE(saver->background(background()) == Result::Success);
+        vector<uint8_t> memory;
+        REQUIRE(saver->save(gen(), "png", [](const uint8_t* data, uint32_t size, void* user) -> bool {
+            auto out = static_cast<vector<uint8_t>*>(user);
+            out->insert(out->end(), data, data + size);
+            return true;
+        }, &memory) == Result::Success);
+        REQUIRE(saver->sync() == Result::Success);
+
+        //the animation control follows the header
+        REQUIRE(memory.size() > 41);
+        REQUIRE(memcmp(memory.data(), "\x89PNG", 4) == 0);
+        REQUIRE(memcmp(memory.data() + 37, "acTL", 4) == 0);
+
+        //the first frame is the default image
+        auto picture = Picture::gen();
+        REQUIRE(picture->load((const char*)memory.data(), memory.size(), "png", nullptr, true) == Result::Success);
+        float w, h;
+        REQUIRE(picture->size(&w, &h) == Result::Success);
+        REQUIRE(w == 100);
+        REQUIRE(h == 100);
+        Paint::rel(picture);
+
+        //the frames the saver rendered
+        auto animation = unique_ptr<Animation>(gen());
+        vector<uint32_t> rendered(100 * 100), saved(100 * 100);
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(rendered.data(), 100, 100, 100, ColorSpace::ABGR8888S) == Result::Success);
+        REQUIRE(canvas->add(background()) == Result::Success);
+        REQUIRE(canvas->add(animation->picture()) == Result::Success);
+
+        vector<float> frameNos;
+        auto delay = 1.0f / (animation->totalFrame() / animation->duration());
+        for (auto p = 0.0f; p < animation->duration(); p += delay) {
+            frameNos.push_back(animation->totalFrame() * (p / animation->duration()));
+        }
+
+        //every frame is a lossless copy of the rendered one
+        uint32_t frames = 0, mismatches = 0;
+        REQUIRE(_decodeApng(memory, [&](const vector<uint8_t>& png) {
+            REQUIRE(frames < frameNos.size());
+            animation->frame(frameNos[frames++]);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto frame = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(frame->target(saved.data(), 100, 100, 100, ColorSpace::ABGR8888S) == Result::Success);
+            auto picture = Picture::gen();
+            REQUIRE(picture->load((const char*)png.data(), png.size(), "png", nullptr, true) == Result::Success);
+            REQUIRE(frame->add(picture) == Result::Success);
+            REQUIRE(frame->draw(true) == Result::Success);
+            REQUIRE(frame->sync() == Result::Success);
+            if (saved != rendered) ++mismatches;
+        }));
+        REQUIRE(frames == frameNos.size());
+        REQUIRE(mismatches == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+#endif
+
+#endif
@@ -21,6 +21,7 @@
  */
 
 #include <thorvg.h>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
 
@@ -73,6 +74,31 @@ TEST_CASE("Pushing Paints Into Scene", "[tvgScene]")
     REQUIRE(scene->remove(paints[0]) == Result::Success);
     REQUIRE(scene->remove(paints[0]) == Result::InsufficientCondition);
     REQUIRE(scene->add(paints[0], paints[1]) == Result::Success);
+
+    //Rendering order
+    Paint* const* children = nullptr;
+    REQUIRE(scene->paints(nullptr) == 3);
+    REQUIRE(scene->paints(&children) == 3);
+    REQUIRE(children[0] == paints[0]);
+    REQUIRE(children[1] == paints[1]);
+    REQUIRE(children[2] == paints[2]);
+
+    auto& list = scene->paints();
+    REQUIRE(list.size() == 3);
+    REQUIRE(list.front() == paints[0]);
+    REQUIRE(list.back() == paints[2]);
+
+    REQUIRE(scene->remove(paints[1]) == Result::Success);
+    REQUIRE(scene->paints(&children) == 2);
+    REQUIRE(children[0] == paints[0]);
+    REQUIRE(children[1] == paints[2]);
+    REQUIRE(list.size() == 2);
+    REQUIRE(list.back() == paints[2]);
+    REQUIRE(scene->add(paints[1], paints[2]) == Result::Success);
+    REQUIRE(scene->add(paints[1], paints[2]) == Result::InsufficientCondition);
+    REQUIRE(scene->paints(&children) == 3);
+    REQUIRE(children[1] == paints[1]);
+
     REQUIRE(scene->remove(paints[1]) == Result::Success);
     REQUIRE(scene->remove(paints[1]) == Result::InsufficientCondition);
     REQUIRE(scene->remove(paints[2]) == Result::Success);
@@ -189,4 +215,124 @@ TEST_CASE("Scene Effects", "[tvgScene]")
         REQUIRE(canvas->sync() == Result::Success);
     }
     REQUIRE(Initializer::term() == Result::Success);
-}
\ No newline at end of file
+}
+TEST_CASE("Scene Picking", "[tvgScene]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto scene = Scene::gen();
+        REQUIRE(scene);
+
+        auto collect = [](Paint* paint, void* data) -> bool {
+            static_cast<vector<Paint*>*>(data)->push_back(paint);
+            return true;
+        };
+        vector<Paint*> picked;
+
+        //Not updated yet
+        auto shape1 = Shape::gen();
+        REQUIRE(shape1->appendRect(0, 0, 50, 50) == Result::Success);
+        REQUIRE(shape1->fill(255, 0, 0) == Result::Success);
+        REQUIRE(scene->add(shape1) == Result::Success);
+        REQUIRE(scene->pick(10, 10, 1, 1, collect, &picked) == Result::InsufficientCondition);
+
+        auto shape2 = Shape::gen();
+        REQUIRE(shape2->appendRect(25, 25, 50, 50) == Result::Success);
+        REQUIRE(shape2->fill(0, 255, 0) == Result::Success);
+        REQUIRE(scene->add(shape2) == Result::Success);
+
+        REQUIRE(canvas->add(scene) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //Invalid arguments
+        REQUIRE(scene->pick(10, 10, 0, 1, collect, &picked) == Result::InvalidArguments);
+        REQUIRE(scene->pick(10, 10, 1, 1, nullptr, nullptr) == Result::InvalidArguments);
+
+        //Top-down order
+        REQUIRE(scene->pick(30, 30, 1, 1, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 2);
+        REQUIRE(picked[0] == shape2);
+        REQUIRE(picked[1] == shape1);
+
+        picked.clear();
+        REQUIRE(scene->pick(10, 10, 1, 1, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 1);
+        REQUIRE(picked[0] == shape1);
+
+        picked.clear();
+        REQUIRE(scene->pick(90, 90, 5, 5, collect, &picked) == Result::Success);
+        REQUIRE(picked.empty());
+
+        //Stop at the topmost
+        picked.clear();
+        REQUIRE(scene->pick(30, 30, 1, 1, [](Paint* paint, void* data) -> bool {
+            static_cast<vector<Paint*>*>(data)->push_back(paint);
+            return false;
+        }, &picked) == Result::Success);
+        REQUIRE(picked.size() == 1);
+        REQUIRE(picked[0] == shape2);
+
+        //Moved
+        REQUIRE(shape2->translate(40, 40) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        picked.clear();
+        REQUIRE(scene->pick(30, 30, 1, 1, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 1);
+        REQUIRE(picked[0] == shape1);
+
+        picked.clear();
+        REQUIRE(scene->pick(80, 80, 1, 1, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 1);
+        REQUIRE(picked[0] == shape2);
+
+        //Hidden
+        REQUIRE(shape1->visible(false) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        picked.clear();
+        REQUIRE(scene->pick(10, 10, 1, 1, collect, &picked) == Result::Success);
+        REQUIRE(picked.empty());
+
+        //Many children
+        REQUIRE(scene->remove() == Result::Success);
+        for (int y = 0; y < 20; ++y) {
+            for (int x = 0; x < 20; ++x) {
+                auto shape = Shape::gen();
+                REQUIRE(shape->appendRect(x * 5, y * 5, 4, 4) == Result::Success);
+                REQUIRE(shape->fill(0, 0, 255) == Result::Success);
+                REQUIRE(scene->add(shape) == Result::Success);
+            }
+        }
+        //covers the whole scene
+        auto cover = Shape::gen();
+        REQUIRE(cover->appendRect(0, 0, 100, 100) == Result::Success);
+        REQUIRE(cover->fill(0, 0, 0, 10) == Result::Success);
+        REQUIRE(scene->add(cover) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        picked.clear();
+        REQUIRE(scene->pick(51, 51, 2, 2, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 2);
+        REQUIRE(picked[0] == cover);
+
+        picked.clear();
+        REQUIRE(scene->pick(0, 0, 100, 100, collect, &picked) == Result::Success);
+        REQUIRE(picked.size() == 401);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
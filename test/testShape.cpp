@@ -244,3 +244,83 @@ TEST_CASE("Shape Filling", "[tvgShape]")
 
     Paint::rel(shape);
 }
+
+TEST_CASE("Shape Instancing", "[tvgShape]")
+{
+    auto source = Shape::gen();
+    REQUIRE(source->appendRect(0, 0, 10, 10) == Result::Success);
+    REQUIRE(source->fill(255, 0, 0) == Result::Success);
+
+    auto instance = source->instance();
+    REQUIRE(instance);
+    REQUIRE(instance->type() == Type::Shape);
+
+    //The path is shared, not copied
+    const Point* pts1;
+    const Point* pts2;
+    uint32_t cnt1, cnt2;
+    REQUIRE(source->path(nullptr, nullptr, &pts1, &cnt1) == Result::Success);
+    REQUIRE(instance->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(pts1 == pts2);
+    REQUIRE(cnt1 == cnt2);
+
+    //Instancing an instance refers to the source
+    auto instance2 = instance->instance();
+    REQUIRE(instance2->path(nullptr, nullptr, &pts2, nullptr) == Result::Success);
+    REQUIRE(pts1 == pts2);
+
+    auto dup = instance->duplicate();
+    REQUIRE(static_cast<Shape*>(dup)->path(nullptr, nullptr, &pts2, nullptr) == Result::Success);
+    REQUIRE(pts1 == pts2);
+
+    //The attributes are read from the source
+    auto linear = LinearGradient::gen();
+    float dash[] = {2.0f, 3.0f};
+    REQUIRE(source->strokeWidth(4.0f) == Result::Success);
+    REQUIRE(source->strokeFill(0, 0, 255, 100) == Result::Success);
+    REQUIRE(source->strokeDash(dash, 2, 1.0f) == Result::Success);
+    REQUIRE(source->strokeCap(StrokeCap::Round) == Result::Success);
+    REQUIRE(source->strokeJoin(StrokeJoin::Bevel) == Result::Success);
+    REQUIRE(source->strokeMiterlimit(8.0f) == Result::Success);
+    REQUIRE(source->fillRule(FillRule::EvenOdd) == Result::Success);
+
+    uint8_t r, g, b, a;
+    REQUIRE(instance->fill(&r, &g, &b, &a) == Result::Success);
+    REQUIRE((r == 255 && g == 0 && b == 0 && a == 255));
+    REQUIRE(instance->strokeWidth() == 4.0f);
+    REQUIRE(instance->strokeFill(&r, &g, &b, &a) == Result::Success);
+    REQUIRE((r == 0 && g == 0 && b == 255 && a == 100));
+    const float* dash2;
+    float offset;
+    REQUIRE(instance->strokeDash(&dash2, &offset) == 2);
+    REQUIRE((dash2[0] == 2.0f && dash2[1] == 3.0f && offset == 1.0f));
+    REQUIRE(instance->strokeCap() == StrokeCap::Round);
+    REQUIRE(instance->strokeJoin() == StrokeJoin::Bevel);
+    REQUIRE(instance->strokeMiterlimit() == 8.0f);
+    REQUIRE(instance->fillRule() == FillRule::EvenOdd);
+    REQUIRE(instance->fill() == nullptr);
+
+    REQUIRE(source->fill(linear) == Result::Success);
+    REQUIRE(instance->fill() == linear);
+
+    //The instance color overrides the source one
+    REQUIRE(instance->fill(0, 255, 0, 50) == Result::Success);
+    REQUIRE(instance->fill(&r, &g, &b, &a) == Result::Success);
+    REQUIRE((r == 0 && g == 255 && b == 0 && a == 50));
+    REQUIRE(instance->strokeWidth() == 4.0f);
+    REQUIRE(instance->fillRule() == FillRule::EvenOdd);
+
+    //The source outlives its instances
+    Paint::rel(source);
+    REQUIRE(instance->path(nullptr, nullptr, &pts2, &cnt2) == Result::Success);
+    REQUIRE(pts1 == pts2);
+
+    //Detached
+    REQUIRE(instance->reset() == Result::Success);
+    REQUIRE(instance->path(nullptr, nullptr, nullptr, &cnt2) == Result::Success);
+    REQUIRE(cnt2 == 0);
+
+    Paint::rel(dup);
+    Paint::rel(instance2);
+    Paint::rel(instance);
+}
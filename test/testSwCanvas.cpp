@@ -245,6 +245,75 @@ TEST_CASE("Viewport", "[tvgSwCanvas]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Frame Statistics", "[tvgSwCanvas]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100] = {};
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        auto shape1 = Shape::gen();
+        REQUIRE(shape1->appendCircle(25, 25, 15, 15) == Result::Success);
+        REQUIRE(shape1->fill(255, 0, 0) == Result::Success);
+
+        auto shape2 = Shape::gen();
+        REQUIRE(shape2->appendCircle(70, 70, 20, 20) == Result::Success);
+        REQUIRE(shape2->fill(0, 0, 255) == Result::Success);
+
+        //Masked to get a compositor
+        auto mask = Shape::gen();
+        REQUIRE(mask->appendCircle(70, 70, 15, 15) == Result::Success);
+        REQUIRE(mask->fill(0, 0, 0) == Result::Success);
+        REQUIRE(shape2->mask(mask, MaskMethod::Alpha) == Result::Success);
+
+        REQUIRE(canvas->add(shape1) == Result::Success);
+        REQUIRE(canvas->add(shape2) == Result::Success);
+
+        FrameStats stats;
+
+#ifdef THORVG_STATS_SUPPORT
+        REQUIRE(canvas->stats(nullptr) == Result::InvalidArguments);
+
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->stats(&stats) == Result::InsufficientCondition);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->stats(&stats) == Result::Success);
+        REQUIRE(stats.update >= 0.0f);
+        REQUIRE(stats.render >= stats.composite);
+        REQUIRE(stats.tessellated == 3);
+        REQUIRE(stats.reused == 0);
+        REQUIRE(stats.spans > 0);
+        REQUIRE(stats.tasks == 3);
+        REQUIRE(stats.compositors > 0);
+        REQUIRE(stats.area == 100 * 100);
+        REQUIRE(stats.retries == 0);
+
+        //Moved by a whole pixel, no more tessellation
+        REQUIRE(shape1->translate(1, 1) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw() == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(canvas->stats(&stats) == Result::Success);
+        REQUIRE(stats.tessellated == 0);
+        REQUIRE(stats.reused == 1);
+        REQUIRE(stats.spans == 0);
+        REQUIRE(stats.tasks == 1);
+        REQUIRE(stats.compositors == 0);
+        REQUIRE(stats.area > 0);
+        REQUIRE(stats.area <= 100 * 100);
+#else
+        REQUIRE(canvas->stats(&stats) == Result::NonSupport);
+#endif
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 TEST_CASE("Multi-Threading", "[tvgSwCanvas]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -22,6 +22,8 @@
 
 #include <thorvg.h>
 #include <fstream>
+#include <cstring>
+#include <vector>
 #include "config.h"
 #include "catch.hpp"
 
@@ -335,6 +337,46 @@ TEST_CASE("Filling Draw", "[tvgSwEngine]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Fill Rule Update", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto path = [](FillRule rule) {
+            auto shape = Shape::gen();
+            shape->appendRect(10, 10, 60, 60);
+            shape->appendRect(30, 30, 60, 60);
+            shape->fill(255, 255, 255);
+            shape->fillRule(rule);
+            return shape;
+        };
+
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        uint32_t expected[100*100], result[100*100];
+
+        REQUIRE(canvas->target(expected, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        REQUIRE(canvas->add(path(FillRule::EvenOdd)) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(expected[50 * 100 + 50] == 0);
+
+        //the fill rule changes the coverage of the drawn shape
+        canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(result, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        auto shape = path(FillRule::NonZero);
+        REQUIRE(canvas->add(shape) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(result[50 * 100 + 50] == 0xffffffff);
+
+        REQUIRE(shape->fillRule(FillRule::EvenOdd) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+        REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 TEST_CASE("Image Rotation", "[tvgSwEngine]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -370,6 +412,466 @@ TEST_CASE("Image Rotation", "[tvgSwEngine]")
     REQUIRE(Initializer::term() == Result::Success);
 }
 
+TEST_CASE("Image Minification", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100] = {};
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //1px black & white checker board in an odd size
+        const uint32_t size = 999;
+        vector<uint32_t> checker(size * size);
+        for (uint32_t y = 0; y < size; ++y) {
+            for (uint32_t x = 0; x < size; ++x) checker[y * size + x] = ((x + y) & 1) ? 0xffffffff : 0xff000000;
+        }
+
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(checker.data(), size, size, ColorSpace::ARGB8888, false) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+
+        //sampled from the averaged levels, at the multiple zoom levels
+        for (auto scale : {0.07f, 0.3f}) {
+            REQUIRE(picture->scale(scale) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto grey = true;
+            for (uint32_t y = 2; y < 66; ++y) {
+                for (uint32_t x = 2; x < 66; ++x) {
+                    auto c = buffer[y * 100 + x];
+                    auto g = int(c & 0xff);
+                    if ((c >> 24) != 0xff || g < 124 || g > 131) grey = false;
+                }
+            }
+            REQUIRE(grey);
+        }
+
+        //the pixels updated in the same buffer while the picture is invisible
+        for (auto& c : checker) c = 0xffff0000;
+        REQUIRE(picture->opacity(0) == Result::Success);
+        REQUIRE(picture->load(checker.data(), size, size, ColorSpace::ARGB8888, false) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(picture->opacity(255) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto red = true;
+        for (uint32_t y = 2; y < 66; ++y) {
+            for (uint32_t x = 2; x < 66; ++x) {
+                if (buffer[y * 100 + x] != 0xffff0000) red = false;
+            }
+        }
+        REQUIRE(red);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Shared Image Minification", "[tvgSwEngine]")
+{
+    //1px black & white checker board, its first level is 500 x 500
+    const uint32_t size = 999;
+    vector<uint32_t> checker(size * size);
+    for (uint32_t y = 0; y < size; ++y) {
+        for (uint32_t x = 0; x < size; ++x) checker[y * size + x] = ((x + y) & 1) ? 0xffffffff : 0xff000000;
+    }
+
+    struct Levels
+    {
+        size_t size = sizeof(uint32_t) * 500 * 500;
+        void* block = nullptr;
+        uint32_t built = 0;
+        bool released = false;
+    } levels;
+
+    Allocator allocator = {
+        [](size_t size, void* user) -> void* {
+            auto p = malloc(size);
+            auto levels = static_cast<Levels*>(user);
+            if (size == levels->size) {
+                levels->block = p;
+                ++levels->built;
+            }
+            return p;
+        },
+        [](size_t nmem, size_t size, void* user) -> void* { return calloc(nmem, size); },
+        [](void* ptr, size_t size, void* user) -> void* { return realloc(ptr, size); },
+        [](void* ptr, void* user) {
+            if (ptr && ptr == static_cast<Levels*>(user)->block) static_cast<Levels*>(user)->released = true;
+            free(ptr);
+        },
+        &levels
+    };
+
+    REQUIRE(Initializer::init(4, &allocator) == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        static uint32_t buffer[640*80];
+        REQUIRE(canvas->target(buffer, 640, 640, 80, ColorSpace::ARGB8888) == Result::Success);
+
+        //the pictures of the same pixels (a cached loader and the duplicates) build the levels once
+        auto picture = Picture::gen();
+        REQUIRE(picture->load(checker.data(), size, size, ColorSpace::ARGB8888, false) == Result::Success);
+        REQUIRE(picture->scale(0.07f) == Result::Success);
+        REQUIRE(canvas->add(picture) == Result::Success);
+        for (int i = 1; i < 8; ++i) {
+            auto shared = (i < 4) ? Picture::gen() : static_cast<Picture*>(picture->duplicate());
+            if (i < 4) REQUIRE(shared->load(checker.data(), size, size, ColorSpace::ARGB8888, false) == Result::Success);
+            REQUIRE(shared->scale(0.07f) == Result::Success);
+            REQUIRE(shared->translate(float(i * 80), 0.0f) == Result::Success);
+            REQUIRE(canvas->add(shared) == Result::Success);
+        }
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(levels.built == 1);
+
+        auto grey = true;
+        for (uint32_t y = 2; y < 66; ++y) {
+            for (uint32_t x = 0; x < 640; ++x) {
+                if (x % 80 < 2 || x % 80 >= 66) continue;
+                auto c = buffer[y * 640 + x];
+                auto g = int(c & 0xff);
+                if ((c >> 24) != 0xff || g < 124 || g > 131) grey = false;
+            }
+        }
+        REQUIRE(grey);
+    }
+    //the levels are released with the pixels
+    REQUIRE(levels.released);
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Region Composition", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas);
+
+        uint32_t buffer[100*100];
+        REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+        //a translucent scene nested in a masked one, the mask exceeds the canvas
+        auto inner = Scene::gen();
+        auto shape = Shape::gen();
+        REQUIRE(shape->appendRect(0, 0, 40, 40) == Result::Success);
+        REQUIRE(shape->fill(255, 0, 0) == Result::Success);
+        REQUIRE(inner->add(shape) == Result::Success);
+        REQUIRE(inner->opacity(128) == Result::Success);
+
+        auto mask = Shape::gen();
+        REQUIRE(mask->appendRect(-50, -50, 70, 200) == Result::Success);
+        REQUIRE(mask->fill(255, 255, 255) == Result::Success);
+
+        auto outer = Scene::gen();
+        REQUIRE(outer->add(inner) == Result::Success);
+        REQUIRE(outer->mask(mask, MaskMethod::Alpha) == Result::Success);
+        REQUIRE(canvas->add(outer) == Result::Success);
+
+        //the compositors are recycled while the regions move and resize
+        struct {int offset; float scale;} frames[] = {{10, 1.0f}, {30, 1.5f}, {0, 0.5f}};
+        for (auto& frame : frames) {
+            auto offset = frame.offset;
+            REQUIRE(inner->translate(offset, offset) == Result::Success);
+            REQUIRE(inner->scale(frame.scale) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            auto max = offset + int(40 * frame.scale);
+            auto matched = true;
+            for (int y = 0; y < 100; ++y) {
+                for (int x = 0; x < 100; ++x) {
+                    auto a = buffer[y * 100 + x] >> 24;
+                    auto inside = (x >= offset && x < max && x < 20 && y >= offset && y < max);
+                    if (inside ? (a < 127 || a > 129) : (a != 0)) matched = false;
+                }
+            }
+            REQUIRE(matched);
+        }
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Region Composition with Gradients", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto gradient = [](float x, float y, float w, float h) {
+            auto fill = LinearGradient::gen();
+            REQUIRE(fill->linear(x, y, x + w, y + h) == Result::Success);
+            Fill::ColorStop colorStops[3] = {{0.0f, 255, 0, 0, 255}, {0.5f, 0, 255, 0, 128}, {1.0f, 0, 0, 255, 255}};
+            REQUIRE(fill->colorStops(colorStops, 3) == Result::Success);
+            auto shape = Shape::gen();
+            REQUIRE(shape->appendRect(x, y, w, h) == Result::Success);
+            REQUIRE(shape->fill(fill) == Result::Success);
+            return shape;
+        };
+
+        auto rect = [](float x, float y, float w, float h, uint8_t a) {
+            auto shape = Shape::gen();
+            REQUIRE(shape->appendRect(x, y, w, h) == Result::Success);
+            REQUIRE(shape->fill(255, 255, 255, a) == Result::Success);
+            return shape;
+        };
+
+        //a matted gradient rect and the masked/direct gradient rect masks, placed at the offset
+        auto draw = [&](uint32_t* buffer, uint32_t size, float offset) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, size, size, size, ColorSpace::ARGB8888) == Result::Success);
+
+            auto matted = gradient(offset, offset, 100, 30);
+            REQUIRE(matted->mask(rect(offset + 10, offset, 80, 30, 200), MaskMethod::Alpha) == Result::Success);
+            REQUIRE(canvas->add(matted) == Result::Success);
+
+            auto masked = rect(offset, offset + 30, 100, 35, 255);
+            REQUIRE(masked->fill(0, 0, 255) == Result::Success);
+            auto mask = rect(offset, offset + 30, 50, 35, 255);
+            REQUIRE(mask->mask(gradient(offset + 25, offset + 30, 75, 35), MaskMethod::Add) == Result::Success);
+            REQUIRE(masked->mask(mask, MaskMethod::Alpha) == Result::Success);
+            REQUIRE(canvas->add(masked) == Result::Success);
+
+            auto direct = rect(offset, offset + 65, 100, 35, 255);
+            REQUIRE(direct->fill(0, 255, 0) == Result::Success);
+            mask = rect(offset, offset + 65, 100, 35, 255);
+            REQUIRE(mask->mask(gradient(offset + 25, offset + 65, 50, 35), MaskMethod::Subtract) == Result::Success);
+            REQUIRE(direct->mask(mask, MaskMethod::Alpha) == Result::Success);
+            REQUIRE(canvas->add(direct) == Result::Success);
+
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //the compositors span the whole canvas
+        auto expected = unique_ptr<uint32_t[]>(new uint32_t[100 * 100]);
+        draw(expected.get(), 100, 0);
+
+        //the compositors are narrower than the canvas
+        auto buffer = unique_ptr<uint32_t[]>(new uint32_t[200 * 200]);
+        draw(buffer.get(), 200, 50);
+
+        auto matched = true;
+        for (int y = 0; y < 100; ++y) {
+            if (memcmp(expected.get() + y * 100, buffer.get() + (y + 50) * 200 + 50, 100 * sizeof(uint32_t))) matched = false;
+        }
+        REQUIRE(matched);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Instance Draw", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        auto draw = [](Paint* paint, uint32_t* buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->add(paint) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        auto source = Shape::gen();
+        REQUIRE(source->appendCircle(20, 20, 15, 10) == Result::Success);
+        REQUIRE(source->fill(255, 0, 0) == Result::Success);
+        REQUIRE(source->strokeWidth(3) == Result::Success);
+        REQUIRE(source->strokeFill(0, 0, 255) == Result::Success);
+        source->ref();
+
+        uint32_t expected[100*100], result[100*100];
+
+        //Same as the duplicate
+        auto dup = source->duplicate();
+        REQUIRE(dup->translate(30.5f, 40.0f) == Result::Success);
+        draw(dup, expected);
+
+        auto instance = source->instance();
+        REQUIRE(instance->translate(30.5f, 40.0f) == Result::Success);
+        draw(instance, result);
+        REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+
+        //Color override
+        dup = source->duplicate();
+        REQUIRE(static_cast<Shape*>(dup)->fill(0, 255, 0) == Result::Success);
+        draw(dup, expected);
+
+        instance = source->instance();
+        REQUIRE(instance->fill(0, 255, 0) == Result::Success);
+        draw(instance, result);
+        REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+
+        //Follow the changes of the source
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        REQUIRE(canvas->target(result, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+        instance = source->instance();
+        REQUIRE(canvas->add(instance) == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        REQUIRE(source->appendRect(50, 50, 30, 30) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        draw(source->duplicate(), expected);
+        REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+
+        //Moved by whole pixels
+        for (auto offset : {1.0f, 7.0f, -5.0f, 0.0f}) {
+            REQUIRE(instance->translate(offset, -offset) == Result::Success);
+            REQUIRE(canvas->update() == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+
+            dup = source->duplicate();
+            REQUIRE(dup->translate(offset, -offset) == Result::Success);
+            draw(dup, expected);
+            REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+        }
+
+        //Instances side by side in a frame
+        auto row = [&](bool instancing, uint32_t* buffer) {
+            auto scene = Scene::gen();
+            for (auto i = 0; i < 3; ++i) {
+                auto paint = instancing ? source->instance() : static_cast<Shape*>(source->duplicate());
+                REQUIRE(paint->scale(0.5f) == Result::Success);
+                REQUIRE(paint->translate(float(i * 25), 10.0f) == Result::Success);
+                scene->add(paint);
+            }
+            draw(scene, buffer);
+        };
+        row(false, expected);
+        row(true, result);
+        REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+
+        source->unref();
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
+TEST_CASE("Nested Task Wait", "[tvgSwEngine]")
+{
+    //The clipped shapes wait for their clippers which might be still queued behind the busy workers,
+    //the waiting thread runs them then with its own tid. The instances wait for their origin task inside
+    //their own tasks, the origin may run on the waiting thread then and must not share its mpool with the waiting one.
+    auto draw = [](uint32_t threads, uint32_t* buffer) {
+        REQUIRE(Initializer::init(threads) == Result::Success);
+        {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+
+            for (auto i = 0; i < 16; ++i) {
+                auto shape = Shape::gen();
+                REQUIRE(shape->appendRect(float((i % 4) * 25), float((i / 4) * 25), 20, 20, 4, 4) == Result::Success);
+                REQUIRE(shape->fill(0, 255, 0) == Result::Success);
+                REQUIRE(shape->strokeWidth(2) == Result::Success);
+                REQUIRE(shape->strokeFill(255, 255, 0) == Result::Success);
+
+                auto clipper = Shape::gen();
+                REQUIRE(clipper->appendCircle(float((i % 4) * 25 + 10), float((i / 4) * 25 + 10), 9, 7) == Result::Success);
+                REQUIRE(shape->clip(clipper) == Result::Success);
+                REQUIRE(canvas->add(shape) == Result::Success);
+            }
+
+            auto source = Shape::gen();
+            REQUIRE(source->appendCircle(10, 10, 8, 6) == Result::Success);
+            REQUIRE(source->fill(255, 0, 0) == Result::Success);
+            REQUIRE(source->strokeWidth(2) == Result::Success);
+            REQUIRE(source->strokeFill(0, 0, 255) == Result::Success);
+            REQUIRE(canvas->add(source) == Result::Success);
+
+            for (auto i = 1; i < 16; ++i) {
+                auto instance = source->instance();
+                REQUIRE(instance->translate(float((i % 4) * 25), float((i / 4) * 25)) == Result::Success);
+                REQUIRE(canvas->add(instance) == Result::Success);
+            }
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        }
+        REQUIRE(Initializer::term() == Result::Success);
+    };
+
+    uint32_t expected[100*100], result[100*100];
+    draw(0, expected);
+    draw(1, result);
+    REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+    draw(4, result);
+    REQUIRE(memcmp(expected, result, sizeof(expected)) == 0);
+}
+
+TEST_CASE("Band Rasterization", "[tvgSwEngine]")
+{
+    REQUIRE(Initializer::init() == Result::Success);
+    {
+        //the thin teeth crowd the top rows, too many cells for the pool in the band sized by the average
+        auto teeth = [](Shape* shape, int32_t from, int32_t to) {
+            for (auto i = from; i < to; ++i) {
+                shape->moveTo(i * 6.0f, 0.0f);
+                shape->lineTo(i * 6.0f + 2.0f, 200.0f);
+                shape->lineTo(i * 6.0f + 4.0f, 0.0f);
+                shape->close();
+            }
+        };
+
+        //a thin line down to the bottom
+        auto line = [](Shape* shape) {
+            shape->moveTo(500.0f, 300.0f);
+            shape->lineTo(502.5f, 1000.0f);
+            shape->lineTo(505.0f, 1000.0f);
+            shape->lineTo(502.5f, 300.0f);
+            shape->close();
+        };
+
+        auto draw = [](SwCanvas* canvas, uint32_t* buffer) {
+            REQUIRE(canvas->target(buffer, 1000, 1000, 1000, ColorSpace::ARGB8888) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        vector<uint32_t> expected(1000 * 1000), result(1000 * 1000);
+
+        //the teeth one by one
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        for (auto i = 0; i < 166; ++i) {
+            auto shape = Shape::gen();
+            teeth(shape, i, i + 1);
+            shape->fill(255, 255, 255);
+            REQUIRE(canvas->add(shape) == Result::Success);
+        }
+        auto shape = Shape::gen();
+        line(shape);
+        shape->fill(255, 255, 255);
+        REQUIRE(canvas->add(shape) == Result::Success);
+        draw(canvas.get(), expected.data());
+
+        //all in a shape, rasterized in the split bands
+        canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        shape = Shape::gen();
+        teeth(shape, 0, 166);
+        line(shape);
+        shape->fill(255, 255, 255);
+        REQUIRE(canvas->add(shape) == Result::Success);
+        draw(canvas.get(), result.data());
+
+#ifdef THORVG_STATS_SUPPORT
+        FrameStats stats;
+        REQUIRE(canvas->stats(&stats) == Result::Success);
+        REQUIRE(stats.retries > 0);
+#endif
+        REQUIRE(result == expected);
+    }
+    REQUIRE(Initializer::term() == Result::Success);
+}
+
 TEST_CASE("Intersection", "[tvgSwEngine]")
 {
     REQUIRE(Initializer::init() == Result::Success);
@@ -308,6 +308,99 @@ TEST_CASE("Text Spacing", "[tvgText]")
     Initializer::term();
 }
 
+TEST_CASE("Text Glyph Cache", "[tvgText]")
+{
+    Initializer::init();
+    {
+        auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+        uint32_t buffer[100*100] = {};
+        canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888);
+
+        REQUIRE(Text::load(TEST_DIR"/PublicSans-Regular.ttf") == Result::Success);
+
+        //identical glyphs at the same and the different subpixel positions
+        auto text = Text::gen();
+        REQUIRE(text->font("PublicSans-Regular") == Result::Success);
+        REQUIRE(text->size(12) == Result::Success);
+        REQUIRE(text->text("aaaa aaaa\nAVAV ffff") == Result::Success);
+        REQUIRE(text->fill(255, 255, 255) == Result::Success);
+        REQUIRE(text->translate(0.3f, 10.7f) == Result::Success);
+        REQUIRE(canvas->add(text) == Result::Success);
+
+        //rotated glyphs aren't cached
+        auto text2 = Text::gen();
+        REQUIRE(text2->font("PublicSans-Regular") == Result::Success);
+        REQUIRE(text2->size(12) == Result::Success);
+        REQUIRE(text2->text("aaaa") == Result::Success);
+        REQUIRE(text2->fill(255, 255, 255) == Result::Success);
+        REQUIRE(text2->rotate(30) == Result::Success);
+        REQUIRE(canvas->add(text2) == Result::Success);
+
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        auto covered = 0;
+        for (auto i = 0; i < 100 * 50; ++i) {
+            if (buffer[i]) ++covered;
+        }
+        REQUIRE(covered > 0);
+
+        //partially clipped by the canvas, reuse the cached glyphs
+        REQUIRE(text->translate(-20.5f, 95.25f) == Result::Success);
+        REQUIRE(canvas->update() == Result::Success);
+        REQUIRE(canvas->draw(true) == Result::Success);
+        REQUIRE(canvas->sync() == Result::Success);
+
+        //the glyph advance and the baseline on the pixel grid, the cached glyphs are placed without the subpixel rounding
+        GlyphMetrics glyph;
+        TextMetrics metrics;
+        REQUIRE(text->metrics("a", glyph) == Result::Success);
+        auto size = 12.0f * 7.0f / glyph.advance;
+        REQUIRE(text->size(size) == Result::Success);
+        REQUIRE(text->metrics(metrics) == Result::Success);
+        auto baseline = ceilf(metrics.ascent) - metrics.ascent;
+
+        auto render = [&](float x, float y, float skew, uint32_t* buffer) {
+            auto canvas = unique_ptr<SwCanvas>(SwCanvas::gen());
+            REQUIRE(canvas->target(buffer, 100, 100, 100, ColorSpace::ARGB8888) == Result::Success);
+            auto text = Text::gen();
+            REQUIRE(text->font("PublicSans-Regular") == Result::Success);
+            REQUIRE(text->size(size) == Result::Success);
+            REQUIRE(text->text("aaaaaaaa") == Result::Success);
+            REQUIRE(text->fill(255, 255, 255) == Result::Success);
+            REQUIRE(text->transform({1.0f, skew, x, 0.0f, 1.0f, y + baseline, 0.0f, 0.0f, 1.0f}) == Result::Success);
+            REQUIRE(canvas->add(text) == Result::Success);
+            REQUIRE(canvas->draw(true) == Result::Success);
+            REQUIRE(canvas->sync() == Result::Success);
+        };
+
+        //the skewed texts are rasterized from the outlines, the skew moves their edges slightly either way.
+        //at the subpixel positions of the cache, the cached coverage stays in between.
+        static uint32_t cached[100*100], origin[100*100], left[100*100], right[100*100];
+        render(1.0f, 1.0f, 0.0f, origin);
+
+        float shifts[][2] = {{0.0f, 0.0f}, {0.25f, 0.5f}, {0.5f, 0.75f}, {0.75f, 0.25f}, {3.0f, 20.0f}};
+        for (auto& shift : shifts) {
+            render(1.0f + shift[0], 1.0f + shift[1], 0.0f, cached);
+            render(1.0f + shift[0], 1.0f + shift[1], 5.0e-4f, left);
+            render(1.0f + shift[0], 1.0f + shift[1], -5.0e-4f, right);
+
+            auto matched = true;
+            for (auto i = 0; i < 100 * 100; ++i) {
+                auto c = int32_t(cached[i] & 0xff);
+                auto l = int32_t(left[i] & 0xff);
+                auto r = int32_t(right[i] & 0xff);
+                if (c < std::min(l, r) - 1 || c > std::max(l, r) + 1) matched = false;
+            }
+            REQUIRE(matched);
+        }
+
+        //the integer shift moves the cached coverage as it is
+        REQUIRE(memcmp(cached + 20 * 100 + 3, origin, sizeof(uint32_t) * (100 * 80 - 3)) == 0);
+    }
+    Initializer::term();
+}
+
 #endif
 
 #ifdef THORVG_OTF_LOADER_SUPPORT